@@ -0,0 +1,32 @@
+#!/usr/bin/env bash
+
+# Runs the Verilator lint/elaboration (verilator_lint.sh) and the ISA
+# regression (regression.py, default suites) for every configuration
+# of configs.txt, or only for the given ones. Logs and results are
+# written to .ci/results (<config>.lint.log, <config>.json).
+#
+# usage: .ci/config_regression.sh [<config> ...]
+
+cd $(dirname "$0")
+
+mkdir -p results
+status=0
+
+while read -u 3 -r name defines; do
+  case "$name" in ''|\#*) continue ;; esac
+  if [ $# -gt 0 ] && [[ " $* " != *" $name "* ]]; then
+    continue
+  fi
+
+  echo "=== $name: ${defines:-default options}"
+  if ! ./verilator_lint.sh $defines > results/$name.lint.log 2>&1; then
+    echo "LINT FAILED, see .ci/results/$name.lint.log"
+    status=1
+    continue
+  fi
+  if ! SIM_DEFINES="$defines" python3 regression.py --json results/$name.json; then
+    status=1
+  fi
+done 3< configs.txt
+
+exit $status
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+# --- All rights reserved ---
+# SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+# Licensed under the Solderpad Hardware License v 2.1 (the "License");
+# you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+# You may obtain a copy of the License at
+# https://solderpad.org/licenses/SHL-2.1/
+# Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and limitations under the License.
+#
+#
+# File          : gen_tohost.py
+# Abstract      : Writes tb/memfiles/tohost.lst, the tohost address of every
+#                 test image in tb/memfiles (see select_tohost in
+#                 tb/test_tasks.vh). The address is taken from the "tohost"
+#                 symbol of <name>.elf in --elf-dir if there is one, otherwise
+#                 from the write_tohost loop of the riscv-tests "p"
+#                 environment in the image (auipc t5 / sw gp, tohost(t5)).
+#                 Images without either are not listed, the testbench then
+#                 uses the tb_tohost default of the test file.
+#                 Run again after adding or rebuilding .mem images.
+#
+#                 usage: python3 gen_tohost.py [--elf-dir <dir>] [-o <file>]
+#
+
+import argparse
+import glob
+import os
+import struct
+import sys
+
+CI_DIR  = os.path.dirname(os.path.abspath(__file__))
+TB_DIR  = os.path.join(CI_DIR, '..', 'tb')
+MEM_DIR = os.path.join(TB_DIR, 'memfiles')
+
+RAM_BASE = 0x80000000
+
+
+def elf_tohost(name):
+    """Value of the "tohost" symbol of a RV32 ELF file or None."""
+    with open(name, 'rb') as f:
+        buf = f.read()
+    if buf[:4] != b'\x7fELF' or buf[4] != 1 or buf[5] != 1:
+        return None
+    e_shoff, = struct.unpack_from('<I', buf, 0x20)
+    e_shentsize, e_shnum = struct.unpack_from('<HH', buf, 0x2e)
+    for i in range(e_shnum):
+        sh = struct.unpack_from('<10I', buf, e_shoff + i * e_shentsize)
+        if sh[1] != 2:  # SHT_SYMTAB
+            continue
+        strtab = struct.unpack_from('<10I', buf, e_shoff + sh[6] * e_shentsize)[4]
+        for j in range(sh[5] // 16):
+            st_name, st_value = struct.unpack_from('<II', buf, sh[4] + j * 16)
+            end = buf.index(b'\0', strtab + st_name)
+            if buf[strtab + st_name:end] == b'tohost':
+                return st_value
+    return None
+
+
+def sext(value, bits):
+    return value - (1 << bits) if value & (1 << (bits - 1)) else value
+
+
+def mem_tohost(name):
+    """tohost address of the riscv-tests write_tohost loop in a .mem image or None."""
+    with open(name) as f:
+        words = [int(l.split()[0], 16) for l in f if l.strip() and not l.startswith('@')]
+    for i in range(len(words) - 1):
+        auipc, sw = words[i], words[i + 1]
+        if ((auipc & 0xfff) == 0xf17 and                  # auipc t5, hi
+                (sw & 0x000ff07f) == 0x000f2023 and       # sw rs2, lo(t5)
+                ((sw >> 20) & 0x1f) == 3):                # rs2 = gp (test number)
+            lo = sext(((sw >> 25) << 5) | ((sw >> 7) & 0x1f), 12)
+            return (RAM_BASE + 4 * i + (auipc & 0xfffff000) + lo) & 0xffffffff
+    return None
+
+
+def main():
+    parser = argparse.ArgumentParser(description='tohost addresses of the test images')
+    parser.add_argument('--elf-dir', help='directory with the ELF files of the images (searched recursively)')
+    parser.add_argument('-o', '--output', default=os.path.join(MEM_DIR, 'tohost.lst'))
+    args = parser.parse_args()
+
+    elfs = {}
+    if args.elf_dir:
+        for e in glob.glob(os.path.join(args.elf_dir, '**', '*'), recursive=True):
+            base, ext = os.path.splitext(os.path.basename(e))
+            if os.path.isfile(e) and ext in ('', '.elf'):
+                elfs[base] = e
+
+    lines   = []
+    missing = []
+    for mem in sorted(glob.glob(os.path.join(MEM_DIR, '**', '*.mem'), recursive=True)):
+        base   = os.path.splitext(os.path.basename(mem))[0]
+        tohost = elf_tohost(elfs[base]) if base in elfs else None
+        if tohost is None:
+            tohost = mem_tohost(mem)
+        # same path as in the test files (relative to tb/)
+        name = './' + os.path.relpath(mem, TB_DIR).replace(os.sep, '/')
+        if tohost is None:
+            missing.append(name)
+        else:
+            lines.append('%s %08x\n' % (name, tohost))
+
+    with open(args.output, 'w') as f:
+        f.write('# tohost address per test image, generated by .ci/gen_tohost.py\n')
+        f.writelines(lines)
+    print('%s: %d images' % (args.output, len(lines)))
+    for name in missing:
+        print('  no tohost: %s' % name)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
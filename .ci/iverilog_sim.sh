@@ -9,12 +9,15 @@ TOP_DIR=${TOP_DIR:-../.}
 cd "$TOP_DIR"/tb
 
 # remove VHDL includes (they are not relevant for
-# this minimal iverilog simulation)
-patch -b "$TOP_DIR"/src/modules/airi5c_trng/src/airi5c_trng.v "$TOP_DIR"/.ci/airi5c_trng.v.patch
+# this minimal iverilog simulation), unless already done
+patch -b -N -r - "$TOP_DIR"/src/modules/airi5c_trng/src/airi5c_trng.v "$TOP_DIR"/.ci/airi5c_trng.v.patch || true
 
+# SIM_DEFINES: additional defines, e.g. overrides of airi5c_arch_options.vh
+# (SIM_DEFINES="-DBRANCH_PREDICTION=2", see config_regression.sh)
 iverilog -v \
   -DCONFIG_IDEAL_SRAM_1 \
   -DSIM \
+  $SIM_DEFINES \
   -I "$TOP_DIR"/tb \
   -I "$TOP_DIR"/tb/tests \
   -I "$TOP_DIR"/src \
@@ -23,4 +26,10 @@ iverilog -v \
   -o "$TOP_DIR"/.ci/airi5c-sim \
   -c "$TOP_DIR"/.ci/sim_file_list.txt
 
-vvp "$TOP_DIR"/.ci/airi5c-sim
+# SIM_BUILD_ONLY=1: only compile (used by regression.py)
+if [ "$SIM_BUILD_ONLY" = "1" ]; then
+  exit 0
+fi
+
+# plusargs are passed on, e.g. +jtag_load
+vvp "$TOP_DIR"/.ci/airi5c-sim "$@"
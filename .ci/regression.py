@@ -0,0 +1,222 @@
+#!/usr/bin/env python3
+#
+# Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+# --- All rights reserved ---
+# SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+# Licensed under the Solderpad Hardware License v 2.1 (the "License");
+# you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+# You may obtain a copy of the License at
+# https://solderpad.org/licenses/SHL-2.1/
+# Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and limitations under the License.
+#
+#
+# File          : regression.py
+# Abstract      : Parallel ISA regression. Builds the iverilog simulation
+#                 once (iverilog_sim.sh, SIM_BUILD_ONLY=1) and runs every
+#                 test program of the selected suites (tb/tests/<suite>_tests.vh)
+#                 in its own vvp process (single test mode of airi5c_top_tb.v,
+#                 +test=<memfile>). Results and cycle counts are written
+#                 as JSON and/or JUnit XML, the exit code is 1 if a test
+#                 failed.
+#                 The "benchmark" suite (not a default suite) builds the
+#                 tb/sw images ("make tb_mem" in tb/sw, needs the RISC-V
+#                 toolchain) and runs each program with +units=<n>; the
+#                 phase results are part of the JSON output. Images that
+#                 do not exist (e.g. coremark) are reported as skipped.
+#
+#                 usage: python3 regression.py [-j <jobs>] [--suites base_isa,m_ext,...]
+#                          [--json <file>] [--junit <file>] [--no-build] [--list]
+#                          [-- <plusargs>]
+#
+
+import argparse
+import concurrent.futures
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+import xml.etree.ElementTree as ET
+
+CI_DIR = os.path.dirname(os.path.abspath(__file__))
+TB_DIR = os.path.join(CI_DIR, '..', 'tb')
+SIM    = os.path.join(CI_DIR, 'airi5c-sim')
+
+# suites of the default configuration (ISA_EXT_M/F/C, airi5c_arch_options.vh)
+DEFAULT_SUITES = 'base_isa,m_ext,c_ext,f_ext'
+
+# watchdog (cycles) of the test tasks, see test_tasks.vh
+TASK_TIMEOUT = {
+    'run_test_program':           50000,
+    'run_test_program_long':      40000000,
+    'run_test_program_bulk':      40000,
+    'run_test_program_bulk_long': 2000000,
+    'run_bench_program':          40000000,
+}
+
+RE_RUN    = re.compile(r'(run_test_program\w*)\(\s*\d+\s*,\s*"([^"]+)"\s*,\s*(\d+)\s*,')
+RE_BENCH  = re.compile(r'(run_bench_program)\(\s*\d+\s*,\s*"([^"]+)"\s*,\s*(\d+)\s*,\s*(\d+)\s*,')
+# result lines of run_bench_program (test_tasks.vh)
+RE_STATS  = re.compile(r'^  (phase|total|fetch|branches|icache|dcache).*$', re.M)
+
+
+def read_tohost_list():
+    """tohost address per image (tb/memfiles/tohost.lst, see gen_tohost.py)."""
+    tohost = {}
+    with open(os.path.join(TB_DIR, 'memfiles', 'tohost.lst')) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) == 2 and not fields[0].startswith('#'):
+                tohost[fields[0]] = int(fields[1], 16)
+    return tohost
+
+
+def parse_suite(suite):
+    """Test programs of tb/tests/<suite>_tests.vh in order of appearance."""
+    with open(os.path.join(TB_DIR, 'tests', suite + '_tests.vh')) as f:
+        src = re.sub(r'/\*.*?\*/', '', f.read(), flags=re.S)
+    lines = [re.sub(r'//.*', '', l) for l in src.splitlines()]
+    tests  = []
+    tohost = read_tohost_list()
+    for i, line in enumerate(lines):
+        m = RE_RUN.search(line) or RE_BENCH.search(line)
+        if m and m.group(1) in TASK_TIMEOUT:
+            mem  = m.group(2)
+            name = os.path.splitext(os.path.basename(mem))[0]
+            if any(t['name'] == name for t in tests):
+                name += '_%d' % len(tests)
+            # TB self tests (nop.mem) expect the program to fail
+            rest = [l for l in lines[i + 1:i + 4] if l.strip()]
+            tests.append({
+                'suite':       suite,
+                'name':        name,
+                'mem':         mem,
+                'length':      int(m.group(3)),
+                'tohost':      tohost.get(mem),
+                'timeout':     TASK_TIMEOUT[m.group(1)],
+                'expect_fail': bool(rest) and bool(re.search(r'result\s*==\s*0', rest[0])),
+                'units':       int(m.group(4)) if m.lastindex >= 4 else None,
+            })
+    return tests
+
+
+def run_test(test, plusargs):
+    if test['units'] is not None and not os.path.exists(os.path.join(TB_DIR, test['mem'])):
+        return dict(test, status='skipped', cycles=None, time=0.0, stats=[],
+                    log='%s not built' % test['mem'])
+    args = [
+        'vvp', '-n', SIM,
+        '+test=%s' % test['mem'],
+        '+length=%d' % test['length'],
+        '+timeout=%d' % test['timeout'],
+    ]
+    if test['expect_fail']:
+        args.append('+expect_fail')
+    if test['units'] is not None:
+        args.append('+units=%d' % test['units'])
+        # the tb/sw programs report through DEBUG_OUT only (benchmark_tests.vh)
+        if test['mem'].startswith('./memfiles/bench/'):
+            args.append('+tohost=0')
+    args += plusargs
+    start = time.time()
+    proc = subprocess.run(args, cwd=TB_DIR, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                          universal_newlines=True)
+    out = proc.stdout
+    m = re.search(r'TB RESULT (\d+) CYCLES (\d+)', out)
+    if 'TB PASSED' in out:
+        status = 'passed'
+    elif m:
+        status = 'failed'
+    else:
+        status = 'error'  # simulator did not reach the end of the test
+    return dict(test, status=status, cycles=int(m.group(2)) if m else None,
+                time=round(time.time() - start, 3), log=out,
+                stats=[s.group(0).strip() for s in RE_STATS.finditer(out)])
+
+
+def write_junit(results, name):
+    suites = ET.Element('testsuites')
+    for suite in sorted(set(r['suite'] for r in results)):
+        rs = [r for r in results if r['suite'] == suite]
+        ts = ET.SubElement(suites, 'testsuite', name=suite, tests=str(len(rs)),
+                           failures=str(sum(r['status'] == 'failed' for r in rs)),
+                           errors=str(sum(r['status'] == 'error' for r in rs)),
+                           time='%.3f' % sum(r['time'] for r in rs))
+        for r in rs:
+            tc = ET.SubElement(ts, 'testcase', classname=suite, name=r['name'], time='%.3f' % r['time'])
+            if r['cycles'] is not None:
+                ET.SubElement(ET.SubElement(tc, 'properties'), 'property', name='cycles', value=str(r['cycles']))
+            if r['status'] == 'skipped':
+                ET.SubElement(tc, 'skipped', message=r['log'])
+            elif r['status'] != 'passed':
+                ET.SubElement(tc, 'failure' if r['status'] == 'failed' else 'error',
+                              message=r['status']).text = r['log']
+    ET.ElementTree(suites).write(name, encoding='utf-8', xml_declaration=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Parallel AIRISC ISA regression (iverilog)')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(), help='parallel simulations')
+    parser.add_argument('--suites', default=DEFAULT_SUITES, help='tb/tests/<suite>_tests.vh, comma separated')
+    parser.add_argument('--json', help='write results as JSON')
+    parser.add_argument('--junit', help='write results as JUnit XML')
+    parser.add_argument('--no-build', action='store_true', help='use the existing .ci/airi5c-sim')
+    parser.add_argument('--list', action='store_true', help='only list the tests')
+    parser.add_argument('plusargs', nargs='*', help='passed on to every simulation (e.g. +jtag_load)')
+    args = parser.parse_args()
+
+    if not args.no_build and not args.list:
+        env = dict(os.environ, SIM_BUILD_ONLY='1')
+        subprocess.run(['bash', os.path.join(CI_DIR, 'iverilog_sim.sh')], env=env, check=True)
+
+    suites = [s.strip() for s in args.suites.split(',')]
+    if 'benchmark' in suites and not args.no_build and not args.list:
+        subprocess.run(['make', '-C', os.path.join(TB_DIR, 'sw'), 'tb_mem'], check=True)
+
+    tests = []
+    for suite in suites:
+        tests += parse_suite(suite)
+    for i, t in enumerate(tests):
+        t['index'] = i
+
+    if args.list:
+        for t in tests:
+            print('%s/%s: %s, %d words, tohost %s%s' % (t['suite'], t['name'], t['mem'], t['length'],
+                                                      '0x%08x' % t['tohost'] if t['tohost'] is not None else 'default',
+                                                      ', expect fail' if t['expect_fail'] else ''))
+        return 0
+
+    start   = time.time()
+    results = []
+    with concurrent.futures.ThreadPoolExecutor(max_workers=max(1, args.jobs)) as pool:
+        futures = [pool.submit(run_test, t, args.plusargs) for t in tests]
+        for fut in concurrent.futures.as_completed(futures):
+            r = fut.result()
+            results.append(r)
+            print('%-7s %-40s %s' % (r['status'].upper(), r['suite'] + '/' + r['name'],
+                                     '%d cycles' % r['cycles'] if r['cycles'] is not None else ''))
+            for s in r['stats']:
+                print('        %s' % s)
+            sys.stdout.flush()
+    results.sort(key=lambda r: r['index'])
+
+    failed  = [r for r in results if r['status'] not in ('passed', 'skipped')]
+    skipped = [r for r in results if r['status'] == 'skipped']
+    print('\n%d tests, %d failed, %d skipped, %.1f s' % (len(results), len(failed), len(skipped),
+                                                        time.time() - start))
+
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump({'tests': len(results), 'failed': len(failed), 'skipped': len(skipped),
+                       'results': [{k: v for k, v in r.items() if k != 'log'} for r in results]}, f, indent=2)
+    if args.junit:
+        write_junit(results, args.junit)
+
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
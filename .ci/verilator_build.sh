@@ -0,0 +1,42 @@
+#!/usr/bin/env bash
+
+# Builds the Verilator simulator (tb/airi5c_top_tb_verilator.v/.cpp)
+# into .ci/airi5c-verilator. Additional arguments are passed on to
+# verilator, e.g. --trace for +trace-start/+trace-end or defines of
+# airi5c_arch_options.vh (-DDUAL_ISSUE=1).
+#
+# usage: .ci/airi5c-verilator [+elf=]<file.elf> [+max-cycles=<n>]
+#          [+trace=<file>] [+trace-start=<n>] [+trace-end=<n>]
+
+set -e
+
+cd $(dirname "$0")
+
+TOP_DIR=${TOP_DIR:-../.}
+
+cd "$TOP_DIR"/tb
+
+# remove VHDL includes (see iverilog_sim.sh), unless already done
+patch -b -N -r - "$TOP_DIR"/src/modules/airi5c_trng/src/airi5c_trng.v "$TOP_DIR"/.ci/airi5c_trng.v.patch || true
+
+# same sources as the iverilog simulation, but the Verilator top
+grep -v 'airi5c_top_tb\.v' "$TOP_DIR"/.ci/sim_file_list.txt > "$TOP_DIR"/.ci/verilator_file_list.txt
+
+verilator --cc --exe --build -j 0 \
+  -O3 --x-assign fast --x-initial fast --noassert \
+  -Wno-fatal -Wno-lint -Wno-style \
+  -DCONFIG_IDEAL_SRAM_1 \
+  -DSIM \
+  -I"$TOP_DIR"/tb \
+  -I"$TOP_DIR"/tb/tests \
+  -I"$TOP_DIR"/src \
+  -I"$TOP_DIR"/src/modules/airi5c_uart/src \
+  -I"$TOP_DIR"/src/modules/airi5c_fpu \
+  --top-module airi5c_top_tb \
+  --Mdir "$TOP_DIR"/.ci/obj_verilator \
+  -o ../airi5c-verilator \
+  -f "$TOP_DIR"/.ci/verilator_file_list.txt \
+  "$TOP_DIR"/tb/modules/uart_monitor.v \
+  "$TOP_DIR"/tb/airi5c_top_tb_verilator.v \
+  "$TOP_DIR"/tb/airi5c_top_tb_verilator.cpp \
+  "$@"
@@ -0,0 +1,33 @@
+#!/usr/bin/env bash
+
+# Lints and elaborates the simulated SoC (airi5c_cfg_ideal_sram, same
+# sources as iverilog_sim.sh) with Verilator. Additional arguments are
+# passed on to verilator, e.g. defines of airi5c_arch_options.vh
+# (-DDCACHE_WAYS=1). Warnings are reported, errors fail the script.
+#
+# usage: .ci/verilator_lint.sh [<verilator args>]
+
+set -e
+
+cd $(dirname "$0")
+
+TOP_DIR=${TOP_DIR:-../.}
+
+cd "$TOP_DIR"/tb
+
+# remove VHDL includes (see iverilog_sim.sh), unless already done
+patch -b -N -r - "$TOP_DIR"/src/modules/airi5c_trng/src/airi5c_trng.v "$TOP_DIR"/.ci/airi5c_trng.v.patch || true
+
+# same sources as the iverilog simulation, without the testbench
+grep -v 'airi5c_top_tb\.v' "$TOP_DIR"/.ci/sim_file_list.txt > "$TOP_DIR"/.ci/verilator_lint_list.txt
+
+verilator --lint-only -Wall -Wno-fatal \
+  -DCONFIG_IDEAL_SRAM_1 \
+  -DSIM \
+  -I"$TOP_DIR"/tb \
+  -I"$TOP_DIR"/src \
+  -I"$TOP_DIR"/src/modules/airi5c_uart/src \
+  -I"$TOP_DIR"/src/modules/airi5c_fpu \
+  --top-module airi5c_cfg_ideal_sram \
+  -f "$TOP_DIR"/.ci/verilator_lint_list.txt \
+  "$@"
@@ -12,7 +12,7 @@
 #
 # File          : common.mk
 # Author        : S. Nolting
-# Last Modified : 08.03.2023
+# Last Modified : 16.10.2026
 # Abstract      : Central AIRISC application makefile.
 #
 
@@ -40,6 +40,12 @@ MABI  ?= ilp32
 # User flags for additional configuration (will be added to compiler flags)
 USER_FLAGS ?=
 
+# Replace newlib's memcpy/memset/memmove by the optimized BSP versions (1 = yes, 0 = no)
+AIRISC_FAST_STRING ?= 1
+
+# Place the trap entry and the default interrupt handler in the CCRAM (1 = yes, 0 = no)
+AIRISC_FAST_TRAP ?= 0
+
 # Relative or absolute path to the "AIRISC Base Core" home folder
 AIRISC_HOME ?= ../..
 
@@ -101,6 +107,12 @@ SIZE    = $(RISCV_PREFIX)size
 # GCC flags
 CC_OPTS = -march=$(MARCH) -mabi=$(MABI) $(EFFORT) -Wall -ffunction-sections -fdata-sections -nostartfiles -Wl,--gc-sections -lm -lc -lgcc -lc -g
 CC_OPTS += $(USER_FLAGS)
+ifeq ($(AIRISC_FAST_STRING),1)
+CC_OPTS += -DAIRISC_FAST_STRING
+endif
+ifeq ($(AIRISC_FAST_TRAP),1)
+CC_OPTS += -DAIRISC_FAST_TRAP
+endif
 
 
 # -----------------------------------------------------------------------------
@@ -245,6 +257,8 @@ info:
 	@$(CC) -print-search-dirs
 	@echo "---------------- Info: Flags ----------------"
 	@echo "USER_FLAGS: $(USER_FLAGS)"
+	@echo "AIRISC_FAST_STRING: $(AIRISC_FAST_STRING)"
+	@echo "AIRISC_FAST_TRAP: $(AIRISC_FAST_TRAP)"
 	@echo "CC_OPTS:    $(CC_OPTS)"
 
 
@@ -276,6 +290,8 @@ help:
 	@echo " APP_INC      - C include folder(s) [append only!]: \"$(APP_INC)\""
 	@echo " ASM_INC      - ASM include folder(s) [append only!]: \"$(ASM_INC)\""
 	@echo " RISCV_PREFIX - Toolchain prefix: \"$(RISCV_PREFIX)\""
+	@echo " AIRISC_FAST_STRING - Use BSP memcpy/memset/memmove (1) or newlib's (0): \"$(AIRISC_FAST_STRING)\""
+	@echo " AIRISC_FAST_TRAP - Trap entry and default interrupt handler in CCRAM (1) or RAM (0): \"$(AIRISC_FAST_TRAP)\""
 	@echo " AIRISC_HOME  - AIRISC home folder: \"$(AIRISC_HOME)\""
 	@echo ""
 
@@ -13,7 +13,7 @@
 //
 // File             : airisc.h
 // Author           : S. Nolting
-// Last Modified    : 18.01.2023
+// Last Modified    : 16.10.2026
 // Abstract         : Main AIRISC include file. Include only this file using '#include <airisc.h>'.
 //
 
@@ -31,9 +31,13 @@
 /**********************************************************************//**
  * Core headers
  **************************************************************************/
+#include "airisc_alloc.h"
 #include "airisc_csr.h"
 #include "airisc_defines.h"
+#include "airisc_dma.h"
+#include "airisc_irq.h"
 #include "airisc_spi.h"
+#include "airisc_string.h"
 #include "airisc_syscalls.h"
 #include "airisc_timer.h"
 #include "airisc_trng.h"
@@ -61,6 +65,18 @@
 #define DEBUG_OUT (*(MMREG32 0x80010000UL)) // write-only, simulation-only
 
 
+/**********************************************************************//**
+ * Placement in the closely-coupled RAM (CCRAM, see link.ld). Code and
+ * initialized data are copied from RAM by crt0, zero-initialized data
+ * is cleared by crt0.
+ *
+ * @note Fast functions are never inlined into callers in RAM.
+ **************************************************************************/
+#define AIRISC_FAST_CODE __attribute__((section(".ccram.text"), noinline))
+#define AIRISC_FAST_DATA __attribute__((section(".ccram.data")))
+#define AIRISC_FAST_BSS  __attribute__((section(".ccram.bss")))
+
+
 /**********************************************************************//**
  * Prototypes
  **************************************************************************/
@@ -0,0 +1,71 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : airisc_alloc.h
+// Author        : A. Stanitzki
+// Creation Date : 16.10.2026
+// Abstract      : Bounded heap (backing _sbrk/malloc), O(1) fixed-size
+//                 block pools and bump arenas for scratch buffers.
+//
+
+#ifndef AIRISC_ALLOC_H_
+#define AIRISC_ALLOC_H_
+
+#include <stdint.h>
+
+// minimum distance kept to the stack pointer, if the stack lives in the heap region
+#define AIRISC_STACK_GUARD 256
+
+// alignment of arena allocations
+#define AIRISC_ARENA_ALIGN 8
+
+typedef struct
+{
+  uint32_t size;           // size of the heap region
+  uint32_t used;           // bytes currently handed out by _sbrk
+  uint32_t peak;           // high-water mark of used
+  uint32_t failures;       // rejected requests
+} airisc_heap_stats_t;
+
+typedef struct
+{
+  void*    free_list;      // first free block
+  uint8_t* base;           // first block
+  uint32_t block_size;     // block size in bytes (multiple of 4)
+  uint32_t num_blocks;     // number of blocks
+  uint32_t used;           // blocks in use
+  uint32_t peak;           // high-water mark of used
+  uint32_t failures;       // failed allocations
+} airisc_pool_t;
+
+typedef struct
+{
+  uint8_t* base;           // arena memory
+  uint32_t size;           // arena size in bytes
+  uint32_t offset;         // next free byte
+  uint32_t peak;           // high-water mark of offset
+  uint32_t failures;       // failed allocations
+} airisc_arena_t;
+
+void* airisc_heap_grow(int incr);
+void  airisc_heap_get_stats(airisc_heap_stats_t* stats);
+
+int   airisc_pool_create(airisc_pool_t* pool, void* mem, uint32_t block_size, uint32_t num_blocks);
+void* airisc_pool_alloc(airisc_pool_t* pool);
+int   airisc_pool_free(airisc_pool_t* pool, void* block);
+
+int   airisc_arena_create(airisc_arena_t* arena, void* mem, uint32_t size);
+void* airisc_arena_alloc(airisc_arena_t* arena, uint32_t size);
+void  airisc_arena_reset(airisc_arena_t* arena);
+
+#endif
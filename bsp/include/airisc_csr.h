@@ -101,9 +101,21 @@ enum airisc_csr_enum {
   CSR_MINSTRET       = 0xb02, /**< 0xb02 - minstret  (r/w): Machine instructions-retired counter low word */
   CSR_MCYCLEH        = 0xb80, /**< 0xb80 - mcycleh   (r/w): Machine cycle counter high word */
   CSR_MINSTRETH      = 0xb82, /**< 0xb82 - minstreth (r/w): Machine instructions-retired counter high word */
+  CSR_MHPMCOUNTER3   = 0xb03, /**< 0xb03 - mhpmcounter3  (r/w): Machine performance-monitoring counter 3 low word */
+  CSR_MHPMCOUNTER4   = 0xb04, /**< 0xb04 - mhpmcounter4  (r/w): Machine performance-monitoring counter 4 low word */
+  CSR_MHPMCOUNTER5   = 0xb05, /**< 0xb05 - mhpmcounter5  (r/w): Machine performance-monitoring counter 5 low word */
+  CSR_MHPMCOUNTER6   = 0xb06, /**< 0xb06 - mhpmcounter6  (r/w): Machine performance-monitoring counter 6 low word */
+  CSR_MHPMCOUNTER3H  = 0xb83, /**< 0xb83 - mhpmcounter3h (r/w): Machine performance-monitoring counter 3 high word */
+  CSR_MHPMCOUNTER4H  = 0xb84, /**< 0xb84 - mhpmcounter4h (r/w): Machine performance-monitoring counter 4 high word */
+  CSR_MHPMCOUNTER5H  = 0xb85, /**< 0xb85 - mhpmcounter5h (r/w): Machine performance-monitoring counter 5 high word */
+  CSR_MHPMCOUNTER6H  = 0xb86, /**< 0xb86 - mhpmcounter6h (r/w): Machine performance-monitoring counter 6 high word */
 
   /* machine counter setup */
   CSR_MCOUNTINHIBIT  = 0x320, /**< 0x320 - mcountinhibit (r/w): Machine counter-inhibit register */
+  CSR_MHPMEVENT3     = 0x323, /**< 0x323 - mhpmevent3    (r/w): Machine performance-monitoring event selector 3 (see #airisc_hpm_event_enum) */
+  CSR_MHPMEVENT4     = 0x324, /**< 0x324 - mhpmevent4    (r/w): Machine performance-monitoring event selector 4 (see #airisc_hpm_event_enum) */
+  CSR_MHPMEVENT5     = 0x325, /**< 0x325 - mhpmevent5    (r/w): Machine performance-monitoring event selector 5 (see #airisc_hpm_event_enum) */
+  CSR_MHPMEVENT6     = 0x326, /**< 0x326 - mhpmevent6    (r/w): Machine performance-monitoring event selector 6 (see #airisc_hpm_event_enum) */
 
   /* user counterd and timers */
   CSR_CYCLE          = 0xc00, /**< 0xc00 - cycle    (r/-): Cycle counter low word (from MCYCLE) */
@@ -112,6 +124,14 @@ enum airisc_csr_enum {
   CSR_CYCLEH         = 0xc80, /**< 0xc80 - cycleh   (r/-): Cycle counter high word (from MCYCLEH) */
   CSR_TIMEH          = 0xc81, /**< 0xc81 - timeh    (r/-): Timer high word (from MTIME.TIME_HI) */
   CSR_INSTRETH       = 0xc82, /**< 0xc82 - instreth (r/-): Instructions-retired counter high word (from MINSTRETH) */
+  CSR_HPMCOUNTER3    = 0xc03, /**< 0xc03 - hpmcounter3   (r/-): Performance-monitoring counter 3 low word (from MHPMCOUNTER3) */
+  CSR_HPMCOUNTER4    = 0xc04, /**< 0xc04 - hpmcounter4   (r/-): Performance-monitoring counter 4 low word (from MHPMCOUNTER4) */
+  CSR_HPMCOUNTER5    = 0xc05, /**< 0xc05 - hpmcounter5   (r/-): Performance-monitoring counter 5 low word (from MHPMCOUNTER5) */
+  CSR_HPMCOUNTER6    = 0xc06, /**< 0xc06 - hpmcounter6   (r/-): Performance-monitoring counter 6 low word (from MHPMCOUNTER6) */
+  CSR_HPMCOUNTER3H   = 0xc83, /**< 0xc83 - hpmcounter3h  (r/-): Performance-monitoring counter 3 high word (from MHPMCOUNTER3H) */
+  CSR_HPMCOUNTER4H   = 0xc84, /**< 0xc84 - hpmcounter4h  (r/-): Performance-monitoring counter 4 high word (from MHPMCOUNTER4H) */
+  CSR_HPMCOUNTER5H   = 0xc85, /**< 0xc85 - hpmcounter5h  (r/-): Performance-monitoring counter 5 high word (from MHPMCOUNTER5H) */
+  CSR_HPMCOUNTER6H   = 0xc86, /**< 0xc86 - hpmcounter6h  (r/-): Performance-monitoring counter 6 high word (from MHPMCOUNTER6H) */
 
 
   /* machine information registers */
@@ -207,4 +227,23 @@ enum CSR_MSTATUS_enum {
 };
 
 
+/**********************************************************************//**
+ * Performance-monitoring events (mhpmevent values), the number of
+ * implemented counters is set by HPM_COUNTERS (airi5c_arch_options.vh)
+ **************************************************************************/
+enum airisc_hpm_event_enum {
+  HPM_EVENT_NONE        =  0, /**< Counter does not count */
+  HPM_EVENT_LOAD_USE    =  1, /**< Cycles stalled by a load-use hazard */
+  HPM_EVENT_PCPI        =  2, /**< Cycles stalled waiting for a PCPI coprocessor (MUL/DIV, ...) */
+  HPM_EVENT_FPU         =  3, /**< Cycles stalled waiting for the FPU */
+  HPM_EVENT_MISPREDICT  =  4, /**< Mispredicted branches and jumps */
+  HPM_EVENT_FETCH       =  5, /**< Fetch bubbles (no instruction available for decode) */
+  HPM_EVENT_DMEM_WAIT   =  6, /**< Cycles stalled waiting for the data memory bus */
+  HPM_EVENT_IRQ         =  7, /**< Interrupts taken */
+  HPM_EVENT_C_RETIRED   =  8, /**< Compressed instructions retired */
+  HPM_EVENT_ICACHE_MISS =  9, /**< Instruction cache misses */
+  HPM_EVENT_DCACHE_MISS = 10  /**< Data cache misses */
+};
+
+
 #endif
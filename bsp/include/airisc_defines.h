@@ -61,8 +61,25 @@ typedef struct
 typedef struct
 {
   uint32_t CTRL;           // control and data register
+  uint32_t DATA;           // data register (word mode)
+  uint32_t STAT;           // status register (read-only, does not read the FIFO)
 } TRNG_t __attribute__((aligned(4)));
 
+typedef struct
+{
+  uint32_t SRC;            // source address
+  uint32_t DST;            // destination address
+  uint32_t LEN;            // remaining number of items
+  uint32_t CTRL;           // channel control register
+  uint32_t STAT;           // channel status register
+  uint32_t reserved[3];
+} DMA_CH_t __attribute__((aligned(4)));
+
+typedef struct
+{
+  DMA_CH_t CH[2];          // DMA channels
+} DMA_t __attribute__((aligned(4)));
+
 
 /**********************************************************************//**
  * Peripheral map (DEFAULT configuration, see src/airi5c_arch_options.vh)
@@ -74,6 +91,15 @@ typedef struct
 #define spi1    (((volatile SPI_t*)   (0xC0000500)))
 #define gpio0   (((volatile GPIO_t*)  (0xC0000600)))
 #define trng    (((volatile TRNG_t*)  (0xC0000800)))
+#define dma0    (((volatile DMA_t*)   (0xC0000900)))
+
+
+/**********************************************************************//**
+ * Peripheral interrupt map (XIRQ channel, see src/airi5c_arch_options.vh)
+ **************************************************************************/
+#define UART0_XIRQ 15
+#define DMA0_XIRQ  14
+#define TRNG0_XIRQ 13
 
 #endif
 
@@ -0,0 +1,65 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : airisc_dma.h
+// Author        : A. Stanitzki
+// Creation Date : 16.10.2026
+// Abstract      : HAL for the DMA controller.
+//
+
+#ifndef AIRISC_DMA_H_
+#define AIRISC_DMA_H_
+
+#include "airisc_defines.h"
+
+#define DMA_CHANNELS        2
+
+// CTRL register
+#define DMA_CTRL_EN         (1 << 0)  // start transfer / transfer in progress
+#define DMA_CTRL_IE         (1 << 1)  // completion interrupt enable
+#define DMA_CTRL_SIZE_POS   2         // item size, see DMA_SIZE_*
+#define DMA_CTRL_SRC_INC    (1 << 4)  // increment source address
+#define DMA_CTRL_DST_INC    (1 << 5)  // increment destination address
+#define DMA_CTRL_HS_EN      (1 << 6)  // wait for peripheral request before each item
+#define DMA_CTRL_HS_SEL_POS 8         // peripheral request line, see DMA_REQ_*
+
+// STAT register
+#define DMA_STAT_DONE       (1 << 0)  // transfer finished (write 1 to clear)
+#define DMA_STAT_ERROR      (1 << 1)  // transfer aborted by bus error (write 1 to clear)
+#define DMA_STAT_BUSY       (1 << 2)  // transfer in progress
+
+// item size
+#define DMA_SIZE_BYTE       0
+#define DMA_SIZE_HALF       1
+#define DMA_SIZE_WORD       2
+
+// peripheral request lines (DEFAULT configuration, see tb/configs/airi5c_top_asic.v)
+#define DMA_REQ_UART0_TX    0         // uart0 tx FIFO not full
+#define DMA_REQ_UART0_RX    1         // uart0 rx FIFO not empty
+#define DMA_REQ_SPI0_TX     2         // spi0 tx FIFO not full
+#define DMA_REQ_SPI0_RX     3         // spi0 rx FIFO not empty
+
+typedef void (*dma_callback_t)(int ch, int error);
+
+int      dma_start(volatile DMA_t* const handle, int ch, const volatile void* src, volatile void* dst, uint32_t len, uint32_t ctrl);
+int      dma_memcpy(volatile DMA_t* const handle, int ch, void* dst, const void* src, uint32_t size);
+int      dma_to_periph(volatile DMA_t* const handle, int ch, volatile uint32_t* periph, const uint8_t* src, uint32_t size, int req);
+int      dma_from_periph(volatile DMA_t* const handle, int ch, uint8_t* dst, volatile uint32_t* periph, uint32_t size, int req);
+int      dma_busy(volatile DMA_t* const handle, int ch);
+int      dma_wait(volatile DMA_t* const handle, int ch);
+void     dma_abort(volatile DMA_t* const handle, int ch);
+uint32_t dma_get_remaining(volatile DMA_t* const handle, int ch);
+void     dma_set_callback(int ch, dma_callback_t callback);
+void     dma_irq_handler(volatile DMA_t* const handle);
+
+#endif
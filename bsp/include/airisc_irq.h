@@ -0,0 +1,39 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : airisc_irq.h
+// Author        : A. Stanitzki
+// Creation Date : 16.10.2026
+// Abstract      : Vectored interrupt mode (MTVEC.MODE = 1) with a
+//                 handler table for the timer, software and XIRQ
+//                 interrupts.
+//
+
+#ifndef AIRISC_IRQ_H_
+#define AIRISC_IRQ_H_
+
+#include <stdint.h>
+
+// number of vector table entries (one per mcause interrupt code)
+#define IRQ_VECTORS 32
+
+typedef void (*irq_handler_t)(void);
+
+int  irq_set_handler(uint32_t irq, irq_handler_t handler);
+int  irq_call_handler(uint32_t irq);
+void irq_enable(uint32_t irq);
+void irq_disable(uint32_t irq);
+void irq_vectored_enable(void);
+void irq_vectored_disable(void);
+
+#endif
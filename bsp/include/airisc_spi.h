@@ -37,6 +37,11 @@
 #define SPI_ENABLE_OUTPUTS  0x01
 #define SPI_DISABLE_OUTPUTS 0x00
 
+// tx/rx FIFO capacity (2^ADDR_WIDTH of airi5c_spi)
+#ifndef SPI_FIFO_DEPTH
+#define SPI_FIFO_DEPTH      8
+#endif
+
 // control reg
 void spi_init(volatile SPI_t* const spi, uint8_t master, uint8_t mode, uint8_t clkDiv, uint8_t activeSlave, uint8_t oe);
 void spi_enableOutputs(volatile SPI_t* const spi);
@@ -120,5 +125,12 @@ uint8_t spi_transferByte(volatile SPI_t* const spi, uint8_t data);
 void spi_writeData(volatile SPI_t* const spi, const uint8_t* data, uint32_t size);
 void spi_readData(volatile SPI_t* const spi, uint8_t* data, uint32_t size);
 
+/* full-duplex transfer of size bytes: tx data is pushed ahead of the received data up to SPI_FIFO_DEPTH bytes, so the
+ * bus does not idle between bytes. tx may be NULL (master: dummy bytes are sent, slave: the tx FIFO is not filled),
+ * rx may be NULL (received data is discarded). In slave mode, the function returns after size bytes were clocked in
+ * by the external master.
+ */
+void spi_transfer(volatile SPI_t* const spi, const uint8_t* tx, uint8_t* rx, uint32_t size);
+
 #endif
 
@@ -0,0 +1,31 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : airisc_string.h
+// Author        : A. Stanitzki
+// Creation Date : 16.10.2026
+// Abstract      : Optimized memory routines. If the BSP is built with
+//                 AIRISC_FAST_STRING (default, see common.mk), these
+//                 also replace memcpy/memset/memmove of newlib.
+//
+
+#ifndef AIRISC_STRING_H_
+#define AIRISC_STRING_H_
+
+#include <stddef.h>
+
+void* airisc_memcpy(void* restrict dst, const void* restrict src, size_t n);
+void* airisc_memset(void* dst, int c, size_t n);
+void* airisc_memmove(void* dst, const void* src, size_t n);
+
+#endif
@@ -22,10 +22,27 @@
 
 #include "airisc_defines.h"
 
+// CTRL register
+#define TRNG_CTRL_DATA_MASK   0xff      // random data byte (byte mode)
+#define TRNG_CTRL_LEVEL_POS   8         // FIFO fill level (entries), bits 15:8
+#define TRNG_CTRL_LEVEL_MASK  0xff
+#define TRNG_CTRL_WORD        (1 << 27) // word mode, 4 random bytes per DATA read
+#define TRNG_CTRL_IRQ_FULL    (1 << 28) // interrupt when the FIFO is full
+#define TRNG_CTRL_SIM         (1 << 29) // simulation mode (read-only)
+#define TRNG_CTRL_EN          (1 << 30) // TRNG enable
+#define TRNG_CTRL_VALID       (1 << 31) // FIFO not empty (read-only)
+
+// STAT register (FIFO level and valid bit as in CTRL)
+#define TRNG_STAT_FULL        (1 << 26) // FIFO full
+
 void    trng_enable(volatile TRNG_t* const handle);
 void    trng_disable(volatile TRNG_t* const handle);
 int     trng_is_enabled(volatile TRNG_t* const handle);
 int     trng_is_sim(volatile TRNG_t* const handle);
 uint8_t trng_get(volatile TRNG_t* const handle);
+int     trng_fill(volatile TRNG_t* const handle, uint8_t* buf, uint32_t len);
+void    trng_word_mode(volatile TRNG_t* const handle, int enable);
+void    trng_irq_full(volatile TRNG_t* const handle, int enable);
+int     trng_is_full(volatile TRNG_t* const handle);
 
 #endif
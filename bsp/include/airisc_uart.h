@@ -33,6 +33,25 @@
 #define UART_FLOW_CTRL_NONE	0x00
 #define UART_FLOW_CTRL_RTS_CTS 	0x01
 
+// tx/rx FIFO depth, has to match the hardware: 2^TX_ADDR_WIDTH and
+// 2^RX_ADDR_WIDTH (parameters of airi5c_uart, src/modules/airi5c_uart),
+// the reference SoC (tb/configs/airi5c_top_asic.v) instantiates uart0 with
+// TX_ADDR_WIDTH = RX_ADDR_WIDTH = 5. Other widths: -DUART_FIFO_DEPTH=<n>.
+// A larger value overflows the tx FIFO in uart_writeData.
+#ifndef UART_FIFO_DEPTH
+#define UART_FIFO_DEPTH		32
+#endif
+
+// software ring buffer size of the interrupt-driven mode (power of 2)
+#ifndef UART_RING_SIZE
+#define UART_RING_SIZE		256
+#endif
+
+// tx FIFO level at (or below) which the tx ring is moved into the FIFO
+#ifndef UART_IRQ_TX_WATERMARK
+#define UART_IRQ_TX_WATERMARK	8
+#endif
+
 // control reg
 void uart_init(volatile UART_t* const uart, uint8_t dataBits, uint8_t parity, uint8_t stopBits, uint8_t flowCtrl, uint32_t cyclesPerBit);
 void uart_setDataBits(volatile UART_t* const uart, uint8_t dataBits);
@@ -90,5 +109,16 @@ void uart_readData(volatile UART_t* const uart, uint8_t* data, uint32_t size);
 void uart_writeStr(volatile UART_t* const uart, const char* str);
 uint32_t uart_readStr(volatile UART_t* const uart, char* str, uint32_t size);
 
+// interrupt-driven mode (uart0 only, registers its handler for XIRQ
+// channel UART0_XIRQ with irq_set_handler)
+int32_t uart_enableIrqMode(volatile UART_t* const uart);
+void uart_disableIrqMode(volatile UART_t* const uart);
+int32_t uart_isIrqModeEnabled(volatile UART_t* const uart);
+void uart_irqHandler(volatile UART_t* const uart);
+
+// non-blocking write/read, return the number of bytes accepted/read
+uint32_t uart_write_nb(volatile UART_t* const uart, const uint8_t* data, uint32_t size);
+uint32_t uart_read_nb(volatile UART_t* const uart, uint8_t* data, uint32_t size);
+
 #endif
 
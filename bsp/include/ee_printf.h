@@ -18,6 +18,7 @@ limitations under the License.
 #define EE_PRINTF_H_
 
 int ee_printf(const char *fmt, ...);
+int ee_sprintf(char *buf, const char *fmt, ...);
 
 #endif
 
@@ -20,6 +20,14 @@
 #include "airisc.h"
 
 
+// place the trap entry and the default handlers in the CCRAM
+#ifdef AIRISC_FAST_TRAP
+#define TRAP_SECTION AIRISC_FAST_CODE
+#else
+#define TRAP_SECTION
+#endif
+
+
 /**********************************************************************//**
  * First level trap handler. Requires the 'interrupt' attribute to make
  * sure everything is saved to the stack and to enforce a 'mret' instruction
@@ -28,14 +36,16 @@
  * @note The crt0 start-up code will initialize MTVEC with the address
  * of this function.
  **************************************************************************/
-void __attribute__ ((__interrupt__, aligned(4))) __trap_entry(void)
+TRAP_SECTION void __attribute__ ((__interrupt__, aligned(4))) __trap_entry(void)
 {
 	uint32_t mcause = cpu_csr_read(CSR_MCAUSE);
 	uint32_t mepc   = cpu_csr_read(CSR_MEPC);
 	uint32_t mtval  = cpu_csr_read(CSR_MTVAL);
 
 	if (mcause & 0x80000000UL) { // is interrupt (async. exception)
-		interrupt_handler(mcause, mepc);
+		if (!irq_call_handler(mcause & 0x1F)) { // handler registered by irq_set_handler()?
+			interrupt_handler(mcause, mepc);
+		}
 	}
 	else { // is (sync.) exception
 		exception_handler(mcause, mepc, mtval);
@@ -48,11 +58,14 @@ void __attribute__ ((__interrupt__, aligned(4))) __trap_entry(void)
  * defining a custom function using the same prototype.
  *
  * @note This is a "normal" function - so NO 'interrupt' attribute!
+ * @note Only called for sources without a handler registered by
+ * irq_set_handler() (see airisc_irq.h), e.g. the interrupt-driven UART
+ * mode and the DMA completion interrupt register their own handlers.
  *
  * @param[in] cause Exception identifier from mcause CSR.
  * @param[in] epc Exception program counter from epc CSR.
  **************************************************************************/
-void __attribute__ ((weak)) interrupt_handler(uint32_t cause, uint32_t epc)
+TRAP_SECTION void __attribute__ ((weak)) interrupt_handler(uint32_t cause, uint32_t epc)
 {
   // try to clear all pending interrupts
   cpu_csr_write(CSR_MIP, 0);
@@ -0,0 +1,281 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : airisc_alloc.c
+// Author        : A. Stanitzki
+// Creation Date : 16.10.2026
+// Abstract      : Bounded heap (backing _sbrk/malloc), O(1) fixed-size
+//                 block pools and bump arenas for scratch buffers.
+//
+
+#include <airisc_alloc.h>
+#include <stdint.h>
+
+// heap region, see link.ld
+extern unsigned char _heap_start;
+extern unsigned char _heap_end;
+
+static unsigned char* heap_brk = 0;
+static uint32_t heap_peak = 0;
+static uint32_t heap_failures = 0;
+
+
+/**********************************************************************//**
+ * Get memory for a pool/arena from the heap.
+ *
+ * @param[in] size Number of bytes
+ * @param[in] align Alignment (power of 2)
+ * @return Aligned pointer or 0 if the heap is exhausted
+ **************************************************************************/
+static void* heap_take(uint32_t size, uint32_t align) {
+
+  unsigned char* mem;
+
+  if ((size == 0) || (size > (uint32_t)INT32_MAX - align)) {
+    return 0;
+  }
+
+  mem = (unsigned char*)airisc_heap_grow((int)(size + align - 1));
+  if (mem == (unsigned char*)-1) {
+    return 0;
+  }
+  return (void*)(((uintptr_t)mem + align - 1) & ~(uintptr_t)(align - 1));
+}
+
+
+/**********************************************************************//**
+ * Move the heap break (backend of _sbrk). The break never leaves the
+ * linker script heap region [_heap_start, _heap_end) and keeps
+ * AIRISC_STACK_GUARD bytes of distance to the stack pointer, if the
+ * stack is placed in the same region.
+ *
+ * @param[in] incr Number of bytes to add (may be negative)
+ * @return Previous break or (void*)-1 if the request does not fit
+ **************************************************************************/
+void* airisc_heap_grow(int incr) {
+
+  unsigned char* limit = &_heap_end;
+  unsigned char* prev;
+  unsigned char* sp;
+
+  if (heap_brk == 0) {
+    heap_brk = &_heap_start;
+  }
+
+  // stack inside the heap region: keep the guard distance below sp
+  // (sp at or below the break means the stack already ran into the heap)
+  asm volatile ("mv %0, sp" : "=r" (sp));
+  if ((sp >= &_heap_start) && (sp <= limit)) {
+    if ((uint32_t)(sp - &_heap_start) < AIRISC_STACK_GUARD) {
+      limit = &_heap_start;
+    }
+    else {
+      limit = sp - AIRISC_STACK_GUARD;
+    }
+  }
+
+  if (((incr > 0) && ((limit <= heap_brk) || (heap_brk + incr > limit))) ||
+      ((incr < 0) && ((uint32_t)(-incr) > (uint32_t)(heap_brk - &_heap_start)))) {
+    heap_failures++;
+    return (void*)-1;
+  }
+
+  prev = heap_brk;
+  heap_brk += incr;
+
+  if ((uint32_t)(heap_brk - &_heap_start) > heap_peak) {
+    heap_peak = (uint32_t)(heap_brk - &_heap_start);
+  }
+
+  return (void*)prev;
+}
+
+
+/**********************************************************************//**
+ * Get heap statistics.
+ *
+ * @param[out] stats Heap region size, current usage, high-water mark
+ * and number of failed requests
+ **************************************************************************/
+void airisc_heap_get_stats(airisc_heap_stats_t* stats) {
+
+  stats->size     = (uint32_t)(&_heap_end - &_heap_start);
+  stats->used     = heap_brk ? (uint32_t)(heap_brk - &_heap_start) : 0;
+  stats->peak     = heap_peak;
+  stats->failures = heap_failures;
+}
+
+
+/**********************************************************************//**
+ * Create a pool of fixed-size blocks.
+ *
+ * @param[out] pool Pool handle
+ * @param[in] mem Pool memory (block_size * num_blocks bytes, word aligned)
+ * or 0 to take the memory from the heap
+ * @param[in] block_size Block size in bytes (rounded up to a multiple of 4)
+ * @param[in] num_blocks Number of blocks
+ * @return 0 on success, -1 if the heap is exhausted or the arguments are invalid
+ **************************************************************************/
+int airisc_pool_create(airisc_pool_t* pool, void* mem, uint32_t block_size, uint32_t num_blocks) {
+
+  uint32_t i;
+
+  block_size = (block_size + 3) & ~3UL;
+  if ((block_size == 0) || (num_blocks == 0) || ((uintptr_t)mem & 3) ||
+      (num_blocks > UINT32_MAX / block_size)) {
+    return -1;
+  }
+
+  if (mem == 0) {
+    mem = heap_take(block_size * num_blocks, 4);
+    if (mem == 0) {
+      return -1;
+    }
+  }
+
+  pool->base       = (uint8_t*)mem;
+  pool->block_size = block_size;
+  pool->num_blocks = num_blocks;
+  pool->used       = 0;
+  pool->peak       = 0;
+  pool->failures   = 0;
+
+  // thread the free list through the blocks
+  for (i = 0; i < num_blocks - 1; i++) {
+    *(void**)(pool->base + i * block_size) = pool->base + (i + 1) * block_size;
+  }
+  *(void**)(pool->base + i * block_size) = 0;
+  pool->free_list = pool->base;
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Allocate a block from a pool, O(1).
+ *
+ * @param[in] pool Pool handle
+ * @return Block or 0 if the pool is empty
+ **************************************************************************/
+void* airisc_pool_alloc(airisc_pool_t* pool) {
+
+  void* block = pool->free_list;
+
+  if (block == 0) {
+    pool->failures++;
+    return 0;
+  }
+
+  pool->free_list = *(void**)block;
+  pool->used++;
+  if (pool->used > pool->peak) {
+    pool->peak = pool->used;
+  }
+  return block;
+}
+
+
+/**********************************************************************//**
+ * Return a block to its pool, O(1).
+ *
+ * @param[in] pool Pool handle
+ * @param[in] block Block from airisc_pool_alloc()
+ * @return 0 on success, -1 if the block does not belong to the pool
+ **************************************************************************/
+int airisc_pool_free(airisc_pool_t* pool, void* block) {
+
+  uint32_t offs = (uint32_t)((uint8_t*)block - pool->base);
+
+  if (((uint8_t*)block < pool->base) || (offs >= pool->block_size * pool->num_blocks) ||
+      (offs % pool->block_size) || (pool->used == 0)) {
+    return -1;
+  }
+
+  *(void**)block = pool->free_list;
+  pool->free_list = block;
+  pool->used--;
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Create an arena (bump allocator) for scratch buffers that are all
+ * released at once by airisc_arena_reset().
+ *
+ * @param[out] arena Arena handle
+ * @param[in] mem Arena memory or 0 to take the memory from the heap
+ * @param[in] size Arena size in bytes
+ * @return 0 on success, -1 if the heap is exhausted or the arguments are invalid
+ **************************************************************************/
+int airisc_arena_create(airisc_arena_t* arena, void* mem, uint32_t size) {
+
+  uint32_t skip;
+
+  if (mem == 0) {
+    mem = heap_take(size, AIRISC_ARENA_ALIGN);
+    if (mem == 0) {
+      return -1;
+    }
+  }
+
+  // align the base, all allocations are rounded to AIRISC_ARENA_ALIGN
+  skip = (uint32_t)(-(uintptr_t)mem & (AIRISC_ARENA_ALIGN - 1));
+  if ((size <= skip) || (size == 0)) {
+    return -1;
+  }
+
+  arena->base     = (uint8_t*)mem + skip;
+  arena->size     = (size - skip) & ~(uint32_t)(AIRISC_ARENA_ALIGN - 1);
+  arena->offset   = 0;
+  arena->peak     = 0;
+  arena->failures = 0;
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Allocate from an arena, O(1).
+ *
+ * @param[in] arena Arena handle
+ * @param[in] size Number of bytes
+ * @return AIRISC_ARENA_ALIGN aligned buffer or 0 if the arena is full
+ **************************************************************************/
+void* airisc_arena_alloc(airisc_arena_t* arena, uint32_t size) {
+
+  void* mem;
+
+  size = (size + AIRISC_ARENA_ALIGN - 1) & ~(uint32_t)(AIRISC_ARENA_ALIGN - 1);
+  if ((size == 0) || (size > arena->size - arena->offset)) {
+    arena->failures++;
+    return 0;
+  }
+
+  mem = arena->base + arena->offset;
+  arena->offset += size;
+  if (arena->offset > arena->peak) {
+    arena->peak = arena->offset;
+  }
+  return mem;
+}
+
+
+/**********************************************************************//**
+ * Release all allocations of an arena at once.
+ *
+ * @param[in] arena Arena handle
+ **************************************************************************/
+void airisc_arena_reset(airisc_arena_t* arena) {
+
+  arena->offset = 0;
+}
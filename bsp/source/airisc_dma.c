@@ -0,0 +1,271 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : airisc_dma.c
+// Author        : A. Stanitzki
+// Creation Date : 16.10.2026
+// Abstract      : HAL for the DMA controller.
+//
+
+#include <airisc_dma.h>
+#include <airisc_csr.h>
+#include <airisc_irq.h>
+#include <stdint.h>
+
+static dma_callback_t dma_callbacks[DMA_CHANNELS];
+
+
+/**********************************************************************//**
+ * XIRQ handler of dma0, registered by dma_start (DMA_CTRL_IE) and
+ * dma_set_callback.
+ **************************************************************************/
+static void dma0_irq(void) {
+
+  dma_irq_handler(dma0);
+}
+
+
+/**********************************************************************//**
+ * Start a transfer on a DMA channel.
+ *
+ * @param[in] handle Pointer to DMA hardware handle (DMA_t*)
+ * @param[in] ch Channel number (0..DMA_CHANNELS-1)
+ * @param[in] src Source address
+ * @param[in] dst Destination address
+ * @param[in] len Number of items to transfer (item size is set in ctrl)
+ * @param[in] ctrl Channel configuration (DMA_CTRL_* flags, DMA_CTRL_EN is added)
+ * @return 0 if the transfer was started, -1 if the channel is invalid or busy
+ **************************************************************************/
+int dma_start(volatile DMA_t* const handle, int ch, const volatile void* src, volatile void* dst, uint32_t len, uint32_t ctrl) {
+
+  if ((ch < 0) || (ch >= DMA_CHANNELS) || dma_busy(handle, ch)) {
+    return -1;
+  }
+
+  // make sure all buffer writes are issued before the DMA reads them
+  // (fence also writes back the data cache, DCACHE_WAYS)
+  asm volatile ("fence" : : : "memory");
+
+  // completion interrupt: service it through the handler table
+  if ((ctrl & DMA_CTRL_IE) && (handle == dma0)) {
+    irq_set_handler(IRQ_XIRQ0 + DMA0_XIRQ, dma0_irq);
+  }
+
+  handle->CH[ch].STAT = DMA_STAT_DONE | DMA_STAT_ERROR;
+  handle->CH[ch].SRC  = (uint32_t)src;
+  handle->CH[ch].DST  = (uint32_t)dst;
+  handle->CH[ch].LEN  = len;
+  handle->CH[ch].CTRL = ctrl | DMA_CTRL_EN;
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Start a memory to memory copy. The widest item size allowed by the
+ * alignment of both buffers and the size is used.
+ *
+ * @param[in] handle Pointer to DMA hardware handle (DMA_t*)
+ * @param[in] ch Channel number (0..DMA_CHANNELS-1)
+ * @param[in] dst Destination buffer
+ * @param[in] src Source buffer
+ * @param[in] size Number of bytes to copy
+ * @return 0 if the transfer was started, -1 if the channel is invalid or busy
+ **************************************************************************/
+int dma_memcpy(volatile DMA_t* const handle, int ch, void* dst, const void* src, uint32_t size) {
+
+  uint32_t align = (uint32_t)dst | (uint32_t)src | size;
+  uint32_t item;
+
+  if ((align & 3) == 0) {
+    item = DMA_SIZE_WORD;
+  }
+  else if ((align & 1) == 0) {
+    item = DMA_SIZE_HALF;
+  }
+  else {
+    item = DMA_SIZE_BYTE;
+  }
+
+  return dma_start(handle, ch, src, dst, size >> item,
+                   (item << DMA_CTRL_SIZE_POS) | DMA_CTRL_SRC_INC | DMA_CTRL_DST_INC);
+}
+
+
+/**********************************************************************//**
+ * Start a memory to peripheral transfer. Each byte is written to the
+ * peripheral data register as soon as its request line is asserted.
+ *
+ * @param[in] handle Pointer to DMA hardware handle (DMA_t*)
+ * @param[in] ch Channel number (0..DMA_CHANNELS-1)
+ * @param[in] periph Peripheral data register (e.g. &uart0->DATA)
+ * @param[in] src Source buffer
+ * @param[in] size Number of bytes to transfer
+ * @param[in] req Peripheral request line (DMA_REQ_*)
+ * @return 0 if the transfer was started, -1 if the channel is invalid or busy
+ **************************************************************************/
+int dma_to_periph(volatile DMA_t* const handle, int ch, volatile uint32_t* periph, const uint8_t* src, uint32_t size, int req) {
+
+  return dma_start(handle, ch, src, periph, size,
+                   (DMA_SIZE_BYTE << DMA_CTRL_SIZE_POS) | DMA_CTRL_SRC_INC |
+                   DMA_CTRL_HS_EN | ((uint32_t)req << DMA_CTRL_HS_SEL_POS));
+}
+
+
+/**********************************************************************//**
+ * Start a peripheral to memory transfer. Each byte is read from the
+ * peripheral data register as soon as its request line is asserted.
+ *
+ * @param[in] handle Pointer to DMA hardware handle (DMA_t*)
+ * @param[in] ch Channel number (0..DMA_CHANNELS-1)
+ * @param[in] dst Destination buffer
+ * @param[in] periph Peripheral data register (e.g. &uart0->DATA)
+ * @param[in] size Number of bytes to transfer
+ * @param[in] req Peripheral request line (DMA_REQ_*)
+ * @return 0 if the transfer was started, -1 if the channel is invalid or busy
+ **************************************************************************/
+int dma_from_periph(volatile DMA_t* const handle, int ch, uint8_t* dst, volatile uint32_t* periph, uint32_t size, int req) {
+
+  return dma_start(handle, ch, periph, dst, size,
+                   (DMA_SIZE_BYTE << DMA_CTRL_SIZE_POS) | DMA_CTRL_DST_INC |
+                   DMA_CTRL_HS_EN | ((uint32_t)req << DMA_CTRL_HS_SEL_POS));
+}
+
+
+/**********************************************************************//**
+ * Check if a DMA channel is busy.
+ *
+ * @param[in] handle Pointer to DMA hardware handle (DMA_t*)
+ * @param[in] ch Channel number (0..DMA_CHANNELS-1)
+ * @return 1 if a transfer is in progress, 0 otherwise
+ **************************************************************************/
+int dma_busy(volatile DMA_t* const handle, int ch) {
+
+  if (handle->CH[ch].STAT & DMA_STAT_BUSY) {
+    return 1;
+  }
+  else {
+    return 0;
+  }
+}
+
+
+/**********************************************************************//**
+ * Wait for the transfer of a DMA channel and clear its status.
+ *
+ * @warning This function is blocking (stalls until the transfer is finished).
+ *
+ * @param[in] handle Pointer to DMA hardware handle (DMA_t*)
+ * @param[in] ch Channel number (0..DMA_CHANNELS-1)
+ * @return 0 if the transfer finished, -1 if it was aborted by a bus error
+ **************************************************************************/
+int dma_wait(volatile DMA_t* const handle, int ch) {
+
+  uint32_t stat;
+
+  do {
+    stat = handle->CH[ch].STAT;
+  } while (stat & DMA_STAT_BUSY);
+
+  handle->CH[ch].STAT = stat & (DMA_STAT_DONE | DMA_STAT_ERROR);
+
+  // the DMA wrote to memory behind the compiler's back
+  // (fence.i also invalidates the data cache, DCACHE_WAYS;
+  // a plain fence only writes it back)
+  asm volatile ("fence.i" : : : "memory");
+
+  if (stat & DMA_STAT_ERROR) {
+    return -1;
+  }
+  else {
+    return 0;
+  }
+}
+
+
+/**********************************************************************//**
+ * Abort the transfer of a DMA channel. The item in flight is completed.
+ *
+ * @param[in] handle Pointer to DMA hardware handle (DMA_t*)
+ * @param[in] ch Channel number (0..DMA_CHANNELS-1)
+ **************************************************************************/
+void dma_abort(volatile DMA_t* const handle, int ch) {
+
+  handle->CH[ch].CTRL = handle->CH[ch].CTRL & ~DMA_CTRL_EN;
+}
+
+
+/**********************************************************************//**
+ * Get the number of items not yet transferred.
+ *
+ * @param[in] handle Pointer to DMA hardware handle (DMA_t*)
+ * @param[in] ch Channel number (0..DMA_CHANNELS-1)
+ * @return Remaining number of items
+ **************************************************************************/
+uint32_t dma_get_remaining(volatile DMA_t* const handle, int ch) {
+
+  return handle->CH[ch].LEN;
+}
+
+
+/**********************************************************************//**
+ * Install a completion callback for a DMA channel. The callback is
+ * executed by dma_irq_handler() in interrupt context, if the transfer
+ * was started with DMA_CTRL_IE. Registers dma_irq_handler() for the
+ * DMA0_XIRQ channel (irq_set_handler), the channel still has to be
+ * enabled in MIE.
+ *
+ * @param[in] ch Channel number (0..DMA_CHANNELS-1)
+ * @param[in] callback Function to call, 0 to remove
+ **************************************************************************/
+void dma_set_callback(int ch, dma_callback_t callback) {
+
+  if ((ch >= 0) && (ch < DMA_CHANNELS)) {
+    dma_callbacks[ch] = callback;
+    if (callback) {
+      irq_set_handler(IRQ_XIRQ0 + DMA0_XIRQ, dma0_irq);
+    }
+  }
+}
+
+
+/**********************************************************************//**
+ * DMA completion interrupt handler for the DMA0_XIRQ channel (registered
+ * automatically for dma0). Clears the status of all finished channels
+ * and runs their callbacks.
+ *
+ * @param[in] handle Pointer to DMA hardware handle (DMA_t*)
+ **************************************************************************/
+void dma_irq_handler(volatile DMA_t* const handle) {
+
+  uint32_t stat, pending;
+  int ch;
+
+  // XIRQs are edge-triggered: clear the pending bit first and service
+  // until no channel is left, so that the next completion raises a new edge
+  cpu_csr_clr(CSR_MIP, 1UL << (IRQ_XIRQ0 + DMA0_XIRQ));
+
+  do {
+    pending = 0;
+    for (ch = 0; ch < DMA_CHANNELS; ch++) {
+      stat = handle->CH[ch].STAT;
+      if ((stat & DMA_STAT_DONE) && (handle->CH[ch].CTRL & DMA_CTRL_IE)) {
+        handle->CH[ch].STAT = stat & (DMA_STAT_DONE | DMA_STAT_ERROR);
+        if (dma_callbacks[ch]) {
+          dma_callbacks[ch](ch, (stat & DMA_STAT_ERROR) ? 1 : 0);
+        }
+        pending = 1;
+      }
+    }
+  } while (pending);
+}
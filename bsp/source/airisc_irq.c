@@ -0,0 +1,286 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : airisc_irq.c
+// Author        : A. Stanitzki
+// Creation Date : 16.10.2026
+// Abstract      : Vectored interrupt mode (MTVEC.MODE = 1) with a
+//                 handler table for the timer, software and XIRQ
+//                 interrupts.
+//
+//                 In vectored mode the core jumps to table + 4*cause.
+//                 Each interrupt entry saves only the caller-saved
+//                 registers and calls the registered handler directly,
+//                 mcause/mepc/mtval are not read. Exceptions (entry 0)
+//                 still go to __trap_entry.
+//
+
+#include <airisc.h>
+
+// place the vector table, entry code and handler table in the CCRAM
+#ifdef AIRISC_FAST_TRAP
+#define IRQ_TEXT_SECTION ".ccram.text"
+#define IRQ_CODE AIRISC_FAST_CODE
+#define IRQ_DATA AIRISC_FAST_DATA
+#else
+#define IRQ_TEXT_SECTION ".text.airisc_irq"
+#define IRQ_CODE
+#define IRQ_DATA
+#endif
+
+// stack frame of the interrupt entry (16-byte aligned)
+#ifdef __riscv_flen
+#define IRQ_FRAME "144"
+#else
+#define IRQ_FRAME "64"
+#endif
+
+static void irq_default(void);
+
+// handler table, indexed by the mcause interrupt code
+IRQ_DATA irq_handler_t irq_table[IRQ_VECTORS] = {
+  irq_default, irq_default, irq_default, irq_default,
+  irq_default, irq_default, irq_default, irq_default,
+  irq_default, irq_default, irq_default, irq_default,
+  irq_default, irq_default, irq_default, irq_default,
+  irq_default, irq_default, irq_default, irq_default,
+  irq_default, irq_default, irq_default, irq_default,
+  irq_default, irq_default, irq_default, irq_default,
+  irq_default, irq_default, irq_default, irq_default
+};
+
+extern const uint32_t irq_vector_table[IRQ_VECTORS];
+
+
+/**********************************************************************//**
+ * Vector table and interrupt entry code.
+ *
+ * @note The table entries have to be 4 bytes, so RVC is disabled.
+ **************************************************************************/
+asm (
+  "  .pushsection " IRQ_TEXT_SECTION ", \"ax\", @progbits\n"
+  "  .option push\n"
+  "  .option norvc\n"
+  "  .balign 4\n"
+  "  .global irq_vector_table\n"
+  "irq_vector_table:\n"
+  "  j __trap_entry\n"                            // 0: exceptions
+  "  .irp n, 1,2\n"
+  "  j __trap_entry\n"
+  "  .endr\n"
+  "  j irq_entry_3\n"                             // 3: machine software
+  "  .irp n, 4,5,6\n"
+  "  j __trap_entry\n"
+  "  .endr\n"
+  "  j irq_entry_7\n"                             // 7: machine timer
+  "  .irp n, 8,9,10\n"
+  "  j __trap_entry\n"
+  "  .endr\n"
+  "  j irq_entry_11\n"                            // 11: machine external
+  "  .irp n, 12,13,14,15\n"
+  "  j __trap_entry\n"
+  "  .endr\n"
+  "  .irp n, 16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31\n"
+  "  j irq_entry_\\n\n"                           // 16..31: XIRQ0..15
+  "  .endr\n"
+  "  .option pop\n"
+
+  // per source: free a0 and load the interrupt code
+  "  .irp n, 3,7,11,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31\n"
+  "irq_entry_\\n:\n"
+  "  addi sp, sp, -" IRQ_FRAME "\n"
+  "  sw   a0, 0(sp)\n"
+  "  li   a0, \\n\n"
+  "  j    irq_common\n"
+  "  .endr\n"
+
+  // save the caller-saved registers, the handler is a normal C function
+  "irq_common:\n"
+  "  sw   ra,  4(sp)\n"
+  "  sw   t0,  8(sp)\n"
+  "  sw   t1, 12(sp)\n"
+  "  sw   t2, 16(sp)\n"
+  "  sw   a1, 20(sp)\n"
+  "  sw   a2, 24(sp)\n"
+  "  sw   a3, 28(sp)\n"
+  "  sw   a4, 32(sp)\n"
+  "  sw   a5, 36(sp)\n"
+#ifndef __riscv_32e
+  "  sw   a6, 40(sp)\n"
+  "  sw   a7, 44(sp)\n"
+  "  sw   t3, 48(sp)\n"
+  "  sw   t4, 52(sp)\n"
+  "  sw   t5, 56(sp)\n"
+  "  sw   t6, 60(sp)\n"
+#endif
+#ifdef __riscv_flen
+  "  .irp n, 0,1,2,3,4,5,6,7,8,9,10,11\n"
+  "  fsw  ft\\n, (64+4*\\n)(sp)\n"
+  "  .endr\n"
+  "  .irp n, 0,1,2,3,4,5,6,7\n"
+  "  fsw  fa\\n, (112+4*\\n)(sp)\n"
+  "  .endr\n"
+#endif
+
+  // XIRQs are edge-triggered, clear the pending bit before the handler runs
+  "  li   t0, 16\n"
+  "  blt  a0, t0, 1f\n"
+  "  li   t0, 1\n"
+  "  sll  t0, t0, a0\n"
+  "  csrc mip, t0\n"
+  "1:\n"
+  "  la   t0, irq_table\n"
+  "  slli t1, a0, 2\n"
+  "  add  t0, t0, t1\n"
+  "  lw   t0, 0(t0)\n"
+  "  jalr t0\n"
+
+  "  lw   a0,  0(sp)\n"
+  "  lw   ra,  4(sp)\n"
+  "  lw   t0,  8(sp)\n"
+  "  lw   t1, 12(sp)\n"
+  "  lw   t2, 16(sp)\n"
+  "  lw   a1, 20(sp)\n"
+  "  lw   a2, 24(sp)\n"
+  "  lw   a3, 28(sp)\n"
+  "  lw   a4, 32(sp)\n"
+  "  lw   a5, 36(sp)\n"
+#ifndef __riscv_32e
+  "  lw   a6, 40(sp)\n"
+  "  lw   a7, 44(sp)\n"
+  "  lw   t3, 48(sp)\n"
+  "  lw   t4, 52(sp)\n"
+  "  lw   t5, 56(sp)\n"
+  "  lw   t6, 60(sp)\n"
+#endif
+#ifdef __riscv_flen
+  "  .irp n, 0,1,2,3,4,5,6,7,8,9,10,11\n"
+  "  flw  ft\\n, (64+4*\\n)(sp)\n"
+  "  .endr\n"
+  "  .irp n, 0,1,2,3,4,5,6,7\n"
+  "  flw  fa\\n, (112+4*\\n)(sp)\n"
+  "  .endr\n"
+#endif
+  "  addi sp, sp, " IRQ_FRAME "\n"
+  "  mret\n"
+  "  .popsection\n"
+);
+
+
+/**********************************************************************//**
+ * Handler for all sources without a registered handler. Keeps the
+ * behavior of direct mode: dispatch through interrupt_handler().
+ **************************************************************************/
+static void irq_default(void) {
+
+  interrupt_handler(cpu_csr_read(CSR_MCAUSE), cpu_csr_read(CSR_MEPC));
+}
+
+
+/**********************************************************************//**
+ * Register an interrupt handler. In vectored mode it is entered directly
+ * from the vector table, in direct mode __trap_entry calls it instead of
+ * interrupt_handler().
+ *
+ * @note The pending bit of XIRQ channels is cleared before the handler
+ * is called. The timer handler has to update timecmp.
+ *
+ * @note IRQ_MSI is not supported: the core uses interrupt cause 3 for
+ * debug halt requests and enters the debug handler (airi5c_csr_file.v).
+ *
+ * @param[in] irq Interrupt, see AIRISC_IRQ_enum (e.g. IRQ_MTI, IRQ_XIRQ0 + n)
+ * @param[in] handler Normal C function (NO 'interrupt' attribute!) or 0
+ * to restore the default (interrupt_handler())
+ * @return 0 on success, -1 if irq is no interrupt source
+ **************************************************************************/
+int irq_set_handler(uint32_t irq, irq_handler_t handler) {
+
+  if ((irq >= IRQ_VECTORS) || ((irq < IRQ_XIRQ0) && (irq != IRQ_MTI) && (irq != IRQ_MEI))) {
+    return -1;
+  }
+
+  irq_table[irq] = handler ? handler : irq_default;
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Call the handler registered for an interrupt source, used by
+ * __trap_entry in direct mode.
+ *
+ * @note The pending bit of XIRQ channels is cleared before the handler
+ * is called (as in vectored mode).
+ *
+ * @param[in] irq Interrupt code (mcause without the interrupt bit)
+ * @return 1 if a handler was called, 0 if no handler is registered
+ **************************************************************************/
+IRQ_CODE int irq_call_handler(uint32_t irq) {
+
+  irq_handler_t handler;
+
+  if (irq >= IRQ_VECTORS) {
+    return 0;
+  }
+
+  handler = irq_table[irq];
+  if (handler == irq_default) {
+    return 0;
+  }
+
+  if (irq >= IRQ_XIRQ0) {
+    cpu_csr_clr(CSR_MIP, 1UL << irq);
+  }
+  handler();
+  return 1;
+}
+
+
+/**********************************************************************//**
+ * Enable an interrupt source (MIE).
+ *
+ * @param[in] irq Interrupt, see AIRISC_IRQ_enum
+ **************************************************************************/
+void irq_enable(uint32_t irq) {
+
+  cpu_csr_set(CSR_MIE, 1UL << irq);
+}
+
+
+/**********************************************************************//**
+ * Disable an interrupt source (MIE).
+ *
+ * @param[in] irq Interrupt, see AIRISC_IRQ_enum
+ **************************************************************************/
+void irq_disable(uint32_t irq) {
+
+  cpu_csr_clr(CSR_MIE, 1UL << irq);
+}
+
+
+/**********************************************************************//**
+ * Switch to vectored mode: interrupts enter through the handler table,
+ * exceptions still enter through __trap_entry.
+ **************************************************************************/
+void irq_vectored_enable(void) {
+
+  cpu_csr_write(CSR_MTVEC, (uint32_t)irq_vector_table | 1);
+}
+
+
+/**********************************************************************//**
+ * Switch back to direct mode: all traps enter through __trap_entry.
+ **************************************************************************/
+void irq_vectored_disable(void) {
+
+  cpu_csr_write(CSR_MTVEC, (uint32_t)&__trap_entry);
+}
@@ -28,12 +28,12 @@ void spi_init(volatile SPI_t* const spi, uint8_t master, uint8_t mode, uint8_t c
 
 void spi_enableOutputs(volatile SPI_t* const spi)
 {
-    spi->CTRL_SET = 0x10000000;
+    spi->CTRL_SET = 0x01000000;
 }
 
 void spi_disableOutputs(volatile SPI_t* const spi)
 {
-    spi->CTRL_CLR = 0x10000000;
+    spi->CTRL_CLR = 0x01000000;
 }
 
 void spi_setMaster(volatile SPI_t* const spi)
@@ -253,7 +253,7 @@ uint32_t spi_getRxOverflowError(volatile const SPI_t* const spi)
 
 int32_t spi_isRxWatermarkReached(volatile const SPI_t* const spi)
 {
-    if (spi->TX_STAT & 0x00040000)
+    if (spi->RX_STAT & 0x00040000)
         return -1;
 
     return 0;
@@ -352,31 +352,74 @@ void spi_writeData(volatile SPI_t* const spi, const uint8_t* data, uint32_t size
     }
     else
     {
-        // slave write not implemented yet!
+        // data is clocked out by the external master
+        spi_transfer(spi, data, 0, size);
     }
 
     spi->CTRL = ctrlReg;
 }
 
 void spi_readData(volatile SPI_t* const spi, uint8_t* data, uint32_t size)
+{
+    spi_transfer(spi, 0, data, size);
+}
+
+void spi_transfer(volatile SPI_t* const spi, const uint8_t* tx, uint8_t* rx, uint32_t size)
 {
     uint32_t ctrlReg = spi->CTRL;
+    uint32_t master = spi_isMaster(spi);
+    uint32_t sent = 0, received = 0, burst;
+    uint8_t data;
 
-    if (spi_isMaster(spi))
-    {
+    if (master)
         spi_beginTransaction(spi);
-        spi_setRxEnable(spi);
+    else
+        spi_setTxEnable(spi);
 
-        for (uint32_t i = 0; i < size; i++)
-            data[i] = spi_transferByte(spi, 0x00);
+    spi_setRxEnable(spi);
 
-        spi_endTransaction(spi);
-    }
-    else
+    while (received < size)
     {
-        // slave read not implemented yet!
+        // slave: the external master clocks the data, bytes the tx FIFO
+        // could not provide in time are skipped
+        if (sent < received)
+            sent = received;
+
+        // push ahead of the received data, but never more than the FIFO
+        // capacity, so neither the tx nor the rx FIFO can overflow
+        burst = SPI_FIFO_DEPTH - (sent - received);
+        if (burst > size - sent)
+            burst = size - sent;
+
+        if (tx)
+        {
+            for (; burst; burst--)
+                spi->DATA = tx[sent++];
+        }
+        else if (master)
+        {
+            // master read: dummy bytes generate the clock
+            for (; burst; burst--, sent++)
+                spi->DATA = 0x00;
+        }
+
+        // drain everything received so far
+        burst = spi_getRxSize(spi);
+        if (burst > size - received)
+            burst = size - received;
+
+        for (; burst; burst--)
+        {
+            data = spi->DATA;
+            if (rx)
+                rx[received] = data;
+            received++;
+        }
     }
 
+    if (master)
+        spi_endTransaction(spi);
+
     spi->CTRL = ctrlReg;
 }
 
@@ -0,0 +1,246 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : airisc_string.c
+// Author        : A. Stanitzki
+// Creation Date : 16.10.2026
+// Abstract      : Optimized memory routines. Bulk data is moved with
+//                 aligned word accesses in unrolled loops, only the
+//                 unaligned head and tail are handled bytewise.
+//
+
+#include <airisc_string.h>
+#include <stdint.h>
+
+// keep GCC from turning the copy loops back into memcpy/memset calls
+#pragma GCC optimize ("no-tree-loop-distribute-patterns")
+
+// Words per unrolled loop iteration. With the C extension, 4 words
+// keep both pointers and all temporaries in x8..x15, so every load
+// and store of the loop body is a 16-bit c.lw/c.sw.
+#ifdef __riscv_compressed
+#define UNROLL 4
+#else
+#define UNROLL 8
+#endif
+
+// copies below this size are not worth the alignment overhead
+#define BULK_MIN 8
+
+
+/**********************************************************************//**
+ * Copy n words upwards. All loads of an iteration are issued before
+ * its stores, so this is safe for overlapping buffers with dst < src.
+ **************************************************************************/
+static inline void copy_words_fwd(uint32_t* d, const uint32_t* s, size_t n) {
+
+  while (n >= UNROLL) {
+    uint32_t t0 = s[0], t1 = s[1], t2 = s[2], t3 = s[3];
+#if UNROLL == 8
+    uint32_t t4 = s[4], t5 = s[5], t6 = s[6], t7 = s[7];
+    d[4] = t4; d[5] = t5; d[6] = t6; d[7] = t7;
+#endif
+    d[0] = t0; d[1] = t1; d[2] = t2; d[3] = t3;
+    s += UNROLL;
+    d += UNROLL;
+    n -= UNROLL;
+  }
+  while (n--) {
+    *d++ = *s++;
+  }
+}
+
+
+/**********************************************************************//**
+ * Copy n words downwards, starting below d and s. Safe for overlapping
+ * buffers with dst > src.
+ **************************************************************************/
+static inline void copy_words_bwd(uint32_t* d, const uint32_t* s, size_t n) {
+
+  while (n >= UNROLL) {
+    s -= UNROLL;
+    d -= UNROLL;
+    n -= UNROLL;
+    uint32_t t0 = s[0], t1 = s[1], t2 = s[2], t3 = s[3];
+#if UNROLL == 8
+    uint32_t t4 = s[4], t5 = s[5], t6 = s[6], t7 = s[7];
+    d[4] = t4; d[5] = t5; d[6] = t6; d[7] = t7;
+#endif
+    d[0] = t0; d[1] = t1; d[2] = t2; d[3] = t3;
+  }
+  while (n--) {
+    *--d = *--s;
+  }
+}
+
+
+/**********************************************************************//**
+ * Forward copy used by memcpy and memmove (dst < src). The destination
+ * is aligned first; a source with a different alignment is read with
+ * aligned word loads and merged with shifts, as the core does not
+ * support misaligned accesses.
+ **************************************************************************/
+static void copy_fwd(uint8_t* d, const uint8_t* s, size_t n) {
+
+  if (n >= BULK_MIN) {
+    while ((uintptr_t)d & 3) {
+      *d++ = *s++;
+      n--;
+    }
+
+    size_t words = n >> 2;
+    uint32_t offs = (uintptr_t)s & 3;
+
+    if (offs == 0) {
+      copy_words_fwd((uint32_t*)d, (const uint32_t*)s, words);
+    }
+    else {
+      uint32_t shift = offs * 8;
+      const uint32_t* sw = (const uint32_t*)(s - offs);
+      uint32_t* dw = (uint32_t*)d;
+      uint32_t lo = *sw++;
+      // only words holding source bytes are read
+      for (size_t i = 0; i < words; i++) {
+        uint32_t hi = *sw++;
+        *dw++ = (lo >> shift) | (hi << (32 - shift));
+        lo = hi;
+      }
+    }
+    d += words << 2;
+    s += words << 2;
+    n &= 3;
+  }
+
+  while (n--) {
+    *d++ = *s++;
+  }
+}
+
+
+/**********************************************************************//**
+ * Copy memory.
+ *
+ * @param[in] dst Destination buffer
+ * @param[in] src Source buffer (must not overlap dst)
+ * @param[in] n Number of bytes
+ * @return dst
+ **************************************************************************/
+void* airisc_memcpy(void* restrict dst, const void* restrict src, size_t n) {
+
+  copy_fwd((uint8_t*)dst, (const uint8_t*)src, n);
+  return dst;
+}
+
+
+/**********************************************************************//**
+ * Fill memory with a byte value.
+ *
+ * @param[in] dst Destination buffer
+ * @param[in] c Fill value (converted to unsigned char)
+ * @param[in] n Number of bytes
+ * @return dst
+ **************************************************************************/
+void* airisc_memset(void* dst, int c, size_t n) {
+
+  uint8_t* d = (uint8_t*)dst;
+  uint8_t  b = (uint8_t)c;
+
+  if (n >= BULK_MIN) {
+    while ((uintptr_t)d & 3) {
+      *d++ = b;
+      n--;
+    }
+
+    // replicate with shifts, rv32i has no mul
+    uint32_t w = b;
+    w |= w << 8;
+    w |= w << 16;
+
+    uint32_t* dw = (uint32_t*)d;
+    size_t words = n >> 2;
+
+    while (words >= UNROLL) {
+      dw[0] = w; dw[1] = w; dw[2] = w; dw[3] = w;
+#if UNROLL == 8
+      dw[4] = w; dw[5] = w; dw[6] = w; dw[7] = w;
+#endif
+      dw += UNROLL;
+      words -= UNROLL;
+    }
+    while (words--) {
+      *dw++ = w;
+    }
+    d = (uint8_t*)dw;
+    n &= 3;
+  }
+
+  while (n--) {
+    *d++ = b;
+  }
+  return dst;
+}
+
+
+/**********************************************************************//**
+ * Copy memory, buffers may overlap.
+ *
+ * @note Backward copies of buffers with different alignment are done
+ * bytewise.
+ *
+ * @param[in] dst Destination buffer
+ * @param[in] src Source buffer
+ * @param[in] n Number of bytes
+ * @return dst
+ **************************************************************************/
+void* airisc_memmove(void* dst, const void* src, size_t n) {
+
+  uint8_t* d = (uint8_t*)dst;
+  const uint8_t* s = (const uint8_t*)src;
+
+  if ((d <= s) || (d >= s + n)) {
+    copy_fwd(d, s, n);
+    return dst;
+  }
+
+  // overlapping with dst > src: copy downwards
+  d += n;
+  s += n;
+
+  if ((n >= BULK_MIN) && ((((uintptr_t)d ^ (uintptr_t)s) & 3) == 0)) {
+    while ((uintptr_t)d & 3) {
+      *--d = *--s;
+      n--;
+    }
+
+    size_t words = n >> 2;
+    copy_words_bwd((uint32_t*)d, (const uint32_t*)s, words);
+    d -= words << 2;
+    s -= words << 2;
+    n &= 3;
+  }
+
+  while (n--) {
+    *--d = *--s;
+  }
+  return dst;
+}
+
+
+#ifdef AIRISC_FAST_STRING
+/**********************************************************************//**
+ * Replace the newlib routines (objects are linked before -lc).
+ **************************************************************************/
+void* memcpy(void* restrict dst, const void* restrict src, size_t n) __attribute__ ((alias ("airisc_memcpy")));
+void* memset(void* dst, int c, size_t n) __attribute__ ((alias ("airisc_memset")));
+void* memmove(void* dst, const void* src, size_t n) __attribute__ ((alias ("airisc_memmove")));
+#endif
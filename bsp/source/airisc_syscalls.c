@@ -126,6 +126,7 @@ int _read(int file, char *ptr, int len)
 
 	for (int i = 0; i < len; i++)
 	{
+		// interrupt-driven mode: read from the rx ring (see uart_readByte)
 		ptr[i] = uart_readByte(uart0);
 		if (ptr[i] == '\r')
 		{
@@ -140,18 +141,13 @@ int _read(int file, char *ptr, int len)
 // allocate heap memory
 void *_sbrk(int incr)
 {
-	extern unsigned char _end;
-	static unsigned char *heap = NULL;
-	unsigned char *prev_heap;
+	// bounded by the linker script heap region (and the stack), see airisc_alloc.c
+	void *prev_heap = airisc_heap_grow(incr);
 
-	if (heap == NULL)
-		heap = (unsigned char *)&_end;
+	if (prev_heap == (void*)-1)
+		errno = ENOMEM;
 
-	prev_heap = heap;
-
-	heap += incr;
-
-	return (void*) prev_heap;
+	return prev_heap;
 }
 
 // get file status
@@ -196,6 +192,7 @@ int _write(int file, char *ptr, int len)
 		return  -1;
 	}
 
+	// interrupt-driven mode: queued into the tx ring (see uart_writeData)
 	uart_writeData(uart0, (uint8_t*)ptr, len);
 	return len;
 }
@@ -15,6 +15,8 @@
 // Author        : S. Nolting
 // Creation Date : 05.04.2023
 // Abstract      : HAL for the true random number generator (TRNG).
+// History       : 16.10.2026 - trng_fill(), word mode and FIFO full
+//                              interrupt (A. Stanitzki)
 //
 
 #include <airisc_trng.h>
@@ -105,9 +107,126 @@ uint8_t trng_get(volatile TRNG_t* const handle) {
 
   while(1) {
     tmp = handle->CTRL;
-    if (tmp & (1 << 31)) { // data valid?
+    if (tmp & TRNG_CTRL_WORD) { // word mode, data byte is not available in CTRL
+      if (tmp & TRNG_CTRL_VALID) {
+        return (uint8_t)handle->DATA;
+      }
+    }
+    else if (tmp & (1 << 31)) { // data valid?
       return (uint8_t)tmp;
     }
   }
 }
 
+
+/**********************************************************************//**
+ * Fill a buffer with random bytes.
+ *
+ * In byte mode every CTRL read returns one byte, so the FIFO is drained
+ * with one access per byte. In word mode one CTRL read returns the FIFO
+ * level and all available entries are read back-to-back from DATA
+ * (4 bytes per access).
+ *
+ * @warning This function is blocking (stalls until len random bytes are obtained).
+ *
+ * @param[in] handle Pointer to TRNG hardware handle (TRNG_t*)
+ * @param[out] buf Destination buffer
+ * @param[in] len Number of random bytes
+ * @return 0 on success, -1 if the TRNG is disabled
+ **************************************************************************/
+int trng_fill(volatile TRNG_t* const handle, uint8_t* buf, uint32_t len) {
+
+  uint32_t tmp, level, word;
+
+  while (len) {
+    tmp = handle->CTRL;
+
+    if (!(tmp & TRNG_CTRL_EN)) {
+      return -1;
+    }
+
+    if (tmp & TRNG_CTRL_WORD) {
+      level = (tmp >> TRNG_CTRL_LEVEL_POS) & TRNG_CTRL_LEVEL_MASK;
+      for (; level && (len >= 4); level--, len -= 4, buf += 4) {
+        word = handle->DATA;
+        if (((uint32_t)buf & 3) == 0) {
+          *(uint32_t*)buf = word;
+        }
+        else {
+          buf[0] = (uint8_t)word;
+          buf[1] = (uint8_t)(word >> 8);
+          buf[2] = (uint8_t)(word >> 16);
+          buf[3] = (uint8_t)(word >> 24);
+        }
+      }
+      if (level && len) { // tail, the rest of the word is discarded
+        word = handle->DATA;
+        for (; len; len--, word >>= 8) {
+          *buf++ = (uint8_t)word;
+        }
+      }
+    }
+    else {
+      // every valid read returns the next byte, keep reading until the FIFO is empty
+      while (tmp & TRNG_CTRL_VALID) {
+        *buf++ = (uint8_t)tmp;
+        if (--len == 0) {
+          break;
+        }
+        tmp = handle->CTRL;
+      }
+    }
+  }
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Enable/disable word mode. In word mode the FIFO holds 32-bit words that
+ * are read from the DATA register (4 random bytes per bus access).
+ *
+ * @note Changing the mode clears the FIFO. In byte mode the CTRL read of
+ * this function consumes one random byte.
+ *
+ * @param[in] handle Pointer to TRNG hardware handle (TRNG_t*)
+ * @param[in] enable 1 = word mode, 0 = byte mode
+ **************************************************************************/
+void trng_word_mode(volatile TRNG_t* const handle, int enable) {
+
+  uint32_t tmp = handle->CTRL & (TRNG_CTRL_EN | TRNG_CTRL_IRQ_FULL);
+
+  handle->CTRL = enable ? (tmp | TRNG_CTRL_WORD) : tmp;
+}
+
+
+/**********************************************************************//**
+ * Enable/disable the FIFO full interrupt (XIRQ channel TRNG0_XIRQ).
+ * The interrupt line stays high while the FIFO is full, read data (e.g.
+ * with trng_fill()) before the next interrupt can be taken.
+ *
+ * @note In byte mode the CTRL read of this function consumes one random byte.
+ *
+ * @param[in] handle Pointer to TRNG hardware handle (TRNG_t*)
+ * @param[in] enable 1 = enable interrupt, 0 = disable interrupt
+ **************************************************************************/
+void trng_irq_full(volatile TRNG_t* const handle, int enable) {
+
+  uint32_t tmp = handle->CTRL & (TRNG_CTRL_EN | TRNG_CTRL_WORD);
+
+  handle->CTRL = enable ? (tmp | TRNG_CTRL_IRQ_FULL) : tmp;
+}
+
+
+/**********************************************************************//**
+ * Check if the random pool (FIFO) is full. Reads the STAT register, so
+ * no random data is consumed (also in byte mode).
+ *
+ * @param[in] handle Pointer to TRNG hardware handle (TRNG_t*)
+ * @return 1 if the FIFO is full, 0 otherwise
+ **************************************************************************/
+int trng_is_full(volatile TRNG_t* const handle) {
+
+  return (handle->STAT & TRNG_STAT_FULL) ? 1 : 0;
+}
+
@@ -12,6 +12,33 @@
 //
 
 #include "airisc_uart.h"
+#include "airisc_csr.h"
+#include "airisc_irq.h"
+#include <string.h>
+
+#define UART_TX_WATERMARK_IE 0x02000000
+#define UART_RX_WATERMARK_IE 0x02000000
+
+typedef struct
+{
+    uint8_t tx_buf[UART_RING_SIZE];
+    uint8_t rx_buf[UART_RING_SIZE];
+    volatile uint32_t tx_head;  // written by uart_write_nb
+    volatile uint32_t tx_tail;  // written by uart_irqHandler
+    volatile uint32_t rx_head;  // written by uart_irqHandler
+    volatile uint32_t rx_tail;  // written by uart_read_nb
+    volatile uint32_t enabled;
+} uart_ring_t;
+
+static uart_ring_t uart0_ring;
+
+static uart_ring_t* uart_getRing(volatile UART_t* const uart)
+{
+    if (uart == uart0)
+        return &uart0_ring;
+
+    return 0;
+}
 
 void uart_init(volatile UART_t* const uart, uint8_t dataBits, uint8_t parity, uint8_t stopBits, uint8_t flowCtrl, uint32_t cyclesPerBit)
 {
@@ -142,7 +169,7 @@ uint32_t uart_getTxSize(volatile UART_t* const uart)
 
 void uart_clrRxFIFO(volatile UART_t* const uart)
 {
-    uart->RX_STAT_SET = 0x8000000;
+    uart->RX_STAT_SET = 0x80000000;
 }
 
 void uart_clrRxFrameError(volatile UART_t* const uart)
@@ -237,34 +264,95 @@ uint32_t uart_getRxSize(volatile UART_t* const uart)
 
 void uart_writeByte(volatile UART_t* const uart, uint8_t data)
 {
+    // interrupt-driven mode: queue behind the bytes already in the tx ring
+    if (uart_isIrqModeEnabled(uart))
+    {
+        while (!uart_write_nb(uart, &data, 1));
+        return;
+    }
+
     while (uart_isTxFull(uart));
     uart->DATA = data;
 }
 
 uint8_t uart_readByte(volatile UART_t* const uart)
 {
+    uint8_t data;
+
+    // interrupt-driven mode: take the bytes in the order of the rx ring
+    if (uart_isIrqModeEnabled(uart))
+    {
+        while (!uart_read_nb(uart, &data, 1));
+        return data;
+    }
+
     while (uart_isRxEmpty(uart));
     return uart->DATA;
 }
 
 void uart_writeData(volatile UART_t* const uart, const uint8_t* data, uint32_t size)
 {
-    for (uint32_t i = 0; i < size; i++)
-        uart_writeByte(uart, data[i]);
+    uint32_t burst;
+
+    // interrupt-driven mode: queue behind the bytes already in the tx ring,
+    // blocks only while the ring is full
+    if (uart_isIrqModeEnabled(uart))
+    {
+        while (size)
+        {
+            burst = uart_write_nb(uart, data, size);
+            data += burst;
+            size -= burst;
+        }
+        return;
+    }
+
+    // read the FIFO level once and fill all free entries back to back
+    while (size)
+    {
+        burst = UART_FIFO_DEPTH - uart_getTxSize(uart);
+        if (burst > size)
+            burst = size;
+
+        size -= burst;
+        while (burst--)
+            uart->DATA = *data++;
+    }
 }
 
 void uart_readData(volatile UART_t* const uart, uint8_t* data, uint32_t size)
 {
-    for (uint32_t i = 0; i < size; i++)
-        data[i] = uart_readByte(uart);
+    uint32_t burst;
+
+    // interrupt-driven mode: take the bytes in the order of the rx ring,
+    // blocks only while the ring is empty
+    if (uart_isIrqModeEnabled(uart))
+    {
+        while (size)
+        {
+            burst = uart_read_nb(uart, data, size);
+            data += burst;
+            size -= burst;
+        }
+        return;
+    }
+
+    // read the FIFO level once and drain all available entries back to back
+    while (size)
+    {
+        burst = uart_getRxSize(uart);
+        if (burst > size)
+            burst = size;
+
+        size -= burst;
+        while (burst--)
+            *data++ = uart->DATA;
+    }
 }
 
 void uart_writeStr(volatile UART_t* const uart, const char* str)
 {
-    for (uint32_t i = 0; str[i] != '\0'; i++)
-        uart_writeByte(uart, str[i]);
-
-    uart_writeByte(uart, '\0');
+    uart_writeData(uart, (const uint8_t*)str, strlen(str) + 1);
 }
 
 uint32_t uart_readStr(volatile UART_t* const uart, char* str, uint32_t size)
@@ -281,3 +369,184 @@ uint32_t uart_readStr(volatile UART_t* const uart, char* str, uint32_t size)
 
     return size;
 }
+
+// XIRQ handler of uart0, registered by uart_enableIrqMode
+static void uart0_irq(void)
+{
+    uart_irqHandler(uart0);
+}
+
+int32_t uart_enableIrqMode(volatile UART_t* const uart)
+{
+    uart_ring_t* ring = uart_getRing(uart);
+
+    if (!ring)
+        return -1;
+
+    ring->tx_head = 0;
+    ring->tx_tail = 0;
+    ring->rx_head = 0;
+    ring->rx_tail = 0;
+    ring->enabled = 1;
+
+    // rx: interrupt as soon as a single byte is available
+    // tx: interrupt is only enabled while the tx ring holds data
+    uart->TX_STAT_CLR = UART_TX_WATERMARK_IE;
+    uart_setTxWatermark(uart, UART_IRQ_TX_WATERMARK);
+    uart_setRxWatermark(uart, 1);
+    uart->RX_STAT_SET = UART_RX_WATERMARK_IE;
+
+    irq_set_handler(IRQ_XIRQ0 + UART0_XIRQ, uart0_irq);
+    cpu_csr_set(CSR_MIE, 1UL << (IRQ_XIRQ0 + UART0_XIRQ));
+    return 0;
+}
+
+void uart_disableIrqMode(volatile UART_t* const uart)
+{
+    uart_ring_t* ring = uart_getRing(uart);
+
+    if (!ring || !ring->enabled)
+        return;
+
+    cpu_csr_clr(CSR_MIE, 1UL << (IRQ_XIRQ0 + UART0_XIRQ));
+    irq_set_handler(IRQ_XIRQ0 + UART0_XIRQ, 0);
+    uart->TX_STAT_CLR = UART_TX_WATERMARK_IE;
+    uart->RX_STAT_CLR = UART_RX_WATERMARK_IE;
+    ring->enabled = 0;
+
+    // flush pending tx data, unread rx data remains in the ring
+    while (ring->tx_tail != ring->tx_head)
+    {
+        uart_writeByte(uart, ring->tx_buf[ring->tx_tail]);
+        ring->tx_tail = (ring->tx_tail + 1) & (UART_RING_SIZE - 1);
+    }
+}
+
+int32_t uart_isIrqModeEnabled(volatile UART_t* const uart)
+{
+    uart_ring_t* ring = uart_getRing(uart);
+
+    if (ring && ring->enabled)
+        return -1;
+
+    return 0;
+}
+
+void uart_irqHandler(volatile UART_t* const uart)
+{
+    uart_ring_t* ring = uart_getRing(uart);
+    uint32_t rx_stat, tx_stat, next, burst;
+
+    if (!ring)
+        return;
+
+    // XIRQs are edge-triggered: clear the pending bit first and service
+    // until no enabled source is left, so that the next event raises a new edge
+    cpu_csr_clr(CSR_MIP, 1UL << (IRQ_XIRQ0 + UART0_XIRQ));
+
+    while (1)
+    {
+        // drain the available rx FIFO entries into the rx ring
+        rx_stat = uart->RX_STAT;
+        burst = (rx_stat & UART_RX_WATERMARK_IE) ? (rx_stat & 0x000000FF) : 0;
+        while (burst--)
+        {
+            next = (ring->rx_head + 1) & (UART_RING_SIZE - 1);
+            if (next == ring->rx_tail)
+            {
+                // ring is full, keep data in the FIFO until uart_read_nb makes room
+                uart->RX_STAT_CLR = UART_RX_WATERMARK_IE;
+                break;
+            }
+            ring->rx_buf[ring->rx_head] = uart->DATA;
+            ring->rx_head = next;
+        }
+
+        // refill the free tx FIFO entries from the tx ring
+        burst = UART_FIFO_DEPTH - uart_getTxSize(uart);
+        while (burst-- && ring->tx_tail != ring->tx_head)
+        {
+            uart->DATA = ring->tx_buf[ring->tx_tail];
+            ring->tx_tail = (ring->tx_tail + 1) & (UART_RING_SIZE - 1);
+        }
+        tx_stat = uart->TX_STAT;
+        if (ring->tx_tail == ring->tx_head)
+        {
+            uart->TX_STAT_CLR = UART_TX_WATERMARK_IE;
+            tx_stat = uart->TX_STAT;
+        }
+
+        rx_stat = uart->RX_STAT;
+        if (!((rx_stat & UART_RX_WATERMARK_IE) && (rx_stat & 0x00040000)) &&
+            !((tx_stat & UART_TX_WATERMARK_IE) && (tx_stat & 0x00040000)))
+            break;
+    }
+}
+
+uint32_t uart_write_nb(volatile UART_t* const uart, const uint8_t* data, uint32_t size)
+{
+    uart_ring_t* ring = uart_getRing(uart);
+    uint32_t i, next, burst;
+
+    // polling mode: only fill the free FIFO entries
+    if (!ring || !ring->enabled)
+    {
+        burst = UART_FIFO_DEPTH - uart_getTxSize(uart);
+        for (i = 0; i < size && i < burst; i++)
+            uart->DATA = data[i];
+
+        return i;
+    }
+
+    for (i = 0; i < size; i++)
+    {
+        next = (ring->tx_head + 1) & (UART_RING_SIZE - 1);
+        if (next == ring->tx_tail)
+            break;
+
+        ring->tx_buf[ring->tx_head] = data[i];
+        ring->tx_head = next;
+    }
+
+    // (re-)arm the tx watermark interrupt; if the FIFO is below the
+    // watermark, this immediately raises the interrupt
+    if (i)
+        uart->TX_STAT_SET = UART_TX_WATERMARK_IE;
+
+    // interrupts are globally disabled: move data by hand
+    if (!(cpu_csr_read(CSR_MSTATUS) & (1UL << MSTATUS_MIE)))
+        uart_irqHandler(uart);
+
+    return i;
+}
+
+uint32_t uart_read_nb(volatile UART_t* const uart, uint8_t* data, uint32_t size)
+{
+    uart_ring_t* ring = uart_getRing(uart);
+    uint32_t i, burst;
+
+    // polling mode: only read the available FIFO entries
+    if (!ring || !ring->enabled)
+    {
+        burst = uart_getRxSize(uart);
+        for (i = 0; i < size && i < burst; i++)
+            data[i] = uart->DATA;
+
+        return i;
+    }
+
+    if (!(cpu_csr_read(CSR_MSTATUS) & (1UL << MSTATUS_MIE)))
+        uart_irqHandler(uart);
+
+    for (i = 0; i < size && ring->rx_tail != ring->rx_head; i++)
+    {
+        data[i] = ring->rx_buf[ring->rx_tail];
+        ring->rx_tail = (ring->rx_tail + 1) & (UART_RING_SIZE - 1);
+    }
+
+    // there is room in the ring again, resume draining the FIFO
+    if (i)
+        uart->RX_STAT_SET = UART_RX_WATERMARK_IE;
+
+    return i;
+}
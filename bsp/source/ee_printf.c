@@ -33,6 +33,18 @@ typedef size_t ee_size_t;
 
 static char *    digits       = "0123456789abcdefghijklmnopqrstuvwxyz";
 static char *    upper_digits = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+/* "00" .. "99", two decimal digits per lookup */
+static const char digit_pairs[201] = "00010203040506070809"
+                                     "10111213141516171819"
+                                     "20212223242526272829"
+                                     "30313233343536373839"
+                                     "40414243444546474849"
+                                     "50515253545556575859"
+                                     "60616263646566676869"
+                                     "70717273747576777879"
+                                     "80818283848586878889"
+                                     "90919293949596979899";
 static ee_size_t strnlen(const char *s, ee_size_t count);
 
 static ee_size_t
@@ -53,6 +65,53 @@ skip_atoi(const char **s)
     return i;
 }
 
+/* n / 100 without a division: multiply-high with M, shift-add without */
+static inline unsigned long
+div100(unsigned long n)
+{
+#ifdef __riscv_mul
+    return (unsigned long)(((unsigned long long)n * 0x51EB851FULL) >> 37);
+#else
+    unsigned long q, r;
+    q = (n >> 1) + (n >> 3) + (n >> 6) - (n >> 10) + (n >> 12) + (n >> 13)
+        - (n >> 16);
+    q = q + (q >> 20);
+    q = q >> 6;
+    r = n - q * 100;
+    return q + ((r + 28) >> 7);
+#endif
+}
+
+/*
+ * Decimal conversion, least significant digit first. Two digits per
+ * step via div100() and the digit pair table, so no per-digit
+ * divide/modulo is executed (mul_div unit or libgcc).
+ */
+static int
+utoa_dec(char *tmp, unsigned long n)
+{
+    int           i = 0;
+    unsigned long q, r;
+
+    while (n >= 100)
+    {
+        q        = div100(n);
+        r        = n - q * 100;
+        tmp[i++] = digit_pairs[2 * r + 1];
+        tmp[i++] = digit_pairs[2 * r];
+        n        = q;
+    }
+    if (n >= 10)
+    {
+        tmp[i++] = digit_pairs[2 * n + 1];
+        tmp[i++] = digit_pairs[2 * n];
+    }
+    else
+        tmp[i++] = '0' + n;
+
+    return i;
+}
+
 static char *
 number(char *str, long num, int base, int size, int precision, int type)
 {
@@ -101,6 +160,18 @@ number(char *str, long num, int base, int size, int precision, int type)
 
     if (num == 0)
         tmp[i++] = '0';
+    else if (base == 10)
+        i = utoa_dec(tmp, (unsigned long)num);
+    else if (base == 16 || base == 8)
+    {
+        int shift = (base == 16) ? 4 : 3;
+        unsigned long u = (unsigned long)num;
+        while (u != 0)
+        {
+            tmp[i++] = dig[u & (base - 1)];
+            u        = u >> shift;
+        }
+    }
     else
     {
         while (num != 0)
@@ -670,23 +741,40 @@ uart_send_char(char c)
 	uart_writeByte(uart0, c);
 }
 
+/* emit a formatted line with one bulk write */
+static void
+uart_send_buf(const char *buf, int n)
+{
+    /* in interrupt-driven mode, this queues into the tx ring */
+    uart_writeData(uart0, (const uint8_t *)buf, n);
+}
+
+int
+ee_sprintf(char *buf, const char *fmt, ...)
+{
+    va_list args;
+    int     n;
+
+    va_start(args, fmt);
+    n = ee_vsprintf(buf, fmt, args);
+    va_end(args);
+
+    return n;
+}
+
 int
 ee_printf(const char *fmt, ...)
 {
-    char    buf[256], *p;
+    char    buf[256];
     va_list args;
-    int     n = 0;
+    int     n;
 
+    /* format into the stack buffer, then emit the whole line at once */
     va_start(args, fmt);
-    ee_vsprintf(buf, fmt, args);
+    n = ee_vsprintf(buf, fmt, args);
     va_end(args);
-    p = buf;
-    while (*p)
-    {
-        uart_send_char(*p);
-        n++;
-        p++;
-    }
+
+    uart_send_buf(buf, n);
 
     return n;
 }
@@ -129,6 +129,8 @@ set files [list \
  [file normalize "${origin_dir}/../src/airi5c_decompression.v"] \
  [file normalize "${origin_dir}/../src/airi5c_mem_arbiter.v"] \
  [file normalize "${origin_dir}/../src/airi5c_branch_prediction.v"] \
+ [file normalize "${origin_dir}/../src/airi5c_icache.v"] \
+ [file normalize "${origin_dir}/../src/airi5c_dcache.v"] \
  [file normalize "${origin_dir}/../src/airi5c_dmi_constants.vh"] \
  [file normalize "${origin_dir}/../src/airi5c_csr_addr_map.vh"] \
  [file normalize "${origin_dir}/../src/airi5c_hasti_constants.vh"] \
@@ -144,6 +146,8 @@ set files [list \
  [file normalize "${origin_dir}/../src/airi5c_periph_mux.v"] \
  [file normalize "${origin_dir}/../src/modules/airi5c_dtm/src/airi5c_dtm.v"] \
  [file normalize "${origin_dir}/../src/modules/airi5c_gpio/src/airi5c_gpio.v"] \
+ [file normalize "${origin_dir}/../src/modules/airi5c_dma/src/airi5c_dma.v"] \
+ [file normalize "${origin_dir}/../src/modules/airi5c_dma/src/airi5c_dma_arbiter.v"] \
  [file normalize "${origin_dir}/../src/airi5c_sync_to_hasti_bridge.v"] \
  [file normalize "${origin_dir}/../src/airi5c_imm_gen.v"] \
  [file normalize "${origin_dir}/../src/airi5c_pipeline.v"] \
@@ -173,6 +177,7 @@ set files [list \
  [file normalize "${origin_dir}/../src/modules/airi5c_fpu/airi5c_float_multiplier.v"] \
  [file normalize "${origin_dir}/../src/modules/airi5c_fpu/airi5c_float_sqrt.v"] \
  [file normalize "${origin_dir}/../src/modules/airi5c_fpu/airi5c_FPU.v"] \
+ [file normalize "${origin_dir}/../src/modules/airi5c_fpu/airi5c_FPU_pipe.v"] \
  [file normalize "${origin_dir}/../src/modules/airi5c_fpu/airi5c_FPU_constants.vh"] \
  [file normalize "${origin_dir}/../src/modules/airi5c_fpu/airi5c_FPU_core.v"] \
  [file normalize "${origin_dir}/../src/modules/airi5c_fpu/airi5c_ftoi_converter.v"] \
@@ -299,6 +304,7 @@ set obj [get_filesets sim_1]
 set files [list \
  [file normalize "${origin_dir}/../tb/configs/airi5c_cfg_ideal_sram.v"] \
  [file normalize "${origin_dir}/../tb/modules/airi5c_dp_hasti_sram.v"] \
+ [file normalize "${origin_dir}/../tb/modules/airi5c_hasti_wait_states.v"] \
  [file normalize "${origin_dir}/../tb/configs/airi5c_top_asic.v"] \
  [file normalize "${origin_dir}/../tb/airi5c_top_tb.v"] \
 ]
@@ -76,6 +76,18 @@ module airi5c_EX_pregs(
   input                           loadstore_de_i,
   input                           predicted_branch_de_i,
 
+  // second issue slot (DUAL_ISSUE)
+  input                           de_valid2_i,
+  input   [`XPR_LEN-1:0]          pc_de2_i,
+  input   [`INST_WIDTH-1:0]       inst_de2_i,
+  input                           imem_compressed_de2_i,
+  input   [`ALU_OP_WIDTH-1:0]     alu_op2_de_i,
+  input   [`SRC_A_SEL_WIDTH-1:0]  src_a_sel2_de_i,
+  input   [`SRC_B_SEL_WIDTH-1:0]  src_b_sel2_de_i,
+  input   [`IMM_TYPE_WIDTH-1:0]   imm_type2_de_i,
+  input                           uses2_rs1_de_i,
+  input                           uses2_rs2_de_i,
+
 `ifdef ISA_EXT_F
   // FPU
   input   [`FPU_OP_WIDTH-1:0]     fpu_op_de_i,
@@ -119,7 +131,19 @@ module airi5c_EX_pregs(
   output  [4:0]                   rs2_addr_EX_o,
   output  [4:0]                   rs3_addr_EX_o,
   output                          loadstore_EX_o,
-  output                          predicted_branch_ex_o
+  output                          predicted_branch_ex_o,
+
+  // second issue slot (DUAL_ISSUE)
+  output                          ex_valid2_o,
+  output  [`XPR_LEN-1:0]          PC2_EX_o,
+  output  [`INST_WIDTH-1:0]       inst2_EX_o,
+  output                          imem_compressed2_EX_o,
+  output  [`ALU_OP_WIDTH-1:0]     alu_op2_EX_o,
+  output  [`SRC_A_SEL_WIDTH-1:0]  src_a_sel2_EX_o,
+  output  [`SRC_B_SEL_WIDTH-1:0]  src_b_sel2_EX_o,
+  output  [`IMM_TYPE_WIDTH-1:0]   imm_type2_EX_o,
+  output                          uses2_rs1_EX_o,
+  output                          uses2_rs2_EX_o
 
 `ifdef ISA_EXT_F
   ,
@@ -363,5 +387,63 @@ module airi5c_EX_pregs(
       end
     end
   end
+
+  // second issue slot (DUAL_ISSUE), stalled and killed together with the first one
+  reg                           ex_valid2_d;
+  reg   [`XPR_LEN-1:0]          PC2_EX_d;
+  reg   [`INST_WIDTH-1:0]       inst2_EX_d;
+  reg                           imem_compressed2_EX_d;
+  reg   [`ALU_OP_WIDTH-1:0]     alu_op2_EX_d;
+  reg   [`SRC_A_SEL_WIDTH-1:0]  src_a_sel2_EX_d;
+  reg   [`SRC_B_SEL_WIDTH-1:0]  src_b_sel2_EX_d;
+  reg   [`IMM_TYPE_WIDTH-1:0]   imm_type2_EX_d;
+  reg                           uses2_rs1_EX_d;
+  reg                           uses2_rs2_EX_d;
+
+  assign ex_valid2_o              = ex_valid2_d;
+  assign PC2_EX_o                 = PC2_EX_d;
+  assign inst2_EX_o               = inst2_EX_d;
+  assign imem_compressed2_EX_o    = imem_compressed2_EX_d;
+  assign alu_op2_EX_o             = alu_op2_EX_d;
+  assign src_a_sel2_EX_o          = src_a_sel2_EX_d;
+  assign src_b_sel2_EX_o          = src_b_sel2_EX_d;
+  assign imm_type2_EX_o           = imm_type2_EX_d;
+  assign uses2_rs1_EX_o           = uses2_rs1_EX_d;
+  assign uses2_rs2_EX_o           = uses2_rs2_EX_d;
+
+  always @(posedge clk_i or negedge rst_ni) begin
+    if (~rst_ni) begin
+      ex_valid2_d              <= 1'b0;
+      PC2_EX_d                 <= `START_HANDLER;
+      inst2_EX_d               <= `RV_NOP;
+      imem_compressed2_EX_d    <= 1'b0;
+      alu_op2_EX_d             <= `ALU_OP_ADD;
+      src_a_sel2_EX_d          <= `SRC_A_RS1;
+      src_b_sel2_EX_d          <= `SRC_B_IMM;
+      imm_type2_EX_d           <= `IMM_I;
+      uses2_rs1_EX_d           <= 1'b0;
+      uses2_rs2_EX_d           <= 1'b0;
+    end else if (~stall_ex_i) begin
+      if (killed_de_i | killed_ex_i) begin
+        ex_valid2_d              <= 1'b0;
+        inst2_EX_d               <= `RV_NOP;
+        imem_compressed2_EX_d    <= 1'b0;
+        uses2_rs1_EX_d           <= 1'b0;
+        uses2_rs2_EX_d           <= 1'b0;
+      end else begin
+        ex_valid2_d              <= de_valid2_i;
+        PC2_EX_d                 <= pc_de2_i;
+        inst2_EX_d               <= inst_de2_i;
+        imem_compressed2_EX_d    <= imem_compressed_de2_i;
+        alu_op2_EX_d             <= alu_op2_de_i;
+        src_a_sel2_EX_d          <= src_a_sel2_de_i;
+        src_b_sel2_EX_d          <= src_b_sel2_de_i;
+        imm_type2_EX_d           <= imm_type2_de_i;
+        uses2_rs1_EX_d           <= uses2_rs1_de_i & de_valid2_i;
+        uses2_rs2_EX_d           <= uses2_rs2_de_i & de_valid2_i;
+      end
+    end
+  end
+
 endmodule
 
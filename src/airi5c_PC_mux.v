@@ -39,7 +39,8 @@ module airi5c_pc_mux(
   input  [`XPR_LEN-1:0]          handler_pc_i,
   input  [`XPR_LEN-1:0]          dpc_i,
   input  [`XPR_LEN-1:0]          epc_i,
-  output [`XPR_LEN-1:0]          pc_pif_o
+  output [`XPR_LEN-1:0]          pc_pif_o,
+  output [`XPR_LEN-1:0]          jalr_target_o   // to check predicted jalr targets
   );
 
   wire [`XPR_LEN-1:0] imm_b = { {20{inst_ex_i[31]}}, inst_ex_i[7], inst_ex_i[30:25], inst_ex_i[11:8], 1'b0 };
@@ -108,5 +109,7 @@ module airi5c_pc_mux(
 
   assign pc_pif_o = result;
 
+  assign jalr_target_o = (rs1_data_bypassed_i + jalr_offset) & ~(`XPR_LEN'h1);
+
 endmodule
 
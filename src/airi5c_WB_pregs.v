@@ -36,6 +36,9 @@ input [`XPR_LEN-1:0]            pcpi_rd2_i,
 input                           pcpi_use_rd64_i,
 input [`XPR_LEN-1:0]            inst_ex_i,
 input [`XPR_LEN-1:0]            rs1_data_i,
+input                           compressed_ex_i,
+input [`XPR_LEN-1:0]            alu_out2_i,          // second issue slot (DUAL_ISSUE)
+input                           compressed2_ex_i,
 
 output                           prev_killed_WB_o,
 output                           had_ex_WB_o,
@@ -48,7 +51,10 @@ output [`XPR_LEN-1:0]           pcpi_rd_wb_o,
 output [`XPR_LEN-1:0]           pcpi_rd2_wb_o,
 output                          pcpi_use_rd64_wb_o,
 output [`XPR_LEN-1:0]           inst_wb_o,
-output [`XPR_LEN-1:0]           rs1_data_wb_o
+output [`XPR_LEN-1:0]           rs1_data_wb_o,
+output                          compressed_wb_o,
+output [`XPR_LEN-1:0]           alu_out2_wb_o,
+output                          compressed2_wb_o
 
 `ifdef ISA_EXT_F
 ,
@@ -70,6 +76,9 @@ reg [`XPR_LEN-1:0]               pcpi_rd2_wb_r;
 reg                              pcpi_use_rd64_wb_r;
 reg [`XPR_LEN-1:0]               inst_wb_r;
 reg [`XPR_LEN-1:0]               rs1_data_wb_r;
+reg                              compressed_wb_r;
+reg [`XPR_LEN-1:0]               alu_out2_wb_r;
+reg                              compressed2_wb_r;
 
 assign prev_killed_WB_o      =  prev_killed_WB_r;
 assign had_ex_WB_o           =  had_ex_WB_r;
@@ -83,6 +92,9 @@ assign pcpi_rd2_wb_o         =  pcpi_rd2_wb_r;
 assign pcpi_use_rd64_wb_o    =  pcpi_use_rd64_wb_r;
 assign inst_wb_o             =  inst_wb_r;
 assign rs1_data_wb_o         =  rs1_data_wb_r;
+assign compressed_wb_o       =  compressed_wb_r;
+assign alu_out2_wb_o         =  alu_out2_wb_r;
+assign compressed2_wb_o      =  compressed2_wb_r;
 
 `ifdef ISA_EXT_F
 reg [`XPR_LEN-1:0]              fpu_out_wb_r;
@@ -104,6 +116,9 @@ always @(posedge clk_i or negedge rst_ni) begin
     pcpi_use_rd64_wb_r    <= 0;
     inst_wb_r             <= 0;
     rs1_data_wb_r         <= 0;
+    compressed_wb_r       <= 0;
+    alu_out2_wb_r         <= 0;
+    compressed2_wb_r      <= 0;
 `ifdef ISA_EXT_F
    fpu_out_wb_r           <= 0;
 `endif
@@ -120,6 +135,9 @@ always @(posedge clk_i or negedge rst_ni) begin
     pcpi_use_rd64_wb_r    <= pcpi_use_rd64_i;
     inst_wb_r             <= inst_ex_i;
     rs1_data_wb_r         <= rs1_data_i;
+    compressed_wb_r       <= compressed_ex_i;
+    alu_out2_wb_r         <= alu_out2_i;
+    compressed2_wb_r      <= compressed2_ex_i;
 `ifdef ISA_EXT_F
     fpu_out_wb_r         <= fpu_out_i;
 `endif 
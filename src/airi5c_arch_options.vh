@@ -130,6 +130,53 @@
 // `undef ARCH_M_FAST
 `define ARCH_M_FAST
 
+// Pipelined MUL/DIV (experimental)
+// --------------------------------
+//
+// ARCH_M_PIPELINED replaces the sequential
+// unit: pipelined 33x33 multiplier
+// (DSP-inferable) and a radix-4 divider that
+// skips leading quotient zeros (fewer
+// iterations for small dividends or large
+// divisors). Opt-in until it passes the
+// rv32um riscv-tests in simulation.
+// Can also be defined from the command line (-DARCH_M_PIPELINED).
+// requires: ISA_EXT_M, ISA_EXT_P disabled
+//
+// Default = undefined (sequential MUL/DIV)
+
+//`define ARCH_M_PIPELINED
+
+// Decoupled MUL/DIV (experimental)
+// --------------------------------
+//
+// With ARCH_M_SCOREBOARD, the pipelined MUL/DIV
+// does not stall EX: instructions are issued
+// to the unit and write back later, only
+// instructions that use the result (or
+// overwrite it) wait (register scoreboard,
+// PCPI_SCOREBOARD in airi5c_ctrl.v).
+// Independent MULs can be issued
+// back-to-back. Opt-in until it passes the
+// rv32um riscv-tests.
+// Can also be defined from the command line (-DARCH_M_SCOREBOARD).
+// requires: ISA_EXT_M, ARCH_M_PIPELINED, ISA_EXT_P disabled
+//
+// Default = undefined (EX waits for MUL/DIV)
+
+//`define ARCH_M_SCOREBOARD
+
+// derived, do not edit
+`ifdef ISA_EXT_M
+`ifndef ISA_EXT_P
+`ifdef ARCH_M_PIPELINED
+`ifdef ARCH_M_SCOREBOARD
+  `define PCPI_SCOREBOARD
+`endif
+`endif
+`endif
+`endif
+
 
 // Arbitrary CUSTOM ISA extensions
 // ========================================
@@ -173,7 +220,9 @@
 // ====================
 
 // Instruction prefetch buffer
-`define IPB_DEPTH 4 // has to be a power of 2, min 4
+`ifndef IPB_DEPTH
+  `define IPB_DEPTH 4 // has to be a power of 2, min 4 (min 8 with IFETCH_WIDTH = 64, checked in airi5c_fetch.v)
+`endif
 
 // Entry point after reset
 `define START_HANDLER `XPR_LEN'h80000000
@@ -184,6 +233,12 @@
 // number of AIRISC external interrupt lines (0..16)
 `define N_EXT_INTS 16
 
+// AIRISC external interrupt lines used by on-chip peripherals
+// (have to be < N_EXT_INTS, not connected to ext_interrupt)
+`define UART0_XIRQ 15
+`define DMA0_XIRQ  14
+`define TRNG0_XIRQ 13
+
 // memory segments for debug ROM and main memory
 `define ADDR_DEBUG_ROM       32'b0???????????????????????????????
 `define ADDR_IMEM            32'b1???????????????????????????????
@@ -228,7 +283,10 @@
 `define ICAP_ADDR_WIDTH         32'd8
 
 `define TRNG_BASE_ADDR          32'hC0000800
-`define TRNG_ADDR_WIDTH         32'd2
+`define TRNG_ADDR_WIDTH         32'd4
+
+`define DMA0_BASE_ADDR          32'hC0000900
+`define DMA0_ADDR_WIDTH         32'd8
 
 
 // ==============================================
@@ -252,3 +310,151 @@
 
 //`define WITH_LATCH_REGFILE
 `undef WITH_LATCH_REGFILE
+
+// Branch prediction
+// =================
+// The prediction is made when an instruction leaves the prefetch
+// buffer, a predicted-taken branch restarts the fetcher at its
+// target. Mispredictions are redirected from EX as before.
+// 0 = none: every taken branch/jump is redirected from EX
+// 1 = static: backward branches and jal taken, forward branches
+//     not taken, jalr not predicted
+// 2 = dynamic: 2-bit counters (BHT) for branches, jal taken, jalr
+//     targets from a direct-mapped BTB, trained from EX
+// BP_GHR_BITS > 0 indexes the BHT with PC ^ global history (gshare).
+// BP_RAS_DEPTH > 0 adds a return address stack for function returns
+// (1 and 2), calls deeper than BP_RAS_DEPTH lose the oldest entry.
+// Can be overridden from the command line (e.g. -DBRANCH_PREDICTION=2).
+// requires: nothing
+
+`ifndef BRANCH_PREDICTION
+  `define BRANCH_PREDICTION 0
+`endif
+`define BP_BHT_ENTRIES 64 // power of 2
+`define BP_BTB_ENTRIES 16 // power of 2
+`ifndef BP_GHR_BITS
+  `define BP_GHR_BITS  0  // 0 = bimodal, max. log2(BP_BHT_ENTRIES)
+`endif
+`ifndef BP_RAS_DEPTH
+  `define BP_RAS_DEPTH 4  // 0 = no RAS
+`endif
+
+// Instruction cache
+// =================
+// Sits between the fetcher and the IMEM bus (see airi5c_icache.v),
+// useful with a single-port memory behind airi5c_mem_arbiter.v or
+// with slow instruction memory. Misses refill a whole line with an
+// INCR4/INCR8 burst, fence.i invalidates all lines.
+// ICACHE_WAYS: 0 = no cache, 1 = direct-mapped, 2 = 2-way (LRU)
+// Size = ICACHE_WAYS * ICACHE_SETS * ICACHE_LINE_WORDS * 4 bytes.
+// Can be overridden from the command line (e.g. -DICACHE_WAYS=2).
+// requires: nothing
+
+`ifndef ICACHE_WAYS
+  `define ICACHE_WAYS       0
+`endif
+`ifndef ICACHE_SETS
+  `define ICACHE_SETS       64 // power of 2
+`endif
+`ifndef ICACHE_LINE_WORDS
+  `define ICACHE_LINE_WORDS 4  // 4 or 8
+`endif
+
+// Instruction fetch width
+// =======================
+// IFETCH_WIDTH = 64 fetches two words (8-byte aligned) per cycle from
+// the instruction cache, so up to four half-words are added to the
+// prefetch buffer at once. With ISA_EXT_C, a misaligned 32-bit
+// instruction at a jump target is then mostly supplied by a single
+// fetch, and the buffer runs ahead of compressed code. The IMEM bus
+// itself stays 32 bit (line refills). Use IPB_DEPTH >= 8.
+// Can be overridden from the command line (e.g. -DIFETCH_WIDTH=64).
+// requires: ICACHE_WAYS != 0, WITH_SAFETY_FEATURES disabled
+
+`ifndef IFETCH_WIDTH
+  `define IFETCH_WIDTH      32 // 32 or 64
+`endif
+
+// Data cache
+// ==========
+// Write-back, write-allocate cache with a store buffer between the
+// pipeline and the DMEM bus (see airi5c_dcache.v). Store misses
+// do not stall, loads only wait for misses. The peripheral window
+// (0xC0000000 - 0xFFFFFFFF) is never cached. fence and fence.i stall
+// until all dirty lines are written back. fence.i also invalidates
+// all lines, so data written by DMA is read from memory afterwards.
+// Bus errors on the DMEM port are not reported. In debug mode, stores
+// are written through.
+// DCACHE_WAYS: 0 = no cache, 1 = direct-mapped, 2 = 2-way (LRU)
+// Size = DCACHE_WAYS * DCACHE_SETS * DCACHE_LINE_WORDS * 4 bytes.
+// Can be overridden from the command line (e.g. -DDCACHE_WAYS=2).
+// requires: nothing
+
+`ifndef DCACHE_WAYS
+  `define DCACHE_WAYS       0
+`endif
+`ifndef DCACHE_SETS
+  `define DCACHE_SETS       64 // power of 2
+`endif
+`ifndef DCACHE_LINE_WORDS
+  `define DCACHE_LINE_WORDS 4  // 4 or 8
+`endif
+`ifndef DCACHE_SB_DEPTH
+  `define DCACHE_SB_DEPTH   4  // store buffer entries, power of 2
+`endif
+
+// Hardware performance monitor
+// ============================
+// Implements mhpmcounter3 .. mhpmcounter(3+HPM_COUNTERS-1) with the
+// mhpmevent selectors (event IDs see airi5c_csr_addr_map.vh), the
+// counters are stopped by the corresponding mcountinhibit bits.
+// The remaining HPM counters and selectors read as zero.
+// HPM_COUNTERS: 0 .. 29, HPM_COUNTER_WIDTH: 1 .. 64 bit
+// Can be overridden from the command line (e.g. -DHPM_COUNTERS=8).
+// requires: ISA_EXT_E disabled
+
+`ifndef HPM_COUNTERS
+  `define HPM_COUNTERS      0
+`endif
+`ifndef HPM_COUNTER_WIDTH
+  `define HPM_COUNTER_WIDTH 40
+`endif
+
+// Dual issue
+// ==========
+// DUAL_ISSUE = 1 issues two instructions per cycle (in order) when the
+// first one is an ALU operation (OP-IMM, OP without M/PCPI, LUI, AUIPC)
+// or an integer load/store and the second one is an ALU operation that
+// neither reads nor writes the destination register of the first one.
+// The second instruction uses its own ALU, two additional register file
+// read ports and a second register file write port. Both instructions
+// are stalled and killed together, the second one is never issued in
+// step mode or behind a predicted branch.
+// Can be overridden from the command line (e.g. -DDUAL_ISSUE=1).
+// requires: IFETCH_WIDTH = 64, IPB_DEPTH >= 8, WITH_SAFETY_FEATURES disabled,
+//           ISA_EXT_E disabled (forced to 0 with ISA_EXT_E)
+
+`ifndef DUAL_ISSUE
+  `define DUAL_ISSUE        0 // 0 or 1
+`endif
+
+// derived, do not edit
+`ifdef ISA_EXT_E
+  `undef DUAL_ISSUE
+  `define DUAL_ISSUE        0
+`endif
+
+// Pipelined FPU
+// =============
+// FPU_PIPELINED = 1 executes FADD/FSUB/FMUL and FMADD/FMSUB/FNMADD/FNMSUB
+// in a separate unit (see airi5c_FPU_pipe.v) that accepts one operation
+// per cycle (latency 5 cycles). The instructions leave EX when they are
+// issued, the result is written to the float register file later (float
+// register scoreboard, see airi5c_ctrl.v). Multiply-add is fused (single
+// rounding). The remaining float instructions use the sequential FPU.
+// Can be overridden from the command line (e.g. -DFPU_PIPELINED=1).
+// requires: ISA_EXT_F
+
+`ifndef FPU_PIPELINED
+  `define FPU_PIPELINED     0 // 0 or 1
+`endif
@@ -14,53 +14,237 @@
 // File             : airi5c_branch_prediction.v
 // Author           : M. Richter, S. Nolting
 // Creation Date    : 21.12.21
-// Last Modified    : 14.12.22
-// Version          : 0.1
+// Last Modified    : 17.10.26
+// Version          : 0.3
 // Abstract         : Branch prediction logic for AIRISC
 // History          : 21.12.2021 - initial creation [richter]
 //                  : 14.12.2022 - cleanups [nolting]
-// Notes            : 
+//                  : 16.10.2026 - dynamic prediction (BHT/gshare + BTB), prediction
+//                                 on the decompressed instruction [stanitzki]
+//                  : 17.10.2026 - return address stack [stanitzki]
+// Notes            : The prediction is made when the instruction is issued
+//                    from the prefetch buffer to DE (see airi5c_fetch.v).
+//                    Branch and jal targets are calculated from the instruction,
+//                    so only the direction can be wrong. jalr targets come
+//                    from the RAS (returns) or the BTB and are checked in EX
+//                    against PC_DE.
 //
 
 `include "rv32_opcodes.vh"
 
-module airi5c_branch_prediction (
-  input   [`XPR_LEN-1:0]  instruction_i,
+module airi5c_branch_prediction #(
+  parameter DYNAMIC     = 0,  // 0: static, 1: BHT + BTB
+  parameter BHT_ENTRIES = 64, // 2-bit counters, power of 2, min 2
+  parameter BTB_ENTRIES = 16, // jalr targets, power of 2, min 2
+  parameter GHR_BITS    = 0,  // global history for gshare indexing (0 = bimodal), max. log2(BHT_ENTRIES)
+  parameter RAS_DEPTH   = 0   // return address stack entries (0 = no RAS)
+) (
+  input                   clk_i,
+  input                   rst_ni,
+  // lookup (instruction issue)
+  input   [`XPR_LEN-1:0]  instruction_i,     // decompressed instruction
   input   [`XPR_LEN-1:0]  PC_i,
-  input                   c_jal_i,
-  input                   c_j_i,
-  input                   c_beqz_i,
-  input                   c_bnez_i,
-  input   [20:0]          jal_imm_i,
-  input   [20:0]          j_imm_i,
-  input   [12:0]          beqz_imm_i,
-  input   [12:0]          bnez_imm_i,
+  input                   compressed_i,      // instruction_i is a decompressed 16-bit instruction
+  input                   issue_i,           // instruction is issued to DE
+  input                   flush_i,           // pipeline flush, repair the history
   output                  predicted_branch_o,
-  output  [`XPR_LEN-1:0]  branch_target_o
+  output  [`XPR_LEN-1:0]  branch_target_o,
+  // update (resolve point in EX, see airi5c_ctrl.v)
+  input                   update_i,          // branch/jump left EX
+  input                   update_taken_i,
+  input   [`XPR_LEN-1:0]  update_pc_i,
+  input   [`XPR_LEN-1:0]  update_inst_i,
+  input                   update_compressed_i,
+  input   [`XPR_LEN-1:0]  update_target_i    // jalr target
 );
 
-// Simple branch prediction
-// ------------------------
-// Prediction: Forward branches are never taken, backward branches are always taken.
-
 // partially decode instruction_i to find branches/jmps
-wire branch = (instruction_i[6:0] == 7'b1100011);
-wire jump   = (instruction_i[6:0] == 7'b1101111);
-
-// calculate the branch target (register-indirect branches are not predicted!)
-wire        predicted_branch   = (branch & instruction_i[31]) || jump;
-wire        predicted_c_branch = ((c_beqz_i || c_bnez_i) & instruction_i[12]) || c_jal_i || c_j_i;
-wire [12:0] branch_offset      = {instruction_i[31], instruction_i[7], instruction_i[30:25], instruction_i[11:8], 1'b0};
-wire [20:0] jump_offset        = {instruction_i[31], instruction_i[19:12], instruction_i[20], instruction_i[30:21], 1'b0};
-
-wire [31:0] sign_ext_offset = branch   ? {{19{branch_offset[12]}}, branch_offset} :
-                              jump     ? {{11{jump_offset[20]}}, jump_offset} :
-                              c_jal_i  ? {{11{jal_imm_i[20]}}, jal_imm_i} : 
-                              c_j_i    ? {{11{j_imm_i[20]}}, j_imm_i} : 
-                              c_beqz_i ? {{19{beqz_imm_i[12]}}, beqz_imm_i} :
-                              c_bnez_i ? {{19{bnez_imm_i[12]}}, bnez_imm_i} : 32'h0;
-
-assign branch_target_o    = PC_i + sign_ext_offset;
-assign predicted_branch_o = predicted_branch || predicted_c_branch;
+wire branch = (instruction_i[6:0] == `RV32_BRANCH);
+wire jump   = (instruction_i[6:0] == `RV32_JAL);
+wire jalr   = (instruction_i[6:0] == `RV32_JALR);
+
+wire [12:0] branch_offset = {instruction_i[31], instruction_i[7], instruction_i[30:25], instruction_i[11:8], 1'b0};
+wire [20:0] jump_offset   = {instruction_i[31], instruction_i[19:12], instruction_i[20], instruction_i[30:21], 1'b0};
+
+wire [`XPR_LEN-1:0] direct_target = PC_i + (branch ? {{19{branch_offset[12]}}, branch_offset} :
+                                                     {{11{jump_offset[20]}}, jump_offset});
+
+wire update_branch = update_i & (update_inst_i[6:0] == `RV32_BRANCH);
+wire update_jalr   = update_i & (update_inst_i[6:0] == `RV32_JALR);
+
+// prediction of the direction/target without RAS
+wire                dir_predict;
+wire [`XPR_LEN-1:0] dir_target;
+
+generate
+  if (DYNAMIC == 0) begin : static_prediction
+
+    // Simple branch prediction
+    // ------------------------
+    // Prediction: Forward branches are never taken, backward branches are always taken.
+    // Register-indirect jumps are not predicted.
+    assign dir_predict = (branch & instruction_i[31]) || jump;
+    assign dir_target  = direct_target;
+
+  end else begin : dynamic_prediction
+
+    // Dynamic branch prediction
+    // -------------------------
+    // Branches: 2-bit saturating counters, indexed by PC (bimodal) or PC ^ history (gshare).
+    // jal: always taken. jalr: taken if the BTB holds a target for this PC.
+    localparam BHT_IDX = $clog2(BHT_ENTRIES);
+    localparam BTB_IDX = $clog2(BTB_ENTRIES);
+    localparam BTB_TAG = 10;
+
+    reg  [1:0]              bht     [0:BHT_ENTRIES-1];
+    reg                     btb_v   [0:BTB_ENTRIES-1];
+    reg  [BTB_TAG-1:0]      btb_tag [0:BTB_ENTRIES-1];
+    reg  [`XPR_LEN-1:1]     btb_tgt [0:BTB_ENTRIES-1];
+
+    wire [BHT_IDX-1:0]      bht_rd_idx;
+    wire [BHT_IDX-1:0]      bht_wr_idx;
+    wire [BTB_IDX-1:0]      btb_rd_idx = PC_i[BTB_IDX:1];
+    wire [BTB_IDX-1:0]      btb_wr_idx = update_pc_i[BTB_IDX:1];
+    wire                    btb_hit    = btb_v[btb_rd_idx] && (btb_tag[btb_rd_idx] == PC_i[BTB_IDX+BTB_TAG:BTB_IDX+1]);
+    wire                    bht_taken  = bht[bht_rd_idx][1];
+
+    if (GHR_BITS == 0) begin : bimodal
+      assign bht_rd_idx = PC_i[BHT_IDX:1];
+      assign bht_wr_idx = update_pc_i[BHT_IDX:1];
+    end else begin : gshare
+      // ghr_spec is shifted with the prediction at issue, ghr_arch with the
+      // outcome in EX. An instruction that reaches EX was looked up with
+      // ghr_spec == ghr_arch, so both indices match. Flushes restore ghr_spec.
+      reg  [GHR_BITS-1:0] ghr_spec;
+      reg  [GHR_BITS-1:0] ghr_arch;
+      wire [GHR_BITS:0]   ghr_arch_shl = {ghr_arch, update_taken_i};
+      wire [GHR_BITS:0]   ghr_spec_shl = {ghr_spec, bht_taken};
+      wire [GHR_BITS-1:0] ghr_arch_nxt = update_branch ? ghr_arch_shl[GHR_BITS-1:0] : ghr_arch;
+
+      always @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+          ghr_spec <= {GHR_BITS{1'b0}};
+          ghr_arch <= {GHR_BITS{1'b0}};
+        end else begin
+          ghr_arch <= ghr_arch_nxt;
+          if (flush_i)
+            ghr_spec <= ghr_arch_nxt;
+          else if (issue_i & branch)
+            ghr_spec <= ghr_spec_shl[GHR_BITS-1:0];
+        end
+      end
+
+      assign bht_rd_idx = PC_i[BHT_IDX:1]        ^ {{(BHT_IDX-GHR_BITS){1'b0}}, ghr_spec};
+      assign bht_wr_idx = update_pc_i[BHT_IDX:1] ^ {{(BHT_IDX-GHR_BITS){1'b0}}, ghr_arch};
+    end
+
+    integer i;
+
+    // BHT: counters start weakly not-taken
+    always @(posedge clk_i or negedge rst_ni) begin
+      if (~rst_ni) begin
+        for (i = 0; i < BHT_ENTRIES; i = i + 1)
+          bht[i] <= 2'b01;
+      end else if (update_branch) begin
+        if (update_taken_i && (bht[bht_wr_idx] != 2'b11))
+          bht[bht_wr_idx] <= bht[bht_wr_idx] + 2'b01;
+        else if (!update_taken_i && (bht[bht_wr_idx] != 2'b00))
+          bht[bht_wr_idx] <= bht[bht_wr_idx] - 2'b01;
+      end
+    end
+
+    // BTB: direct-mapped, last target of each jalr
+    always @(posedge clk_i or negedge rst_ni) begin
+      if (~rst_ni) begin
+        for (i = 0; i < BTB_ENTRIES; i = i + 1) begin
+          btb_v[i]   <= 1'b0;
+          btb_tag[i] <= {BTB_TAG{1'b0}};
+          btb_tgt[i] <= {(`XPR_LEN-1){1'b0}};
+        end
+      end else if (update_jalr) begin
+        btb_v[btb_wr_idx]   <= 1'b1;
+        btb_tag[btb_wr_idx] <= update_pc_i[BTB_IDX+BTB_TAG:BTB_IDX+1];
+        btb_tgt[btb_wr_idx] <= update_target_i[`XPR_LEN-1:1];
+      end
+    end
+
+    assign dir_predict = (branch & bht_taken) || jump || (jalr & btb_hit);
+    assign dir_target  = jalr ? {btb_tgt[btb_rd_idx], 1'b0} : direct_target;
+
+  end
+endgenerate
+
+generate
+  if (RAS_DEPTH == 0) begin : no_ras
+
+    assign predicted_branch_o = dir_predict;
+    assign branch_target_o    = dir_target;
+
+  end else begin : ras
+
+    // Return address stack
+    // --------------------
+    // Calls (jal/jalr with rd = x1/x5) push the return address, returns
+    // (jalr with rs1 = x1/x5, see table 2.1 of the unprivileged spec) pop it.
+    // The stack is a shift register, entry 0 is the top. Each entry is
+    // {valid, address[31:1]}, a pop shifts in an invalid entry at the bottom,
+    // a push drops the oldest entry.
+    // ras_spec is updated at issue, ras_arch when the call/return leaves EX.
+    // Flushes (mispredictions, traps) restore ras_spec from ras_arch.
+    localparam RAS_W = `XPR_LEN;
+
+    reg  [RAS_DEPTH*RAS_W-1:0] ras_spec;
+    reg  [RAS_DEPTH*RAS_W-1:0] ras_arch;
+    wire [RAS_DEPTH*RAS_W-1:0] ras_spec_nxt;
+    wire [RAS_DEPTH*RAS_W-1:0] ras_arch_nxt;
+
+    // push/pop hints of the issued instruction
+    wire [4:0] rd      = instruction_i[11:7];
+    wire [4:0] rs1     = instruction_i[19:15];
+    wire       rd_lnk  = (rd  == 5'd1) || (rd  == 5'd5);
+    wire       rs1_lnk = (rs1 == 5'd1) || (rs1 == 5'd5);
+    wire       push    = (jump | jalr) & rd_lnk;
+    wire       pop     = jalr & rs1_lnk & ~(rd_lnk & (rd == rs1));
+    wire [`XPR_LEN-1:0] ret_addr = PC_i + (compressed_i ? 32'd2 : 32'd4);
+
+    // same for the resolved instruction
+    wire [4:0] u_rd      = update_inst_i[11:7];
+    wire [4:0] u_rs1     = update_inst_i[19:15];
+    wire       u_rd_lnk  = (u_rd  == 5'd1) || (u_rd  == 5'd5);
+    wire       u_rs1_lnk = (u_rs1 == 5'd1) || (u_rs1 == 5'd5);
+    wire       u_jump    = update_i & ((update_inst_i[6:0] == `RV32_JAL) | (update_inst_i[6:0] == `RV32_JALR));
+    wire       u_push    = u_jump & u_rd_lnk;
+    wire       u_pop     = update_jalr & u_rs1_lnk & ~(u_rd_lnk & (u_rd == u_rs1));
+    wire [`XPR_LEN-1:0] u_ret_addr = update_pc_i + (update_compressed_i ? 32'd2 : 32'd4);
+
+    // pop, then push (pop + push replaces the top entry)
+    wire [RAS_DEPTH*RAS_W-1:0] spec_pop = pop   ? {{RAS_W{1'b0}}, ras_spec} >> RAS_W : ras_spec;
+    wire [RAS_DEPTH*RAS_W-1:0] arch_pop = u_pop ? {{RAS_W{1'b0}}, ras_arch} >> RAS_W : ras_arch;
+    wire [(RAS_DEPTH+1)*RAS_W-1:0] spec_push = {spec_pop, 1'b1, ret_addr[`XPR_LEN-1:1]};
+    wire [(RAS_DEPTH+1)*RAS_W-1:0] arch_push = {arch_pop, 1'b1, u_ret_addr[`XPR_LEN-1:1]};
+
+    assign ras_spec_nxt = push   ? spec_push[RAS_DEPTH*RAS_W-1:0] : spec_pop;
+    assign ras_arch_nxt = u_push ? arch_push[RAS_DEPTH*RAS_W-1:0] : arch_pop;
+
+    always @(posedge clk_i or negedge rst_ni) begin
+      if (~rst_ni) begin
+        ras_spec <= {(RAS_DEPTH*RAS_W){1'b0}};
+        ras_arch <= {(RAS_DEPTH*RAS_W){1'b0}};
+      end else begin
+        ras_arch <= ras_arch_nxt;
+        if (flush_i)
+          ras_spec <= ras_arch_nxt;
+        else if (issue_i)
+          ras_spec <= ras_spec_nxt;
+      end
+    end
+
+    wire ras_hit = pop & ras_spec[RAS_W-1];
+
+    assign predicted_branch_o = ras_hit | dir_predict;
+    assign branch_target_o    = ras_hit ? {ras_spec[RAS_W-2:0], 1'b0} : dir_target;
+
+  end
+endgenerate
 
 endmodule
@@ -17,7 +17,12 @@
 // Last Modified    : Thu 20 Jan 2022 09:00:22 AM CET
 // Version          : 1.0
 // Abstract         : Airi5c core
-// History          : 16.08.22 - improvements for AHB-Lite compatability
+// History          : 17.10.26 - cache misses as performance counter events (HPM_COUNTERS)
+//                    17.10.26 - 64-bit instruction fetch (IFETCH_WIDTH)
+//                    17.10.26 - data cache (DCACHE_WAYS)
+//                    17.10.26 - instruction cache (ICACHE_WAYS)
+//                    17.10.26 - decoupled MUL/DIV operations (PCPI_SCOREBOARD)
+//                    16.08.22 - improvements for AHB-Lite compatability
 //                    07.07.20 - rebranding to AIRI5C
 //                    22.08.19 - moved debug rom to its own module
 //                             - removed legacy hacks and twirks
@@ -102,8 +107,29 @@ module airi5c_core(
   wire                          rst_pipeline_n = rst_ni & ndmreset_o;
 
   // System bus signals (to core) translated from the AHB-Lite signals
+  wire [`HASTI_ADDR_WIDTH-1:0]  imem_haddr_core;
   wire [`HASTI_TRANS_WIDTH-1:0] imem_htrans_core;
+  wire [`HASTI_BURST_WIDTH-1:0] imem_hburst_core;
+  wire [`IFETCH_WIDTH-1:0]      imem_hrdata_core;
+  wire                          imem_hready_core;
+  wire                          imem_invalidate;
+  wire                          icache_hit;   // instruction cache statistics
+  wire                          icache_miss;
+  wire [`HASTI_ADDR_WIDTH-1:0]  dmem_haddr_core;
+  wire                          dmem_hwrite_core;
+  wire [`HASTI_SIZE_WIDTH-1:0]  dmem_hsize_core;
+  wire [`HASTI_BURST_WIDTH-1:0] dmem_hburst_core;
   wire [`HASTI_TRANS_WIDTH-1:0] dmem_htrans_core;
+  wire [`HASTI_BUS_WIDTH-1:0]   dmem_hwdata_core;
+  wire [`HASTI_BUS_WIDTH-1:0]   dmem_hrdata_core;
+  wire                          dmem_hready_core;
+  wire                          dmem_fence;   // fence/fence.i, write back the data cache
+  wire                          dmem_fence_inv; // fence.i: also invalidate the data cache
+  wire                          dmem_fence_done;
+  wire                          dmem_wt;      // debug mode, write through
+  wire                          dcache_hit;   // data cache statistics
+  wire                          dcache_miss;
+  wire                          dcache_wb;
    
   // register file access from debug module
   // the debug module can read/write registers in the 
@@ -147,7 +173,7 @@ module airi5c_core(
   wire                dm_hart0_halted;  // signals the hart has sucessfully entered debug loop
 
 
-  reg [`XPR_LEN-1:0] imem_rdata_muxed;
+  reg [`IFETCH_WIDTH-1:0] imem_rdata_muxed;
   reg [`XPR_LEN-1:0] dmem_rdata_muxed;
   
   // ================================================================================================
@@ -156,16 +182,122 @@ module airi5c_core(
   // IMEM/DMEM bus guards. Only propagate htrans to external bus if 
   // the adress mask matches. This prevents excessive bus toggling during debug.
 
-  wire imem_external = |imem_haddr_o[31:28];
-  assign imem_htrans_o = imem_external ? imem_htrans_core : `HASTI_TRANS_IDLE;
+  wire imem_external = |imem_haddr_core[31:28];
+  wire [`HASTI_TRANS_WIDTH-1:0] imem_htrans_ext = imem_external ? imem_htrans_core : `HASTI_TRANS_IDLE;
 
-  wire dmem_external = |dmem_haddr_o[31:28];
-  assign dmem_htrans_o = dmem_external ? dmem_htrans_core : `HASTI_TRANS_IDLE;
+  wire dmem_external = |dmem_haddr_core[31:28];
+  wire [`HASTI_TRANS_WIDTH-1:0] dmem_htrans_ext = dmem_external ? dmem_htrans_core : `HASTI_TRANS_IDLE;
 
   assign imem_hwdata_o = 0;
 
   // ================================================================================================
 
+
+  // Instruction cache (optional) between the fetcher and the IMEM bus.
+  // Debug ROM fetches are IDLE transfers on the external bus and pass the cache.
+
+  generate
+    if (`ICACHE_WAYS != 0) begin : ic
+
+      airi5c_icache #(
+        .WAYS(`ICACHE_WAYS),
+        .SETS(`ICACHE_SETS),
+        .LINE_WORDS(`ICACHE_LINE_WORDS),
+        .FETCH_WORDS(`IFETCH_WIDTH / 32)
+      ) icache (
+        .clk_i(clk_i),
+        .rst_ni(rst_pipeline_n),
+        .invalidate_i(imem_invalidate),
+
+        .s_haddr_i(imem_haddr_core),
+        .s_htrans_i(imem_htrans_ext),
+        .s_hrdata_o(imem_hrdata_core),
+        .s_hready_o(imem_hready_core),
+
+        .m_haddr_o(imem_haddr_o),
+        .m_htrans_o(imem_htrans_o),
+        .m_hburst_o(imem_hburst_o),
+        .m_hrdata_i(imem_hrdata_i),
+        .m_hready_i(imem_hready_i),
+
+        .hit_o(icache_hit),
+        .miss_o(icache_miss)
+      );
+
+    end else begin : no_ic
+
+      assign imem_haddr_o     = imem_haddr_core;
+      assign imem_htrans_o    = imem_htrans_ext;
+      assign imem_hburst_o    = imem_hburst_core;
+      assign imem_hrdata_core = imem_hrdata_i;
+      assign imem_hready_core = imem_hready_i;
+      assign icache_hit       = 1'b0;
+      assign icache_miss      = 1'b0;
+
+    end
+  endgenerate
+
+  // Data cache (optional) between the pipeline and the DMEM bus.
+  // Debug ROM accesses are IDLE transfers on the external bus and pass the cache.
+
+  generate
+    if (`DCACHE_WAYS != 0) begin : dc
+
+      airi5c_dcache #(
+        .WAYS(`DCACHE_WAYS),
+        .SETS(`DCACHE_SETS),
+        .LINE_WORDS(`DCACHE_LINE_WORDS),
+        .SB_DEPTH(`DCACHE_SB_DEPTH)
+      ) dcache (
+        .clk_i(clk_i),
+        .rst_ni(rst_pipeline_n),
+        .flush_i(dmem_fence),
+        .inv_i(dmem_fence_inv),
+        .flush_done_o(dmem_fence_done),
+        .wt_i(dmem_wt),
+
+        .s_haddr_i(dmem_haddr_core),
+        .s_hwrite_i(dmem_hwrite_core),
+        .s_hsize_i(dmem_hsize_core),
+        .s_htrans_i(dmem_htrans_ext),
+        .s_hwdata_i(dmem_hwdata_core),
+        .s_hrdata_o(dmem_hrdata_core),
+        .s_hready_o(dmem_hready_core),
+
+        .m_haddr_o(dmem_haddr_o),
+        .m_hwrite_o(dmem_hwrite_o),
+        .m_hsize_o(dmem_hsize_o),
+        .m_hburst_o(dmem_hburst_o),
+        .m_htrans_o(dmem_htrans_o),
+        .m_hwdata_o(dmem_hwdata_o),
+        .m_hrdata_i(dmem_hrdata_i),
+        .m_hready_i(dmem_hready_i),
+
+        .hit_o(dcache_hit),
+        .miss_o(dcache_miss),
+        .wb_o(dcache_wb)
+      );
+
+    end else begin : no_dc
+
+      assign dmem_haddr_o     = dmem_haddr_core;
+      assign dmem_hwrite_o    = dmem_hwrite_core;
+      assign dmem_hsize_o     = dmem_hsize_core;
+      assign dmem_hburst_o    = dmem_hburst_core;
+      assign dmem_htrans_o    = dmem_htrans_ext;
+      assign dmem_hwdata_o    = dmem_hwdata_core;
+      assign dmem_hrdata_core = dmem_hrdata_i;
+      assign dmem_hready_core = dmem_hready_i;
+      assign dmem_fence_done  = 1'b1;
+      assign dcache_hit       = 1'b0;
+      assign dcache_miss      = 1'b0;
+      assign dcache_wb        = 1'b0;
+
+    end
+  endgenerate
+
+  // ================================================================================================
+
   wire [4:0] unconnected_1;
 
   airi5c_debug_module debug_module( 
@@ -212,6 +344,8 @@ module airi5c_core(
   // ==============================================================================================
 
   wire  [`XPR_LEN-1:0]        imem_rdata_debug; 
+  wire  [`XPR_LEN-1:0]        imem_rdata_debug_next;
+  wire  [`IFETCH_WIDTH-1:0]   imem_rdata_debug_fetch;
   wire  [`XPR_LEN-1:0]        dmem_rdata_debug;
 
   airi5c_debug_rom debug_rom(
@@ -229,33 +363,43 @@ module airi5c_core(
     .progbuf1_i(dm_hart0_progbuf1),
 
      // Memory interface
-    .rom_imem_addr_i(imem_haddr_o),
+    .rom_imem_addr_i(imem_haddr_core),
     .rom_imem_rdata_o(imem_rdata_debug),
-    .rom_dmem_addr_i(dmem_haddr_o),
-    .rom_dmem_write_i(dmem_hwrite_o),
+    .rom_imem_rdata_next_o(imem_rdata_debug_next),
+    .rom_dmem_addr_i(dmem_haddr_core),
+    .rom_dmem_write_i(dmem_hwrite_core),
     .rom_dmem_rdata_o(dmem_rdata_debug),
-    .rom_dmem_wdata_i(dmem_hwdata_o)
+    .rom_dmem_wdata_i(dmem_hwdata_core)
   );
 
 
+  // 64-bit fetches read two debug ROM words
+  generate
+    if (`IFETCH_WIDTH == 64) begin : rom_fetch_64
+      assign imem_rdata_debug_fetch = {imem_rdata_debug_next, imem_rdata_debug};
+    end else begin : rom_fetch_32
+      assign imem_rdata_debug_fetch = imem_rdata_debug;
+    end
+  endgenerate
+
   // Instruction MUX between debug ROM and regular memory
   reg [31:0] imem_haddr_r;
   always @(posedge clk_i or negedge rst_ni) begin
     if(~rst_ni) begin
       imem_haddr_r <= 0;
     end else begin 
-      if(imem_hready_i & |imem_htrans_core) 
-        imem_haddr_r <= imem_haddr_o;
+      if(imem_hready_core & |imem_htrans_core) 
+        imem_haddr_r <= imem_haddr_core;
     end
   end
 
   always @* begin
     casez(imem_haddr_r)
       `ADDR_DEBUG_ROM   : begin
-                            imem_rdata_muxed = imem_rdata_debug;
+                            imem_rdata_muxed = imem_rdata_debug_fetch;
                           end
       `ADDR_IMEM        : begin 
-                            imem_rdata_muxed = imem_hrdata_i;    
+                            imem_rdata_muxed = imem_hrdata_core;    
                           end
     endcase
   end
@@ -267,8 +411,8 @@ module airi5c_core(
     if(~rst_ni) begin 
       dmem_haddr_r <= 0;
     end else begin
-      if(dmem_hready_i & |dmem_htrans_core) 
-        dmem_haddr_r <= dmem_haddr_o;
+      if(dmem_hready_core & |dmem_htrans_core) 
+        dmem_haddr_r <= dmem_haddr_core;
     end
   end
 
@@ -278,7 +422,7 @@ module airi5c_core(
                           dmem_rdata_muxed = dmem_rdata_debug;
                         end
       `ADDR_IMEM      : begin 
-                          dmem_rdata_muxed = dmem_hrdata_i;
+                          dmem_rdata_muxed = dmem_hrdata_core;
                         end
     endcase
   end
@@ -312,6 +456,14 @@ module airi5c_core(
   wire                 pcpi_use_rd64_mul_div = 1'b0;
   wire                 pcpi_wait_mul_div;
   wire                 pcpi_ready_mul_div;
+`ifdef PCPI_SCOREBOARD
+  wire                 pcpi_accept;
+  wire                 pcpi_issue;
+  wire                 pcpi_late_wr;
+  wire  [`REG_ADDR_WIDTH-1:0] pcpi_late_wa;
+  wire  [`XPR_LEN-1:0] pcpi_late_rd;
+  wire                 pcpi_late_ack;
+`endif
 
   airi5c_mul_div  mul_div(
     .nreset(rst_pipeline_n),
@@ -328,6 +480,15 @@ module airi5c_core(
   //  .pcpi_use_rd64(pcpi_use_rd64_mul_div),
     .pcpi_wait(pcpi_wait_mul_div),
     .pcpi_ready(pcpi_ready_mul_div)
+`ifdef PCPI_SCOREBOARD
+    ,
+    .pcpi_accept(pcpi_accept),
+    .pcpi_issue(pcpi_issue),
+    .pcpi_late_wr(pcpi_late_wr),
+    .pcpi_late_wa(pcpi_late_wa),
+    .pcpi_late_rd(pcpi_late_rd),
+    .pcpi_late_ack(pcpi_late_ack)
+`endif
   );
 `endif
 `endif
@@ -603,27 +764,34 @@ module airi5c_core(
     .debug_haltreq(dm_hart0_haltreq),           
 
     // Instruction memory interface
-    .imem_hready_i(imem_hready_i),
-    .imem_haddr_o(imem_haddr_o),
+    .imem_hready_i(imem_hready_core),
+    .imem_haddr_o(imem_haddr_core),
     .imem_hrdata_i(imem_rdata_muxed),
     .imem_htrans_o(imem_htrans_core),
-    .imem_hburst_o(imem_hburst_o),
+    .imem_hburst_o(imem_hburst_core),
     .imem_hmastlock_o(imem_hmastlock_o),
     .imem_hprot_o(imem_hprot_o),
+    .imem_invalidate_o(imem_invalidate),
+    .icache_miss_i(icache_miss),
     .imem_badmem_e(1'b0),
 
     // Data memory interface
-    .dmem_hready_i(dmem_hready_i),
-    .dmem_hwrite_o(dmem_hwrite_o),
-    .dmem_hsize_o(dmem_hsize_o),
-    .dmem_haddr_o(dmem_haddr_o),
-    .dmem_hwdata_o(dmem_hwdata_o),
+    .dmem_hready_i(dmem_hready_core),
+    .dmem_hwrite_o(dmem_hwrite_core),
+    .dmem_hsize_o(dmem_hsize_core),
+    .dmem_haddr_o(dmem_haddr_core),
+    .dmem_hwdata_o(dmem_hwdata_core),
     .dmem_hrdata_i(dmem_rdata_muxed),
-    .dmem_hburst_o(dmem_hburst_o),
+    .dmem_hburst_o(dmem_hburst_core),
     .dmem_hmastlock_o(dmem_hmastlock_o),
     .dmem_hprot_o(dmem_hprot_o),
     .dmem_htrans_o(dmem_htrans_core),
     .dmem_badmem_e(1'b0),
+    .dmem_fence_o(dmem_fence),
+    .dmem_fence_inv_o(dmem_fence_inv),
+    .dmem_fence_done_i(dmem_fence_done),
+    .dmem_wt_o(dmem_wt),
+    .dcache_miss_i(dcache_miss),
 
     // Debug Module Interface
     .dm_wen(dm_regfile_wen),                          // write enable, active high
@@ -658,6 +826,15 @@ module airi5c_core(
     ,
     .pcpi_ready_mul_div(pcpi_ready_mul_div)
     `endif
+    `ifdef PCPI_SCOREBOARD
+    ,
+    .pcpi_accept(pcpi_accept),
+    .pcpi_issue(pcpi_issue),
+    .pcpi_late_wr(pcpi_late_wr),
+    .pcpi_late_wa(pcpi_late_wa),
+    .pcpi_late_rd(pcpi_late_rd),
+    .pcpi_late_ack(pcpi_late_ack)
+    `endif
   );
 
 endmodule
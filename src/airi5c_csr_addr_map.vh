@@ -397,6 +397,22 @@
 `define CSR_ADDR_MHPMEVENT30    12'h33E
 `define CSR_ADDR_MHPMEVENT31    12'h33F
 
+// mhpmevent selector values (see HPM_COUNTERS in airi5c_arch_options.vh),
+// unsupported values are written as HPM_EVENT_NONE (WARL)
+`define HPM_EVENT_WIDTH         4
+`define HPM_EVENTS              11 // number of event IDs incl. NONE
+`define HPM_EVENT_NONE          0  // counter does not count
+`define HPM_EVENT_LOAD_USE      1  // cycles stalled by a load-use hazard
+`define HPM_EVENT_PCPI          2  // cycles stalled waiting for a PCPI coprocessor (MUL/DIV, ...)
+`define HPM_EVENT_FPU           3  // cycles stalled waiting for the FPU
+`define HPM_EVENT_MISPREDICT    4  // mispredicted branches and jumps
+`define HPM_EVENT_FETCH         5  // fetch bubbles (decode ready, no instruction available)
+`define HPM_EVENT_DMEM_WAIT     6  // cycles stalled waiting for the DMEM bus
+`define HPM_EVENT_IRQ           7  // interrupts taken
+`define HPM_EVENT_C_RETIRED     8  // compressed instructions retired
+`define HPM_EVENT_ICACHE_MISS   9  // instruction cache misses
+`define HPM_EVENT_DCACHE_MISS   10 // data cache misses
+
 // ==========================================================
 // ==      Debug/Trace Registers (shared with Debug Mode)   =
 // ==========================================================
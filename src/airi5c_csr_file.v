@@ -49,6 +49,7 @@ module airi5c_csr_file
   output      [`PRV_WIDTH-1:0]      prv,                  // privilege level, see airi5c_csr_addr_map.vh, e.g. MACHINE / USER / SUPERVISORill 
 
   input                             retire,               // an instruction will retire this cycle
+  input                             retire2,              // a second instruction retires this cycle (DUAL_ISSUE)
   input                             exception,            // Exception received
   input       [`MCAUSE_WIDTH-1:0]   exception_code,       // the part of MCAUSE describing the exception
   input                             exception_int,        // the exception is caused by an interrupt
@@ -59,7 +60,7 @@ module airi5c_csr_file
   input       [`XPR_LEN-1:0]        exception_PC,         // PC of the instruction causing the exception (NOT the instruction after!)
   input       [`XPR_LEN-1:0]        interrupt_PC,         // PC of the instruction that has not been executed because of an Interrupt
 
-  output      [`XPR_LEN-1:0]        handler_PC,           // The handler address set by MTVEC/STVEC/UTVEC and the defined mode. We only support one handler.
+  output      [`XPR_LEN-1:0]        handler_PC,           // The handler address set by MTVEC and the defined mode (direct or vectored for interrupts).
   output      [`XPR_LEN-1:0]        mepc,                 // PC causing the exception (if exception) or pointer to instruction after (if interrupt)
   output      [`XPR_LEN-1:0]        dpc,                  // PC causing the exception (if exception) or pointer to instruction after (if interrupt)
   output                            interrupt_pending,    // at least one interrupt is pending (but may be masked)
@@ -70,7 +71,8 @@ module airi5c_csr_file
   output                            dmode_WB,
 
   input                             stall_WB,             // get info on stalled WB to hold pending interrupts until they can be handled. ASt 08/20
-  input       [`XPR_LEN-1:0]        inst_WB
+  input       [`XPR_LEN-1:0]        inst_WB,
+  input       [`HPM_EVENTS-1:0]     hpm_events            // performance counter events, see airi5c_csr_addr_map.vh
 
 `ifdef ISA_EXT_F
   ,
@@ -84,6 +86,8 @@ module airi5c_csr_file
   input                             NV,
   output      [2:0]                 rounding_mode,
   input                             fpu_reg_dirty,
+  input                             fpu_late_ack,         // result of the pipelined FPU is written (FPU_PIPELINED)
+  input       [4:0]                 fpu_late_flags,       // NV, DZ, OF, UF, NX of that result
   output                            fpu_ena
 `endif
 );
@@ -199,8 +203,16 @@ module airi5c_csr_file
 
   // Trap handler vector calculation
   // -------------------------------
+  // MTVEC.MODE = 0 (direct): all traps jump to BASE
+  // MTVEC.MODE = 1 (vectored): interrupts jump to BASE + 4*cause,
+  //                            exceptions jump to BASE
+  // Cause 3 is a breakpoint or a debug halt request (dinterrupt, taken
+  // as interrupt), both enter the debug handler. The machine software
+  // interrupt (also cause 3) is not supported for that reason.
 
-  assign  handler_PC = (exception_code == `MCAUSE_BREAKPOINT) ? debug_handler_addr : {mtvec[31:2],2'b00};
+  assign  handler_PC = (exception_code == `MCAUSE_BREAKPOINT) ? debug_handler_addr :
+                       (exception_int && mtvec[0])            ? ({mtvec[31:2],2'b00} + {exception_code,2'b00}) :
+                                                                {mtvec[31:2],2'b00};
 
   // =========================
   // = CSR file access ports =
@@ -531,12 +543,15 @@ module airi5c_csr_file
       default:;
       endcase
     end else if (wr_fpu_flags) begin
-      fcsr[0] <= NX;
-      fcsr[1] <= UF;
-      fcsr[2] <= OF;
-      fcsr[3] <= DZ;
-      fcsr[4] <= NV;
-	  end
+      fcsr[0] <= NX || (fpu_late_ack && fpu_late_flags[0]);
+      fcsr[1] <= UF || (fpu_late_ack && fpu_late_flags[1]);
+      fcsr[2] <= OF || (fpu_late_ack && fpu_late_flags[2]);
+      fcsr[3] <= DZ || (fpu_late_ack && fpu_late_flags[3]);
+      fcsr[4] <= NV || (fpu_late_ack && fpu_late_flags[4]);
+	  end else if (fpu_late_ack) begin
+      // late results accrue their flags (fflags/fcsr accesses wait for them, see airi5c_ctrl.v)
+      fcsr[4:0] <= fcsr[4:0] | fpu_late_flags;
+    end
   end
 `else
   assign wr_fpu_flags = 1'b0;
@@ -628,8 +643,15 @@ module airi5c_csr_file
 // == CPU Counters ==
 // ==================
 
+`ifndef ISA_EXT_E
+  localparam HPM_N = `HPM_COUNTERS; // implemented HPM counters
+`else
+  localparam HPM_N = 0;
+`endif
+
   // machine counter inhibit register
   reg [`XPR_LEN-1:0] mcountinhibit;
+  integer            inh;
 
   always @(posedge clk or negedge nreset) begin
     if (~nreset) begin
@@ -638,6 +660,8 @@ module airi5c_csr_file
       if (wen_internal_or_debug && (addr_muxed == `CSR_ADDR_MCOUNTINHIBIT)) begin
         mcountinhibit[0] <= wdata_internal[0]; // CY
         mcountinhibit[2] <= wdata_internal[2]; // IR
+        for (inh = 3; inh < 3 + HPM_N; inh = inh + 1)
+          mcountinhibit[inh] <= wdata_internal[inh]; // HPM3 ..
       end
     end
   end
@@ -657,7 +681,7 @@ module airi5c_csr_file
         end
       end else begin 
         if ((retire) && (~mcountinhibit[2])) begin
-          instret_full <= instret_full + 1;
+          instret_full <= instret_full + (retire2 ? 2 : 1);
         end
       end
     end
@@ -681,6 +705,87 @@ module airi5c_csr_file
   end
 `endif
 
+  // Hardware performance monitor
+  // mhpmcounter3 .. mhpmcounter(3+HPM_COUNTERS-1) count the event selected
+  // by the corresponding mhpmevent register (WARL, unsupported events are
+  // written as HPM_EVENT_NONE). The remaining HPM CSRs (3 .. 31) read as zero.
+  wire    [`HPM_EVENTS-1:0]         hpm_ev;
+  wire                              hpm_rd_hit;
+  wire    [`XPR_LEN-1:0]            hpm_rd_data;
+  wire                              hpm_dm_hit;
+  wire    [`XPR_LEN-1:0]            hpm_dm_data;
+
+  // taken interrupts are counted here, once per trap
+  assign hpm_ev = hpm_events | ((trap_trigger & exception_int & ~dmode) << `HPM_EVENT_IRQ);
+
+  // any of mhpmcounter(h)/hpmcounter(h)/mhpmevent 3 .. 31
+  function hpm_addr;
+    input [`CSR_ADDR_WIDTH-1:0] a;
+    hpm_addr = (a[4:0] > 5'd2) && (((a & 12'hF60) == 12'hB00) ||
+                                   ((a & 12'hF60) == 12'hC00) ||
+                                   ((a & 12'hFE0) == 12'h320));
+  endfunction
+
+  generate
+    if (HPM_N != 0) begin : hpm
+
+      reg     [`HPM_COUNTER_WIDTH-1:0]  counter   [0:HPM_N-1];
+      reg     [`HPM_EVENT_WIDTH-1:0]    event_sel [0:HPM_N-1];
+      reg     [`CSR_COUNTER_WIDTH-1:0]  cnt_wr;
+      integer                           i;
+
+      always @(posedge clk or negedge nreset) begin
+        if (~nreset) begin
+          for (i = 0; i < HPM_N; i = i + 1) begin
+            counter[i]   <= 0;
+            event_sel[i] <= `HPM_EVENT_NONE;
+          end
+        end else begin
+          for (i = 0; i < HPM_N; i = i + 1) begin
+            if (wen_internal_or_debug && (addr_muxed == `CSR_ADDR_MHPMEVENT3 + i))
+              event_sel[i] <= (wdata_internal < `HPM_EVENTS) ? wdata_internal[`HPM_EVENT_WIDTH-1:0] : `HPM_EVENT_NONE;
+
+            cnt_wr = counter[i];
+            if (wen_internal_or_debug && (addr_muxed == `CSR_ADDR_MHPMCOUNTER3 + i)) begin
+              cnt_wr[0+:`XPR_LEN] = wdata_internal;
+              counter[i] <= cnt_wr;
+            end else if (wen_internal_or_debug && (addr_muxed == `CSR_ADDR_MHPMCOUNTER3H + i)) begin
+              cnt_wr[`XPR_LEN+:`XPR_LEN] = wdata_internal;
+              counter[i] <= cnt_wr;
+            end else if (hpm_ev[event_sel[i]] && ~mcountinhibit[3+i]) begin
+              counter[i] <= counter[i] + 1;
+            end
+          end
+        end
+      end
+
+      // read ports (CPU and debug module)
+      wire    [4:0]                     rd_idx  = addr[4:0] - 5'd3;
+      wire    [4:0]                     dm_idx  = dm_csr_addr[4:0] - 5'd3;
+      wire                              rd_impl = hpm_addr(addr) && (rd_idx < HPM_N);
+      wire                              dm_impl = hpm_addr(dm_csr_addr) && (dm_idx < HPM_N);
+      wire    [`CSR_COUNTER_WIDTH-1:0]  rd_cnt  = counter[rd_idx];
+      wire    [`CSR_COUNTER_WIDTH-1:0]  dm_cnt  = counter[dm_idx];
+      wire    [`XPR_LEN-1:0]            rd_sel  = event_sel[rd_idx];
+      wire    [`XPR_LEN-1:0]            dm_sel  = event_sel[dm_idx];
+
+      assign hpm_rd_hit  = hpm_addr(addr);
+      assign hpm_rd_data = !rd_impl                      ? `XPR_LEN'h0 :
+                           (addr[11:8] == 4'h3)          ? rd_sel :
+                           addr[7]                       ? rd_cnt[`XPR_LEN+:`XPR_LEN] : rd_cnt[0+:`XPR_LEN];
+      assign hpm_dm_hit  = hpm_addr(dm_csr_addr);
+      assign hpm_dm_data = !dm_impl                      ? `XPR_LEN'h0 :
+                           (dm_csr_addr[11:8] == 4'h3)   ? dm_sel :
+                           dm_csr_addr[7]                ? dm_cnt[`XPR_LEN+:`XPR_LEN] : dm_cnt[0+:`XPR_LEN];
+
+    end else begin : no_hpm
+      assign hpm_rd_hit  = 1'b0;
+      assign hpm_rd_data = `XPR_LEN'h0;
+      assign hpm_dm_hit  = 1'b0;
+      assign hpm_dm_data = `XPR_LEN'h0;
+    end
+  endgenerate
+
   // handle Write access to CSR registers and internal counters
   always @(posedge clk or negedge nreset) begin
     if (~nreset) begin         
@@ -691,7 +796,7 @@ module airi5c_csr_file
       if (wen_internal_or_debug && ~illegal_region) begin
         case (addr_muxed)              
           `CSR_ADDR_DSCRATCH0 : dscratch0 <= wdata_internal;
-          `CSR_ADDR_MTVEC     : mtvec <= wdata_internal & {{30{1'b1}},2'b0};
+          `CSR_ADDR_MTVEC     : mtvec <= wdata_internal & {{30{1'b1}},2'b01}; // MODE: direct or vectored
           `CSR_ADDR_MSCRATCH  : mscratch <= wdata_internal;
           default : ;
         endcase
@@ -744,7 +849,10 @@ module airi5c_csr_file
         `CSR_ADDR_FCSR      : rdata = {24'h00000, fcsr[7:5], fcsr[4:0]};
       `endif
 
-      default               : defined = 1'b0;
+      default               : begin
+                                rdata   = hpm_rd_data;
+                                defined = hpm_rd_hit;
+                              end
     endcase
   end
 
@@ -789,7 +897,10 @@ module airi5c_csr_file
         `CSR_ADDR_FCSR      : dm_csr_rdata = {24'h00000, fcsr[7:5], fcsr[4:0]};
       `endif
 
-      default               : defined_debug = 1'b0;
+      default               : begin
+                                dm_csr_rdata  = hpm_dm_data;
+                                defined_debug = hpm_dm_hit;
+                              end
     endcase
   end
 
@@ -18,6 +18,13 @@
 // Version          : 1.0
 // Abstract         : control logic for the AIRI5C core pipeline
 // History          : 05.01.20 - First instantiation on GitLab (ASt)
+//                    16.10.26 - check branch prediction, predictor training (ASt)
+//                    17.10.26 - decoupled PCPI operations with register scoreboard (ASt)
+//                    17.10.26 - fence.i refetches the following instructions (ICACHE_WAYS) (ASt)
+//                    17.10.26 - fence/fence.i wait for the data cache write-back (ASt)
+//                    17.10.26 - stall causes for the performance counters (ASt)
+//                    17.10.26 - hazards and write back of the second issue slot (ASt)
+//                    17.10.26 - pipelined FPU operations with float register scoreboard (ASt)
 //
 `timescale 1ns/100ps
 
@@ -27,6 +34,7 @@
 `include "rv32_opcodes.vh"
 `include "airi5c_csr_addr_map.vh"
 `include "airi5c_hasti_constants.vh"
+`include "airi5c_arch_options.vh"
 
 `ifdef ISA_EXT_F
   `include "modules/airi5c_fpu/airi5c_FPU_constants.vh"
@@ -47,14 +55,33 @@ module airi5c_ctrl(
   input                               pcpi_ready,    // coprocessor has taken inst
   input                               pcpi_wait,    // coprocessor is processing inst (0 = propagate result to WB)
   input                               pcpi_wr,        // coprocessor inst will write into reg during WB stage
+`ifdef PCPI_SCOREBOARD
+  input                               pcpi_accept,    // coprocessor can take the inst without stalling EX
+  output wire                         pcpi_issue,     // inst has been issued to the coprocessor, leaves EX
+  input                               pcpi_late_ack,  // coprocessor result is written to the register file
+  input       [`REG_ADDR_WIDTH-1:0]   pcpi_late_wa,
+`endif
   input                               illegal_instruction,
   input [`PRV_WIDTH-1:0]              prv,        // current priviledge level (from airi5c_csr.v)
   input                               predicted_branch_ex_i,
+  input                               jalr_target_hit_i,   // jalr target == PC_DE (prediction was right)
+  output wire                         bp_update_o,         // branch/jump leaves EX, train predictor
+  output wire                         bp_taken_o,
+  output wire                         bp_mispredict_o,
 
   // ALU and branch control signals
   input                               jal_unkilled,
   input                               jalr_unkilled,
   input                               eret_unkilled,
+  input                               fence_i_unkilled,
+  output wire                         fence_i_o,         // fence.i leaves EX, invalidate the instruction cache
+  output wire                         dmem_fence_o,      // fence/fence.i in EX, write back the data cache
+  output wire                         dmem_fence_inv_o,  // fence.i: also invalidate the data cache
+  input                               dmem_fence_done_i, // data cache write-back done
+  output wire                         hpm_load_use_o,    // stall causes for the performance counters (airi5c_csr_file.v)
+  output wire                         hpm_pcpi_o,
+  output wire                         hpm_fpu_o,
+  output wire                         hpm_dmem_wait_o,
   output reg  [`PC_SRC_SEL_WIDTH-1:0] PC_src_sel,        // select source of next inst address (ALU/exception/PC+4/...)
   output                              bypass_rs1,        // signal bypassing for source register a
   output                              bypass_rs2,        // signal bypassing for source register b
@@ -113,7 +140,23 @@ module airi5c_ctrl(
   output wire                         kill_WB,           // kill writeback stage
   output wire [`MCAUSE_WIDTH-1:0]     exception_code_WB, // signal exception cause in WB stage to airi5c_csr_file.v)
   output                              exception_int_WB,
-  output wire                         retire_WB          // signal instruction completion in WB stage to airi5c_csr_file.v)
+  output wire                         retire_WB,         // signal instruction completion in WB stage to airi5c_csr_file.v)
+
+  // second issue slot (DUAL_ISSUE), ALU operations only
+  input [`INST_WIDTH-1:0]             inst2_ex_i,
+  input                               ex_valid2_i,
+  input                               uses2_rs1,
+  input                               uses2_rs2,
+  output                              bypass2_rs1,       // slot 2 source register from WB (slot 1)
+  output                              bypass2_rs2,
+  output                              bypass_rs1_WB2,    // slot 1 source register from WB slot 2
+  output                              bypass_rs2_WB2,
+  output                              bypass_rs3_WB2,
+  output                              bypass2_rs1_WB2,   // slot 2 source register from WB slot 2
+  output                              bypass2_rs2_WB2,
+  output wire                         wr_reg2_WB,        // WB slot 2 shall write to register
+  output reg  [`REG_ADDR_WIDTH-1:0]   reg_to_wr2_WB,
+  output wire                         retire2_WB         // second instruction completes in WB stage
 `ifdef ISA_EXT_P
   ,
   input                               pcpi_ready_mul_div
@@ -130,7 +173,12 @@ module airi5c_ctrl(
   input                               sel_fpu_rd_EX,
   output                              sel_fpu_rd_WB,
   output                              load_fpu,
-  output                              kill_fpu                     
+  output                              kill_fpu,
+  // pipelined FPU (FPU_PIPELINED)
+  input                               fpu_accept,     // airi5c_FPU_pipe can take the inst without stalling EX
+  output wire                         fpu_issue,      // inst has been issued to airi5c_FPU_pipe, leaves EX
+  input                               fpu_late_ack,   // FPU result is written to the float register file
+  input       [`REG_ADDR_WIDTH-1:0]   fpu_late_wa
 `endif
 );
 
@@ -147,13 +195,22 @@ wire [`REG_ADDR_WIDTH-1:0]       rs1_addr = inst_ex_i[19:15];
 wire [`REG_ADDR_WIDTH-1:0]       rs2_addr = inst_ex_i[24:20];
 wire [`REG_ADDR_WIDTH-1:0]       rs3_addr = inst_ex_i[31:27];
 wire [`REG_ADDR_WIDTH-1:0]       reg_to_wr_EX = inst_ex_i[11:7];
+wire [`REG_ADDR_WIDTH-1:0]       rs1_addr2 = inst2_ex_i[19:15];
+wire [`REG_ADDR_WIDTH-1:0]       rs2_addr2 = inst2_ex_i[24:20];
+wire [`REG_ADDR_WIDTH-1:0]       reg_to_wr2_EX = inst2_ex_i[11:7];
 
 
 reg                              branch_taken_unkilled;
 wire                             branch_taken;
+wire                             branch_unkilled;
+wire                             branch_mispredict;
+wire                             jump_mispredict;
 wire                             uses_pcpi;
 wire                             jal;
 wire                             jalr;
+wire                             fence_i;
+wire                             fence_i_redirect;
+wire                             mem_fence_unkilled;
 wire                             wr_reg_EX;
 wire                             new_ex_EX;
 //wire                             ex_EX;
@@ -172,6 +229,7 @@ reg                              dmem_en_WB;
 //reg                              prev_killed_WB;
 reg                              wfi_unkilled_WB;
 reg                              uses_pcpi_WB;
+reg                              wr_reg2_unkilled_WB;
 `ifdef ISA_EXT_F
 reg                              sel_fpu_rd_uk_WB;
 `endif
@@ -192,10 +250,27 @@ wire                             load_use;
 wire                             raw_rs1;
 wire                             raw_rs2;
 wire                             raw_rs3;
+wire                             raw2_rs1;         // slot 2 on WB (slot 1)
+wire                             raw2_rs2;
+wire                             raw_rs1_WB2;      // slot 1 on WB slot 2
+wire                             raw_rs2_WB2;
+wire                             raw_rs3_WB2;
+wire                             raw2_rs1_WB2;     // slot 2 on WB slot 2
+wire                             raw2_rs2_WB2;
 wire                             raw_on_busy_pcpi;
+wire                             sb_hazard;        // register is busy (decoupled PCPI operation)
+`ifndef PCPI_SCOREBOARD
+wire                             pcpi_accept = 1'b0;
+wire                             pcpi_issue  = 1'b0;
+`endif
 wire                             ex_IF;
 
 wire                             fpu_wait_for_WB;
+wire                             fpu_pipe_op;      // FADD/FSUB/FMUL/FMADD/... executed by airi5c_FPU_pipe
+wire                             fsb_hazard;       // float register is busy (pipelined FPU operation)
+`ifndef ISA_EXT_F
+wire                             fpu_issue   = 1'b0;
+`endif
 
 reg                              bubble_in_WB;
 reg                              had_inst;
@@ -280,13 +355,28 @@ always @(posedge clk_i) begin
 end 
 `endif
 assign stall_EX = stall_WB || (dmem_en & ~dmem_hready_i) || 
-  ((load_use || raw_on_busy_pcpi || (uses_pcpi_unkilled && ~pcpi_ready)) &&
+  ((load_use || raw_on_busy_pcpi || sb_hazard || (uses_pcpi_unkilled && ~pcpi_ready && ~pcpi_accept) ||
+    fsb_hazard || (mem_fence_unkilled && ~dmem_fence_done_i)) &&
   !(ex_EX || ex_WB || ex_WB_r || interrupt_taken)) 
 `ifdef ISA_EXT_F
-  || (fpu_op != `FPU_OP_NOP && !fpu_ready && !kill_fpu)
+  || (fpu_op != `FPU_OP_NOP && !fpu_pipe_op && !fpu_ready && !kill_fpu)
+  || (fpu_pipe_op && !fpu_accept && !kill_fpu)
 `endif
   ;
 
+// stall causes, counted by the HPM counters (one cycle may count for several causes)
+assign hpm_load_use_o  = load_use && !(ex_EX || ex_WB || ex_WB_r || interrupt_taken);
+assign hpm_pcpi_o      = (raw_on_busy_pcpi || sb_hazard || (uses_pcpi_unkilled && ~pcpi_ready && ~pcpi_accept)) &&
+                         !(ex_EX || ex_WB || ex_WB_r || interrupt_taken);
+`ifdef ISA_EXT_F
+assign hpm_fpu_o       = (fpu_op != `FPU_OP_NOP && !fpu_pipe_op && !fpu_ready && !kill_fpu) ||
+                         (fpu_pipe_op && !fpu_accept && !kill_fpu) ||
+                         (fsb_hazard && !(ex_EX || ex_WB || ex_WB_r || interrupt_taken));
+`else
+assign hpm_fpu_o       = 1'b0;
+`endif
+assign hpm_dmem_wait_o = ~dmem_hready_i && (dmem_en || dmem_en_WB) && !ex_WB;
+
 assign new_ex_EX = ebreak || ecall || illegal || illegal_csr_access || had_taken_interrupt;
 assign ex_EX = had_ex_EX || new_ex_EX;
    
@@ -295,7 +385,14 @@ assign ex_EX = had_ex_EX || new_ex_EX;
   assign fpu_wait_for_WB = stall_WB || (load_use && !(ex_EX || ex_WB || ex_WB_r || interrupt_taken));
 //  assign kill_fpu = prev_killed_DE || ex_EX || ex_WB || ex_WB_r || interrupt_taken;
   assign kill_fpu = ex_EX || ex_WB || ex_WB_r || interrupt_taken;
-  assign load_fpu = fpu_op != `FPU_OP_NOP && !(fpu_busy || fpu_ready) && !fpu_wait_for_WB;
+  assign load_fpu = fpu_op != `FPU_OP_NOP && !fpu_pipe_op && !(fpu_busy || fpu_ready) && !fpu_wait_for_WB;
+  assign fpu_pipe_op = (`FPU_PIPELINED != 0) &&
+                       (fpu_op == `FPU_OP_ADD  || fpu_op == `FPU_OP_SUB  || fpu_op == `FPU_OP_MUL   ||
+                        fpu_op == `FPU_OP_MADD || fpu_op == `FPU_OP_MSUB || fpu_op == `FPU_OP_NMSUB ||
+                        fpu_op == `FPU_OP_NMADD);
+  assign fpu_issue = fpu_pipe_op && !kill_EX;
+`else
+  assign fpu_pipe_op = 1'b0;
 `endif  
 
 
@@ -331,6 +428,7 @@ assign jal           = jal_unkilled        && !kill_EX;
 assign jalr          = jalr_unkilled       && !kill_EX;
 assign eret          = eret_unkilled       && !kill_EX;
 assign dret          = dret_unkilled       && !kill_EX;
+assign fence_i       = fence_i_unkilled    && !kill_EX;
 assign dmem_en       = dmem_en_unkilled && !ex_WB;//    && !(kill_EX && !stall_WB);
 //assign dmem_wen      = dmem_wen_unkilled;//   && !kill_EX;
 assign dmem_wen      = dmem_wen_unkilled && !ex_WB && ex_ready_i;//   && !(kill_EX & !stall_WB);
@@ -338,13 +436,37 @@ assign wr_reg_EX     = wr_reg_unkilled_EX  && !kill_EX;
 assign wfi_EX        = wfi_unkilled_EX     && !kill_EX;
 assign uses_pcpi     = uses_pcpi_unkilled  && !kill_EX;
 assign csr_cmd       = csr_cmd_unkilled;
-assign pcpi_valid    = pcpi_valid_unkilled && !load_use && uses_pcpi_unkilled;
+assign pcpi_valid    = pcpi_valid_unkilled && !load_use && !sb_hazard && uses_pcpi_unkilled;
 assign dmem_htrans_o = dmem_en ? `HASTI_TRANS_NONSEQ : `HASTI_TRANS_IDLE;
 
 
 /*assign redirect = ~stall_EX &((predicted_branch_EX & ~branch_taken_unkilled & ~jal_unkilled) || (branch_taken_unkilled & ~predicted_branch_EX) || eret_unkilled || dret_unkilled || jalr_unkilled);// || jal_unkilled );*/
 
-assign redirect = ~stall_EX &((predicted_branch_ex_i & ~branch_taken_unkilled & ~jal_unkilled) || (branch_taken_unkilled & ~predicted_branch_ex_i) || eret_unkilled || dret_unkilled || jalr_unkilled || jal_unkilled );
+// branch/jal targets of predicted instructions are exact (calculated from the
+// instruction), jalr targets come from the BTB and have to be checked
+assign branch_unkilled   = (opcode == `RV32_BRANCH);
+assign branch_mispredict = branch_unkilled & (branch_taken_unkilled ^ predicted_branch_ex_i);
+assign jump_mispredict   = (jal_unkilled & ~predicted_branch_ex_i) ||
+                           (jalr_unkilled & ~(predicted_branch_ex_i & jalr_target_hit_i));
+
+// with an instruction cache, fence.i restarts the fetcher behind the
+// fence.i, the prefetch buffer and the cache may hold stale instructions
+// (without it, fence.i does not redirect, as before)
+assign fence_i_redirect = fence_i_unkilled && (`ICACHE_WAYS != 0);
+assign redirect = ~stall_EX & (branch_mispredict || jump_mispredict || eret_unkilled || dret_unkilled || fence_i_redirect);
+assign fence_i_o = fence_i & ~stall_EX;
+
+// fence and fence.i hold EX until the data cache has written back all lines
+// (DMA and instruction fetch see the stores), fence.i also invalidates
+// them (the core sees data written by DMA)
+assign mem_fence_unkilled = (opcode == `RV32_MISC_MEM);
+assign dmem_fence_o       = mem_fence_unkilled && !(ex_EX || ex_WB || ex_WB_r || interrupt_taken);
+assign dmem_fence_inv_o   = fence_i_unkilled;
+
+// predictor training, once per branch/jump
+assign bp_update_o     = ~kill_EX & (branch_unkilled | jal_unkilled | jalr_unkilled);
+assign bp_taken_o      = branch_taken_unkilled | jal_unkilled | jalr_unkilled;
+assign bp_mispredict_o = ~kill_EX & (branch_mispredict | jump_mispredict);
 
 always @(*) begin
   if (ex_WB) begin
@@ -355,8 +477,10 @@ always @(*) begin
     PC_src_sel = `PC_DPC;
   end else if (branch_taken & ~predicted_branch_ex_i) begin
     PC_src_sel = `PC_BRANCH_TARGET;
-  end else if (~branch_taken & predicted_branch_ex_i) begin
+  end else if (branch_unkilled & ~branch_taken & predicted_branch_ex_i) begin
     PC_src_sel = `PC_MISSED_PREDICT;
+  end else if (fence_i && (`ICACHE_WAYS != 0)) begin
+    PC_src_sel = `PC_MISSED_PREDICT; // PC + 4
   end else if (jal) begin
     PC_src_sel = `PC_JAL_TARGET;
   end else if (jalr) begin
@@ -386,11 +510,13 @@ always @(posedge clk_i or negedge rst_ni) begin
     uses_pcpi_WB       <= 0;
     bubble_in_WB       <= 1;
     redirect_WB_r      <= 0;
+    wr_reg2_unkilled_WB <= 0;
+    reg_to_wr2_WB      <= 0;
 `ifdef ISA_EXT_F
     sel_fpu_rd_uk_WB   <= 0;   
 `endif
   end else if (!stall_WB) begin
-    wr_reg_unkilled_WB <= wr_reg_EX || (uses_pcpi && pcpi_wr);
+    wr_reg_unkilled_WB <= (wr_reg_EX && !pcpi_issue && !fpu_issue) || (uses_pcpi && pcpi_wr);
     wb_src_sel_WB      <= wb_src_sel_EX;
     prev_ex_code_WB    <= ex_code_EX;
     prev_ex_int_WB     <= ex_int_EX;
@@ -399,6 +525,8 @@ always @(posedge clk_i or negedge rst_ni) begin
     dmem_en_WB         <= dmem_en;
     wfi_unkilled_WB    <= wfi_EX;
     uses_pcpi_WB       <= uses_pcpi;
+    wr_reg2_unkilled_WB <= ex_valid2_i && !kill_EX;
+    reg_to_wr2_WB      <= reg_to_wr2_EX;
 `ifdef ISA_EXT_F
     sel_fpu_rd_uk_WB   <= sel_fpu_rd_EX && !kill_EX;
 `endif
@@ -446,6 +574,9 @@ assign exception_int_WB = ex_int_WB;
 assign exception_code_WB = ex_code_WB;
 assign wr_reg_WB = wr_reg_unkilled_WB && (!kill_WB || stepmode);
 assign retire_WB = !(kill_WB || killed_WB || bubble_in_WB) || (~dmode_WB && stepmode && ~stall_WB);
+// the second instruction is killed together with the first one, never paired in step mode
+assign wr_reg2_WB = wr_reg2_unkilled_WB && !kill_WB;
+assign retire2_WB = wr_reg2_unkilled_WB && !kill_WB;
 `ifdef ISA_EXT_F
   assign sel_fpu_rd_WB = sel_fpu_rd_uk_WB && (!kill_WB || stepmode);
 `endif
@@ -486,8 +617,109 @@ assign bypass_rs2 = !load_in_WB && raw_rs2;
 `endif
 assign bypass_rs3 = !load_in_WB && raw_rs3;
 
-assign raw_on_busy_pcpi = uses_pcpi_WB && (raw_rs1 || raw_rs2) && !pcpi_ready;
-assign load_use = load_in_WB && (raw_rs1 || raw_rs2 || raw_rs3);
+// second issue slot: slot 2 reads from both WB slots, slot 1 also reads from WB slot 2
+// (ALU results only, always bypassed). The instructions of a pair never write the same
+// register, so at most one WB slot matches.
+`ifdef ISA_EXT_P
+wire   wb_rd64 = pcpi_ready_mul_div_r;
+`else
+wire   wb_rd64 = 1'b0;
+`endif
+`ifdef ISA_EXT_F
+wire   wb_fpu_rd = sel_fpu_rd_uk_WB;
+assign raw_rs1_WB2 = wr_reg2_unkilled_WB && (rs1_addr == reg_to_wr2_WB) && !sel_fpu_rs1_EX && (rs1_addr != 0) && uses_rs1;
+assign raw_rs2_WB2 = wr_reg2_unkilled_WB && (rs2_addr == reg_to_wr2_WB) && !sel_fpu_rs2_EX && (rs2_addr != 0) && uses_rs2;
+assign raw_rs3_WB2 = wr_reg2_unkilled_WB && (rs3_addr == reg_to_wr2_WB) && !sel_fpu_rs3_EX && (rs3_addr != 0) && uses_rs3;
+`else
+wire   wb_fpu_rd = 1'b0;
+assign raw_rs1_WB2 = wr_reg2_unkilled_WB && (rs1_addr == reg_to_wr2_WB) && (rs1_addr != 0) && uses_rs1;
+assign raw_rs2_WB2 = wr_reg2_unkilled_WB && (rs2_addr == reg_to_wr2_WB) && (rs2_addr != 0) && uses_rs2;
+assign raw_rs3_WB2 = wr_reg2_unkilled_WB && (rs3_addr == reg_to_wr2_WB) && (rs3_addr != 0) && uses_rs3;
+`endif
+assign raw2_rs1 = wr_reg_unkilled_WB && !wb_fpu_rd && ((rs1_addr2 == reg_to_wr_WB) || (wb_rd64 && (rs1_addr2 == (reg_to_wr_WB+1)))) &&
+                  (rs1_addr2 != 0) && uses2_rs1;
+assign raw2_rs2 = wr_reg_unkilled_WB && !wb_fpu_rd && ((rs2_addr2 == reg_to_wr_WB) || (wb_rd64 && (rs2_addr2 == (reg_to_wr_WB+1)))) &&
+                  (rs2_addr2 != 0) && uses2_rs2;
+assign raw2_rs1_WB2 = wr_reg2_unkilled_WB && (rs1_addr2 == reg_to_wr2_WB) && (rs1_addr2 != 0) && uses2_rs1;
+assign raw2_rs2_WB2 = wr_reg2_unkilled_WB && (rs2_addr2 == reg_to_wr2_WB) && (rs2_addr2 != 0) && uses2_rs2;
+
+assign bypass2_rs1     = !load_in_WB && raw2_rs1;
+assign bypass2_rs2     = !load_in_WB && raw2_rs2;
+assign bypass_rs1_WB2  = raw_rs1_WB2;
+assign bypass_rs2_WB2  = raw_rs2_WB2;
+assign bypass_rs3_WB2  = raw_rs3_WB2;
+assign bypass2_rs1_WB2 = raw2_rs1_WB2;
+assign bypass2_rs2_WB2 = raw2_rs2_WB2;
+
+assign raw_on_busy_pcpi = uses_pcpi_WB && (raw_rs1 || raw_rs2 || raw2_rs1 || raw2_rs2) && !pcpi_ready;
+
+// Decoupled PCPI operations: an accepted instruction leaves EX without writing
+// back, the coprocessor writes its result later (when the WB stage does not use
+// the register file write port, see airi5c_pipeline.v). Until then its
+// destination register is busy: instructions that read it (RAW) or write it (WAW,
+// results must not be overwritten by an older late result) wait in EX.
+`ifdef PCPI_SCOREBOARD
+reg  [31:0] sb_busy_r;
+wire [31:0] sb_set = {31'h0, pcpi_issue}    << reg_to_wr_EX;
+wire [31:0] sb_clr = {31'h0, pcpi_late_ack} << pcpi_late_wa;
+
+always @(posedge clk_i or negedge rst_ni) begin
+  if (~rst_ni) begin
+    sb_busy_r <= 32'h0;
+  end else begin
+    sb_busy_r <= ((sb_busy_r & ~sb_clr) | sb_set) & 32'hfffffffe; // x0 is never busy
+  end
+end
+
+assign pcpi_issue = uses_pcpi_unkilled && pcpi_valid && pcpi_accept && !kill_EX;
+
+`ifdef ISA_EXT_F
+assign sb_hazard = (uses_rs1 && !sel_fpu_rs1_EX && sb_busy_r[rs1_addr]) ||
+                   (uses_rs2 && !sel_fpu_rs2_EX && sb_busy_r[rs2_addr]) ||
+                   (uses_rs3 && !sel_fpu_rs3_EX && sb_busy_r[rs3_addr]) ||
+                   (wr_reg_unkilled_EX && !sel_fpu_rd_EX && sb_busy_r[reg_to_wr_EX]) ||
+                   (uses2_rs1 && sb_busy_r[rs1_addr2]) || (uses2_rs2 && sb_busy_r[rs2_addr2]) ||
+                   (ex_valid2_i && sb_busy_r[reg_to_wr2_EX]);
+`else
+assign sb_hazard = (uses_rs1 && sb_busy_r[rs1_addr]) ||
+                   (uses_rs2 && sb_busy_r[rs2_addr]) ||
+                   (uses_rs3 && sb_busy_r[rs3_addr]) ||
+                   (wr_reg_unkilled_EX && sb_busy_r[reg_to_wr_EX]) ||
+                   (uses2_rs1 && sb_busy_r[rs1_addr2]) || (uses2_rs2 && sb_busy_r[rs2_addr2]) ||
+                   (ex_valid2_i && sb_busy_r[reg_to_wr2_EX]);
+`endif
+`else
+assign sb_hazard = 1'b0;
+`endif
+
+// Pipelined FPU operations (FPU_PIPELINED) leave EX in the same way, the result
+// is written to the float register file later. Busy float registers are tracked
+// separately. fflags/fcsr accesses wait until all results (and their exception
+// flags) have been written.
+`ifdef ISA_EXT_F
+reg  [31:0] fsb_busy_r;
+wire [31:0] fsb_set = {31'h0, fpu_issue}    << reg_to_wr_EX;
+wire [31:0] fsb_clr = {31'h0, fpu_late_ack} << fpu_late_wa;
+wire        fcsr_access = (csr_cmd_unkilled != `CSR_IDLE) &&
+                          ((inst_ex_i[31:20] == `CSR_ADDR_FFLAGS) || (inst_ex_i[31:20] == `CSR_ADDR_FCSR));
+
+always @(posedge clk_i or negedge rst_ni) begin
+  if (~rst_ni) begin
+    fsb_busy_r <= 32'h0;
+  end else begin
+    fsb_busy_r <= (fsb_busy_r & ~fsb_clr) | fsb_set;
+  end
+end
+
+assign fsb_hazard = (uses_rs1 && sel_fpu_rs1_EX && fsb_busy_r[rs1_addr]) ||
+                    (uses_rs2 && sel_fpu_rs2_EX && fsb_busy_r[rs2_addr]) ||
+                    (uses_rs3 && sel_fpu_rs3_EX && fsb_busy_r[rs3_addr]) ||
+                    (wr_reg_unkilled_EX && sel_fpu_rd_EX && fsb_busy_r[reg_to_wr_EX]) ||
+                    (fcsr_access && |fsb_busy_r);
+`else
+assign fsb_hazard = 1'b0;
+`endif
+assign load_use = load_in_WB && (raw_rs1 || raw_rs2 || raw_rs3 || raw2_rs1 || raw2_rs2);
 
 
 endmodule
@@ -0,0 +1,592 @@
+//
+// Copyright 2022 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File             : airi5c_dcache.v
+// Author           : A. Stanitzki
+// Creation Date    : 17.10.26
+// Version          : 1.0
+// Abstract         : Write-back data cache with store buffer for the DMEM bus
+// Notes            : Direct-mapped (WAYS = 1) or 2-way set associative
+//                    (WAYS = 2, LRU replacement), write-allocate.
+//                    The core side is an AHB-Lite slave:
+//                    - load hit: completes in the first data phase cycle
+//                    - store hit: written in the first data phase cycle
+//                    - store miss, uncached store: queued in the store
+//                      buffer (SB_DEPTH entries), the core continues
+//                    - load miss: the line is refilled (after writing back
+//                      a dirty victim), then the load is retried
+//                    - uncached load: waits for the empty store buffer,
+//                      then a single transfer is made
+//                    Loads to a word that is still in the store buffer
+//                    wait until it has been written. The window selected
+//                    by UNCACHED_MASK/UNCACHED_BASE (peripherals) is never
+//                    cached. Line refills and write-backs use INCR4/INCR8
+//                    bursts (LINE_WORDS = 4/8).
+//                    flush_i (fence, fence.i) drains the store buffer, then
+//                    writes back all dirty lines. With inv_i (fence.i,
+//                    held with flush_i) all lines are also invalidated, a
+//                    plain fence keeps them valid. flush_done_o is set
+//                    when done and stays set while flush_i is held.
+//                    wt_i (debug mode) turns stores into write-through
+//                    stores without allocation, so memory written by the
+//                    debugger survives a reset.
+//                    hit_o/miss_o/wb_o flag lookups and write-backs,
+//                    hit_count/miss_count/wb_count sum them up.
+//                    Bus errors are not reported: the memory side has no
+//                    hresp input, like the DMEM port of the core without
+//                    the cache (dmem_hresp_i is not used). An error
+//                    response during a refill or write-back is treated
+//                    as a completed transfer, the refilled line then
+//                    holds the returned data.
+//
+
+`include "airi5c_hasti_constants.vh"
+
+module airi5c_dcache #(
+  parameter WAYS          = 1,            // 1 = direct-mapped, 2 = 2-way set associative
+  parameter SETS          = 64,           // power of 2
+  parameter LINE_WORDS    = 4,            // 4 or 8 (bursts INCR4/INCR8)
+  parameter SB_DEPTH      = 4,            // store buffer entries, power of 2
+  parameter UNCACHED_BASE = 32'hC0000000, // uncached window (peripherals)
+  parameter UNCACHED_MASK = 32'hC0000000
+) (
+  input                                clk_i,
+  input                                rst_ni,
+  input                                flush_i,
+  input                                inv_i,
+  output                               flush_done_o,
+  input                                wt_i,
+
+  // core side
+  input       [`HASTI_ADDR_WIDTH-1:0]  s_haddr_i,
+  input                                s_hwrite_i,
+  input       [`HASTI_SIZE_WIDTH-1:0]  s_hsize_i,
+  input       [`HASTI_TRANS_WIDTH-1:0] s_htrans_i,
+  input       [`HASTI_BUS_WIDTH-1:0]   s_hwdata_i,
+  output      [`HASTI_BUS_WIDTH-1:0]   s_hrdata_o,
+  output                               s_hready_o,
+
+  // memory side
+  output      [`HASTI_ADDR_WIDTH-1:0]  m_haddr_o,
+  output                               m_hwrite_o,
+  output      [`HASTI_SIZE_WIDTH-1:0]  m_hsize_o,
+  output      [`HASTI_BURST_WIDTH-1:0] m_hburst_o,
+  output      [`HASTI_TRANS_WIDTH-1:0] m_htrans_o,
+  output      [`HASTI_BUS_WIDTH-1:0]   m_hwdata_o,
+  input       [`HASTI_BUS_WIDTH-1:0]   m_hrdata_i,
+  input                                m_hready_i,
+
+  // statistics
+  output                               hit_o,
+  output                               miss_o,
+  output                               wb_o
+);
+
+localparam WORD_BITS = $clog2(LINE_WORDS);
+localparam SET_BITS  = $clog2(SETS);
+localparam TAG_LSB   = 2 + WORD_BITS + SET_BITS;
+localparam TAG_BITS  = `HASTI_ADDR_WIDTH - TAG_LSB;
+localparam IDX_BITS  = SET_BITS + WORD_BITS;
+localparam SB_BITS   = (SB_DEPTH > 1) ? $clog2(SB_DEPTH) : 1;
+localparam FL_BITS   = $clog2(WAYS*SETS);
+
+// engine states
+localparam E_IDLE     = 3'd0,
+           E_WB_READ  = 3'd1, // read the dirty victim line into the write-back buffer
+           E_WB_WRITE = 3'd2, // write-back burst
+           E_REFILL   = 3'd3, // refill burst
+           E_SINGLE   = 3'd4, // single uncached transfer
+           E_FLUSH    = 3'd5; // walk all lines (fence)
+
+integer i;
+
+
+// --------------------------------------------------------------------------------------------
+// Core data phase
+// --------------------------------------------------------------------------------------------
+
+reg                          req_v_r;
+reg  [`HASTI_ADDR_WIDTH-1:0] req_addr_r;
+reg                          req_write_r;
+reg  [`HASTI_SIZE_WIDTH-1:0] req_size_r;
+
+wire [WORD_BITS-1:0]         req_word = req_addr_r[WORD_BITS+1:2];
+wire [SET_BITS-1:0]          req_set  = req_addr_r[TAG_LSB-1:WORD_BITS+2];
+wire [TAG_BITS-1:0]          req_tag  = req_addr_r[`HASTI_ADDR_WIDTH-1:TAG_LSB];
+wire                         req_unc  = ((req_addr_r & UNCACHED_MASK) == UNCACHED_BASE);
+
+// byte lanes of a store
+function [3:0] byte_en;
+  input [`HASTI_SIZE_WIDTH-1:0] size;
+  input [1:0]                   offset;
+  begin
+    case (size)
+      `HASTI_SIZE_BYTE     : byte_en = 4'b0001 << offset;
+      `HASTI_SIZE_HALFWORD : byte_en = 4'b0011 << offset;
+      default              : byte_en = 4'b1111;
+    endcase
+  end
+endfunction
+
+
+// --------------------------------------------------------------------------------------------
+// Tags, valid/dirty bits (registers), data array (synchronous read, byte write enables)
+// --------------------------------------------------------------------------------------------
+
+reg  [TAG_BITS-1:0]          tag_r   [0:WAYS*SETS-1];
+reg  [WAYS*SETS-1:0]         valid_r;
+reg  [WAYS*SETS-1:0]         dirty_r;
+reg  [SETS-1:0]              lru_r;     // 2-way: way to replace next
+
+// data array port
+wire [IDX_BITS-1:0]          rd_idx;
+reg                          rd_fresh_r; // data_q belongs to the request and is up to date
+reg                          wr_en;
+reg                          wr_way;
+reg  [IDX_BITS-1:0]          wr_idx;
+reg  [3:0]                   wr_be;
+reg  [`HASTI_BUS_WIDTH-1:0]  wr_data;
+wire [`HASTI_BUS_WIDTH*WAYS-1:0] way_rdata;
+
+genvar w, b;
+generate
+  for (w = 0; w < WAYS; w = w + 1) begin : way
+    for (b = 0; b < 4; b = b + 1) begin : lane
+
+      reg [7:0] data_ram [0:SETS*LINE_WORDS-1];
+      reg [7:0] data_q;
+
+      always @(posedge clk_i) begin
+        data_q <= data_ram[rd_idx];
+        if (wr_en && (wr_way == w) && wr_be[b])
+          data_ram[wr_idx] <= wr_data[8*b +: 8];
+      end
+
+      assign way_rdata[`HASTI_BUS_WIDTH*w + 8*b +: 8] = data_q;
+
+    end
+  end
+endgenerate
+
+
+// --------------------------------------------------------------------------------------------
+// Store buffer
+// --------------------------------------------------------------------------------------------
+
+reg  [`HASTI_ADDR_WIDTH-1:0] sb_addr  [0:SB_DEPTH-1];
+reg  [`HASTI_SIZE_WIDTH-1:0] sb_size  [0:SB_DEPTH-1];
+reg  [`HASTI_BUS_WIDTH-1:0]  sb_data  [0:SB_DEPTH-1];
+reg  [SB_DEPTH-1:0]          sb_wt;     // write-through entry (debug mode)
+reg  [SB_DEPTH-1:0]          sb_v;
+reg  [SB_BITS-1:0]           sb_wr_r;
+reg  [SB_BITS-1:0]           sb_rd_r;
+
+wire                         sb_empty = ~|sb_v;
+wire                         sb_full  = &sb_v;
+wire [`HASTI_ADDR_WIDTH-1:0] sb_head  = sb_addr[sb_rd_r];
+wire [SET_BITS-1:0]          sb_set   = sb_head[TAG_LSB-1:WORD_BITS+2];
+wire [TAG_BITS-1:0]          sb_tag   = sb_head[`HASTI_ADDR_WIDTH-1:TAG_LSB];
+wire                         sb_unc   = ((sb_head & UNCACHED_MASK) == UNCACHED_BASE);
+wire                         sb_head_wt = sb_wt[sb_rd_r];
+
+// the requested word is still in the store buffer
+reg                          sb_match;
+always @(*) begin
+  sb_match = 1'b0;
+  for (i = 0; i < SB_DEPTH; i = i + 1)
+    if (sb_v[i] && (sb_addr[i][`HASTI_ADDR_WIDTH-1:2] == req_addr_r[`HASTI_ADDR_WIDTH-1:2]))
+      sb_match = 1'b1;
+end
+
+
+// --------------------------------------------------------------------------------------------
+// Lookup (request and store buffer head)
+// --------------------------------------------------------------------------------------------
+
+reg                          req_hit, req_hit_way;
+reg                          sb_hit,  sb_hit_way;
+always @(*) begin
+  req_hit = 1'b0; req_hit_way = 1'b0;
+  sb_hit  = 1'b0; sb_hit_way  = 1'b0;
+  for (i = 0; i < WAYS; i = i + 1) begin
+    if (valid_r[i*SETS + req_set] && (tag_r[i*SETS + req_set] == req_tag)) begin
+      req_hit     = !req_unc;
+      req_hit_way = i;
+    end
+    if (valid_r[i*SETS + sb_set] && (tag_r[i*SETS + sb_set] == sb_tag)) begin
+      sb_hit      = !sb_unc;
+      sb_hit_way  = i;
+    end
+  end
+end
+
+
+// --------------------------------------------------------------------------------------------
+// Engine: store buffer drain, line refill/write-back, uncached transfers, flush
+// --------------------------------------------------------------------------------------------
+
+reg  [2:0]                   eng_state_r;
+reg  [SET_BITS-1:0]          eng_set_r;
+reg  [TAG_BITS-1:0]          eng_tag_r;
+reg                          eng_way_r;
+reg  [TAG_BITS-1:0]          wb_tag_r;
+reg                          flushing_r;
+reg                          fl_inv_r;   // the flush also invalidates (fence.i)
+wire                         fl_inv_pend = inv_i && !fl_inv_r;
+reg  [FL_BITS:0]             fl_idx_r;
+reg                          flush_done_r;
+
+reg  [WORD_BITS:0]           beat_a_r;   // address phases issued (bursts) / read requests (E_WB_READ)
+reg  [WORD_BITS:0]           beat_d_r;   // data phases completed
+reg                          d_pend_r;
+reg  [`HASTI_BUS_WIDTH-1:0]  wb_buf [0:LINE_WORDS-1];
+
+reg                          sgl_write_r;
+reg  [`HASTI_ADDR_WIDTH-1:0] sgl_addr_r;
+reg  [`HASTI_SIZE_WIDTH-1:0] sgl_size_r;
+reg  [`HASTI_BUS_WIDTH-1:0]  sgl_data_r;
+reg                          unc_done_r;
+reg  [`HASTI_BUS_WIDTH-1:0]  unc_rdata_r;
+
+reg                          ld_alloc_r; // the pending load caused a refill (counted as miss)
+reg                          sb_alloc_r; // the store buffer head caused a refill
+
+wire                         burst      = (eng_state_r == E_WB_WRITE) || (eng_state_r == E_REFILL);
+wire                         addr_phase = (burst && !beat_a_r[WORD_BITS]) ||
+                                          ((eng_state_r == E_SINGLE) && !d_pend_r && (beat_d_r == 0));
+wire                         beat_done  = d_pend_r && m_hready_i;
+wire                         last_beat  = beat_done && (beat_d_r == LINE_WORDS-1);
+wire                         wb_reading = (eng_state_r == E_WB_READ) && !beat_a_r[WORD_BITS];
+
+// jobs, started from E_IDLE
+wire                         job_ld_miss = req_v_r && !req_write_r && !req_unc && !sb_match && !req_hit;
+wire                         job_ld_unc  = req_v_r && !req_write_r && req_unc && sb_empty && !unc_done_r;
+wire                         job_sb      = !sb_empty;
+wire                         job_flush   = flush_i && !flush_done_r && sb_empty && !req_v_r;
+
+// store buffer head hits (written in E_IDLE), uncached/write-through heads go to E_SINGLE
+wire                         sb_go       = (eng_state_r == E_IDLE) && !job_ld_miss && !job_ld_unc && job_sb;
+wire                         sb_wr_hit   = sb_go && sb_hit;
+wire                         sb_single   = sb_go && (sb_unc || sb_head_wt);
+wire                         sb_pop      = (sb_go && sb_hit && !sb_head_wt) ||
+                                           ((eng_state_r == E_SINGLE) && sgl_write_r && beat_done);
+
+// line allocation (load miss or store buffer head miss)
+wire                         alloc_ld    = (eng_state_r == E_IDLE) && job_ld_miss;
+wire                         alloc_sb    = sb_go && !sb_hit && !sb_unc && !sb_head_wt;
+wire                         alloc       = alloc_ld || alloc_sb;
+wire [SET_BITS-1:0]          alloc_set   = alloc_ld ? req_set : sb_set;
+wire [TAG_BITS-1:0]          alloc_tag   = alloc_ld ? req_tag : sb_tag;
+reg                          victim_way;
+
+always @(*) begin
+  victim_way = 1'b0;
+  if (WAYS == 2) begin
+    if (!valid_r[alloc_set])
+      victim_way = 1'b0;
+    else if (!valid_r[(WAYS-1)*SETS + alloc_set])
+      victim_way = 1'b1;
+    else
+      victim_way = lru_r[alloc_set];
+  end
+end
+
+wire [FL_BITS:0]             victim_idx  = victim_way*SETS + alloc_set;
+wire                         fl_line     = (eng_state_r == E_FLUSH) && (fl_idx_r != WAYS*SETS);
+wire                         fl_dirty    = fl_line && valid_r[fl_idx_r] && dirty_r[fl_idx_r];
+
+
+// --------------------------------------------------------------------------------------------
+// Core side handshake
+// --------------------------------------------------------------------------------------------
+
+// a store hit is written directly unless the engine uses the write port or
+// allocates a line (the victim may be the line hit), all other stores are
+// queued (behind older stores to the same word). Stores during the flush
+// walk (fence killed by an interrupt) are queued as well, so the walk
+// cannot clear the dirty bit of a line written in the same cycle.
+wire eng_wr      = ((eng_state_r == E_REFILL) && beat_done) || sb_wr_hit || alloc;
+wire st_direct   = req_hit && !sb_match && !wt_i && (eng_state_r != E_FLUSH);
+wire st_done     = st_direct ? !eng_wr : !sb_full;
+wire ld_hit_done = req_hit && !sb_match && rd_fresh_r;
+wire ld_done     = req_unc ? unc_done_r : ld_hit_done;
+
+assign s_hready_o = !req_v_r || (req_write_r ? st_done : ld_done);
+assign s_hrdata_o = req_unc ? unc_rdata_r : way_rdata[`HASTI_BUS_WIDTH*req_hit_way +: `HASTI_BUS_WIDTH];
+
+wire   st_push    = req_v_r && req_write_r && !st_direct && !sb_full;
+wire   st_write   = req_v_r && req_write_r && st_direct && !eng_wr;
+
+// data array read: next address phase, the stalled request or the write-back line
+assign rd_idx = wb_reading ? {eng_set_r, beat_a_r[WORD_BITS-1:0]} :
+                s_hready_o ? s_haddr_i[TAG_LSB-1:2] : req_addr_r[TAG_LSB-1:2];
+
+always @(*) begin
+  wr_en   = 1'b0;
+  wr_way  = 1'b0;
+  wr_idx  = {IDX_BITS{1'b0}};
+  wr_be   = 4'b0000;
+  wr_data = `HASTI_BUS_WIDTH'h0;
+  if ((eng_state_r == E_REFILL) && beat_done) begin
+    wr_en   = 1'b1;
+    wr_way  = eng_way_r;
+    wr_idx  = {eng_set_r, beat_d_r[WORD_BITS-1:0]};
+    wr_be   = 4'b1111;
+    wr_data = m_hrdata_i;
+  end else if (sb_wr_hit) begin
+    wr_en   = 1'b1;
+    wr_way  = sb_hit_way;
+    wr_idx  = sb_head[TAG_LSB-1:2];
+    wr_be   = byte_en(sb_size[sb_rd_r], sb_head[1:0]);
+    wr_data = sb_data[sb_rd_r];
+  end else if (st_write) begin
+    wr_en   = 1'b1;
+    wr_way  = req_hit_way;
+    wr_idx  = req_addr_r[TAG_LSB-1:2];
+    wr_be   = byte_en(req_size_r, req_addr_r[1:0]);
+    wr_data = s_hwdata_i;
+  end
+end
+
+
+// --------------------------------------------------------------------------------------------
+// Sequential logic
+// --------------------------------------------------------------------------------------------
+
+reg [31:0] hit_count;
+reg [31:0] miss_count;
+reg [31:0] wb_count;
+
+assign hit_o  = (st_write && !req_unc) || (ld_hit_done && !ld_alloc_r && !req_write_r && req_v_r) ||
+                (sb_wr_hit && !sb_alloc_r && !sb_head_wt);
+assign miss_o = alloc;
+assign wb_o   = (alloc && valid_r[victim_idx] && dirty_r[victim_idx]) || (fl_dirty);
+
+always @(posedge clk_i or negedge rst_ni) begin
+  if (~rst_ni) begin
+    req_v_r      <= 1'b0;
+    req_addr_r   <= `HASTI_ADDR_WIDTH'h0;
+    req_write_r  <= 1'b0;
+    req_size_r   <= `HASTI_SIZE_WORD;
+    rd_fresh_r   <= 1'b0;
+    valid_r      <= {(WAYS*SETS){1'b0}};
+    dirty_r      <= {(WAYS*SETS){1'b0}};
+    lru_r        <= {SETS{1'b0}};
+    sb_v         <= {SB_DEPTH{1'b0}};
+    sb_wt        <= {SB_DEPTH{1'b0}};
+    sb_wr_r      <= {SB_BITS{1'b0}};
+    sb_rd_r      <= {SB_BITS{1'b0}};
+    eng_state_r  <= E_IDLE;
+    eng_set_r    <= {SET_BITS{1'b0}};
+    eng_tag_r    <= {TAG_BITS{1'b0}};
+    eng_way_r    <= 1'b0;
+    wb_tag_r     <= {TAG_BITS{1'b0}};
+    flushing_r   <= 1'b0;
+    fl_inv_r     <= 1'b0;
+    fl_idx_r     <= {(FL_BITS+1){1'b0}};
+    flush_done_r <= 1'b0;
+    beat_a_r     <= {(WORD_BITS+1){1'b0}};
+    beat_d_r     <= {(WORD_BITS+1){1'b0}};
+    d_pend_r     <= 1'b0;
+    sgl_write_r  <= 1'b0;
+    sgl_addr_r   <= `HASTI_ADDR_WIDTH'h0;
+    sgl_size_r   <= `HASTI_SIZE_WORD;
+    sgl_data_r   <= `HASTI_BUS_WIDTH'h0;
+    unc_done_r   <= 1'b0;
+    unc_rdata_r  <= `HASTI_BUS_WIDTH'h0;
+    ld_alloc_r   <= 1'b0;
+    sb_alloc_r   <= 1'b0;
+    hit_count    <= 32'h0;
+    miss_count   <= 32'h0;
+    wb_count     <= 32'h0;
+  end else begin
+
+    if (hit_o)  hit_count  <= hit_count + 32'h1;
+    if (miss_o) miss_count <= miss_count + 32'h1;
+    if (wb_o)   wb_count   <= wb_count + 32'h1;
+
+    // core data phase
+    rd_fresh_r <= !wb_reading && !(wr_en && (wr_idx == rd_idx));
+    if (s_hready_o) begin
+      req_v_r     <= s_htrans_i[1];
+      req_addr_r  <= s_haddr_i;
+      req_write_r <= s_hwrite_i;
+      req_size_r  <= s_hsize_i;
+      unc_done_r  <= 1'b0;
+      ld_alloc_r  <= 1'b0;
+    end
+
+    if (st_write) begin
+      dirty_r[req_hit_way*SETS + req_set] <= 1'b1;
+      if (WAYS == 2)
+        lru_r[req_set] <= ~req_hit_way;
+    end
+    if (ld_hit_done && req_v_r && !req_write_r && (WAYS == 2))
+      lru_r[req_set] <= ~req_hit_way;
+
+    // store buffer
+    if (st_push) begin
+      sb_addr[sb_wr_r] <= req_addr_r;
+      sb_size[sb_wr_r] <= req_size_r;
+      sb_data[sb_wr_r] <= s_hwdata_i;
+      sb_wt[sb_wr_r]   <= wt_i;
+      sb_v[sb_wr_r]    <= 1'b1;
+      sb_wr_r          <= sb_wr_r + 1'b1;
+    end
+    if (sb_pop) begin
+      sb_v[sb_rd_r]    <= 1'b0;
+      sb_rd_r          <= sb_rd_r + 1'b1;
+      sb_alloc_r       <= 1'b0;
+    end
+    if (sb_wr_hit && !sb_head_wt)
+      dirty_r[sb_hit_way*SETS + sb_set] <= 1'b1;
+
+    // fence handshake, a fence.i right behind a fence still invalidates
+    if (!flush_i || fl_inv_pend)
+      flush_done_r <= 1'b0;
+
+    case (eng_state_r)
+
+      E_IDLE: begin
+        beat_a_r <= {(WORD_BITS+1){1'b0}};
+        beat_d_r <= {(WORD_BITS+1){1'b0}};
+        d_pend_r <= 1'b0;
+        if (alloc) begin
+          eng_set_r  <= alloc_set;
+          eng_tag_r  <= alloc_tag;
+          eng_way_r  <= victim_way;
+          wb_tag_r   <= tag_r[victim_idx];
+          flushing_r <= 1'b0;
+          valid_r[victim_idx] <= 1'b0;
+          dirty_r[victim_idx] <= 1'b0;
+          ld_alloc_r <= alloc_ld;
+          sb_alloc_r <= alloc_sb;
+          eng_state_r <= (valid_r[victim_idx] && dirty_r[victim_idx]) ? E_WB_READ : E_REFILL;
+        end else if (job_ld_unc) begin
+          sgl_write_r <= 1'b0;
+          sgl_addr_r  <= req_addr_r;
+          sgl_size_r  <= req_size_r;
+          eng_state_r <= E_SINGLE;
+        end else if (sb_single) begin
+          sgl_write_r <= 1'b1;
+          sgl_addr_r  <= sb_head;
+          sgl_size_r  <= sb_size[sb_rd_r];
+          sgl_data_r  <= sb_data[sb_rd_r];
+          eng_state_r <= E_SINGLE;
+        end else if (!job_sb && job_flush) begin
+          fl_idx_r    <= {(FL_BITS+1){1'b0}};
+          fl_inv_r    <= inv_i;
+          eng_state_r <= E_FLUSH;
+        end
+      end
+
+      E_FLUSH: begin
+        if (!fl_line) begin
+          flush_done_r <= 1'b1;
+          eng_state_r  <= E_IDLE;
+        end else begin
+          if (fl_inv_r)
+            valid_r[fl_idx_r] <= 1'b0;
+          dirty_r[fl_idx_r] <= 1'b0;
+          if (fl_dirty) begin
+            eng_set_r   <= fl_idx_r[SET_BITS-1:0];
+            eng_way_r   <= (WAYS == 2) ? fl_idx_r[SET_BITS] : 1'b0;
+            wb_tag_r    <= tag_r[fl_idx_r];
+            flushing_r  <= 1'b1;
+            eng_state_r <= E_WB_READ;
+          end
+          fl_idx_r <= fl_idx_r + 1'b1;
+        end
+      end
+
+      E_WB_READ: begin
+        // one cycle read latency: word k is in way_rdata while word k+1 is read
+        if (!beat_a_r[WORD_BITS])
+          beat_a_r <= beat_a_r + 1'b1;
+        if (beat_a_r != 0)
+          wb_buf[beat_a_r - 1'b1] <= way_rdata[`HASTI_BUS_WIDTH*eng_way_r +: `HASTI_BUS_WIDTH];
+        if (beat_a_r[WORD_BITS]) begin
+          beat_a_r    <= {(WORD_BITS+1){1'b0}};
+          eng_state_r <= E_WB_WRITE;
+        end
+      end
+
+      E_WB_WRITE, E_REFILL: begin
+        if (m_hready_i) begin
+          d_pend_r <= addr_phase;
+          if (addr_phase)
+            beat_a_r <= beat_a_r + 1'b1;
+        end
+        if (beat_done)
+          beat_d_r <= beat_d_r + 1'b1;
+        if (last_beat) begin
+          beat_a_r <= {(WORD_BITS+1){1'b0}};
+          beat_d_r <= {(WORD_BITS+1){1'b0}};
+          if (eng_state_r == E_WB_WRITE) begin
+            eng_state_r <= flushing_r ? E_FLUSH : E_REFILL;
+          end else begin
+            tag_r[eng_way_r*SETS + eng_set_r]   <= eng_tag_r;
+            valid_r[eng_way_r*SETS + eng_set_r] <= 1'b1;
+            if (WAYS == 2)
+              lru_r[eng_set_r] <= ~eng_way_r;
+            eng_state_r <= E_IDLE;
+          end
+        end
+      end
+
+      E_SINGLE: begin
+        if (m_hready_i) begin
+          d_pend_r <= addr_phase;
+          if (addr_phase)
+            beat_d_r <= 1'b1; // address phase done
+        end
+        if (beat_done) begin
+          if (!sgl_write_r) begin
+            unc_rdata_r <= m_hrdata_i;
+            unc_done_r  <= 1'b1;
+          end
+          eng_state_r <= E_IDLE;
+        end
+      end
+
+      default: begin
+        eng_state_r <= E_IDLE;
+      end
+
+    endcase
+  end
+end
+
+assign flush_done_o = flush_done_r && !fl_inv_pend;
+
+
+// --------------------------------------------------------------------------------------------
+// Memory side
+// --------------------------------------------------------------------------------------------
+
+wire [WORD_BITS-1:0] beat_a_word = beat_a_r[WORD_BITS-1:0];
+wire [WORD_BITS-1:0] beat_d_word = beat_d_r[WORD_BITS-1:0];
+
+assign m_haddr_o  = (eng_state_r == E_SINGLE)   ? sgl_addr_r :
+                    (eng_state_r == E_WB_WRITE) ? {wb_tag_r,  eng_set_r, beat_a_word, 2'b00} :
+                                                  {eng_tag_r, eng_set_r, beat_a_word, 2'b00};
+assign m_hwrite_o = (eng_state_r == E_SINGLE) ? sgl_write_r : (eng_state_r == E_WB_WRITE);
+assign m_hsize_o  = (eng_state_r == E_SINGLE) ? sgl_size_r : `HASTI_SIZE_WORD;
+assign m_hburst_o = !burst            ? `HASTI_BURST_SINGLE :
+                    (LINE_WORDS == 8) ? `HASTI_BURST_INCR8 : `HASTI_BURST_INCR4;
+assign m_htrans_o = !addr_phase                  ? `HASTI_TRANS_IDLE   :
+                    (burst && (beat_a_r != 0))   ? `HASTI_TRANS_SEQ    : `HASTI_TRANS_NONSEQ;
+assign m_hwdata_o = (eng_state_r == E_SINGLE) ? sgl_data_r : wb_buf[beat_d_word];
+
+
+endmodule
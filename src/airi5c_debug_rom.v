@@ -28,6 +28,7 @@ module airi5c_debug_rom (
 
   input   [`XPR_LEN-1:0] rom_imem_addr_i,
   output  [`XPR_LEN-1:0] rom_imem_rdata_o,
+  output  [`XPR_LEN-1:0] rom_imem_rdata_next_o, // following word (64-bit fetch)
 
   input   [`XPR_LEN-1:0] progbuf0_i,
   input   [`XPR_LEN-1:0] progbuf1_i,
@@ -58,7 +59,7 @@ reg [`XPR_LEN-1:0] rom_imem_addr_r;
 // and restoring the register when leaving debug.
 reg [`XPR_LEN-1:0]  hwstack;
 
-wire  [`XPR_LEN-1:0]  dm_debugrom [82:0]; // debug ROM has 256 lines 
+wire  [`XPR_LEN-1:0]  dm_debugrom [83:0]; // debug ROM has 256 lines 
 assign  dm_debugrom[0]  = `XPR_LEN'h15C02023;  // 0001 0101 1100 0000 0010 0000 0010 0011, 14802023, sw x28, 0x140(x0) -- push x28 to debug mem space 0x140
 assign  dm_debugrom[1]  = `XPR_LEN'h14402E03;  // 0001 0100 0100 0000 0010 1110 0000 0011, 14402E03, lw x28, 0x144(x0) -- read hart0_status from @0x144
 
@@ -91,8 +92,10 @@ assign  dm_debugrom[80] = hwstack;
 assign  dm_debugrom[81] = {28'h0000000,resume_req_i&~resume_ack_o,postexec,halted_o,resume_ack_o};  
 
 assign  dm_debugrom[82] = `XPR_LEN'h0;
+assign  dm_debugrom[83] = `XPR_LEN'h0;
 
 assign rom_imem_rdata_o = dm_debugrom[rom_imem_addr_r[9:0] >> 2];
+assign rom_imem_rdata_next_o = dm_debugrom[(rom_imem_addr_r[9:0] >> 2) + 1];
 assign rom_dmem_rdata_o = dm_debugrom[rom_dmem_addr_r[9:0] >> 2];
 
 
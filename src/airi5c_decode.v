@@ -17,6 +17,7 @@
 // Last Modified    : Wed Mar  8 10:12:38 CET 2023
 // Version          : 1.0
 // Abstract         : Instruction decoder 
+// History          : 17.10.26 - second issue slot for ALU operations (DUAL_ISSUE) (ASt)
 //
 `timescale 1ns/100ps
 
@@ -24,6 +25,7 @@
 `include "airi5c_ctrl_constants.vh"
 `include "airi5c_alu_ops.vh"
 `include "rv32_opcodes.vh"
+`include "airi5c_arch_options.vh"
 
 `ifdef ISA_EXT_F
   `include "modules/airi5c_fpu/airi5c_FPU_constants.vh"
@@ -81,7 +83,25 @@ module airi5c_decode(
   output                         ebreak_o,
   output                         ecall_o,
   output                         dret_unkilled_o,
-  output                         wfi_unkilled_o
+  output                         wfi_unkilled_o,
+
+  // second issue slot (DUAL_ISSUE)
+  input                          dual_issue_en_i,  // pairing allowed (not in step mode)
+  input  [`XPR_LEN-1:0]          pc_if2_i,
+  input  [`XPR_LEN-1:0]          inst_if2_i,
+  input                          if_valid2_i,
+  input                          imem_compressed_if2_i,
+  output                         take2_o,          // issue both IF instructions
+  output [`XPR_LEN-1:0]          pc_de2_o,
+  output [`XPR_LEN-1:0]          inst_de2_o,
+  output                         de_valid2_o,
+  output                         imem_compressed_de2_o,
+  output [`ALU_OP_WIDTH-1:0]     alu_op2_o,
+  output [`SRC_A_SEL_WIDTH-1:0]  src_a_sel2_o,
+  output [`SRC_B_SEL_WIDTH-1:0]  src_b_sel2_o,
+  output [`IMM_TYPE_WIDTH-1:0]   imm_type2_o,
+  output                         uses2_rs1_o,
+  output                         uses2_rs2_o
   
   `ifdef ISA_EXT_F
   ,
@@ -174,6 +194,109 @@ module airi5c_decode(
 
   wire alu_op_invalid = ~((funct7 == 0) || (funct7 == 7'h20)) || (opcode == 7'h77);
 
+
+  // ==============================================================
+  // Second issue slot (DUAL_ISSUE)
+  // The instruction behind the one in IF is issued together with it
+  // if both can execute in parallel: the first one is an ALU operation
+  // or an integer load/store, the second one is an ALU operation that
+  // neither reads nor writes the destination register of the first one.
+  // Both instructions leave EX together, so the second one never needs
+  // a bypass from the first one.
+
+  function alu_inst;
+    input [`XPR_LEN-1:0] inst;
+    begin
+      alu_inst = (inst[6:0] == `RV32_OP_IMM) || (inst[6:0] == `RV32_LUI) || (inst[6:0] == `RV32_AUIPC) ||
+                 ((inst[6:0] == `RV32_OP) && ((inst[31:25] == 7'h00) || (inst[31:25] == 7'h20)));
+    end
+  endfunction
+
+  wire       pair_ls0   = (inst_if_i[6:0] == `RV32_LOAD) || (inst_if_i[6:0] == `RV32_STORE);
+  wire       pair_wr0   = (inst_if_i[6:0] != `RV32_STORE) && (inst_if_i[11:7] != 0);
+  wire       pair_rs1_1 = (inst_if2_i[6:0] == `RV32_OP_IMM) || (inst_if2_i[6:0] == `RV32_OP);
+  wire       pair_rs2_1 = (inst_if2_i[6:0] == `RV32_OP);
+  wire       pair_dep   = pair_wr0 && ((pair_rs1_1 && (inst_if2_i[19:15] == inst_if_i[11:7])) ||
+                                       (pair_rs2_1 && (inst_if2_i[24:20] == inst_if_i[11:7])) ||
+                                       (inst_if2_i[11:7] == inst_if_i[11:7]));
+
+  assign take2_o = (`DUAL_ISSUE != 0) && dual_issue_en_i && !inject_ebreak_i && if_valid_i && if_valid2_i &&
+                   !predicted_branch_if_i && (alu_inst(inst_if_i) || pair_ls0) && alu_inst(inst_if2_i) && !pair_dep;
+
+  reg  [`XPR_LEN-1:0]         inst_de2_r;            assign inst_de2_o = inst_de2_r;
+  reg  [`XPR_LEN-1:0]         pc_de2_r;              assign pc_de2_o = pc_de2_r;
+  reg                         de_valid2_r;           assign de_valid2_o = de_valid2_r;
+  reg                         imem_compressed_de2_r; assign imem_compressed_de2_o = imem_compressed_de2_r;
+
+  always @(posedge clk_i or negedge rst_ni) begin
+    if(~rst_ni) begin
+      inst_de2_r            <= `RV_NOP;
+      pc_de2_r              <= `START_HANDLER;
+      de_valid2_r           <= 1'b0;
+      imem_compressed_de2_r <= 1'b0;
+    end else begin
+      if(killed_de_i) begin
+        inst_de2_r            <= `RV_NOP;
+        de_valid2_r           <= 1'b0;
+        imem_compressed_de2_r <= 1'b0;
+      end else if(ex_ready_i) begin
+        inst_de2_r            <= take2_o ? inst_if2_i : `RV_NOP;
+        pc_de2_r              <= pc_if2_i;
+        de_valid2_r           <= take2_o;
+        imem_compressed_de2_r <= take2_o & imem_compressed_if2_i;
+      end
+    end
+  end
+
+  wire [6:0]                  opcode2 = inst_de2_r[6:0];
+  wire [2:0]                  funct3_2 = inst_de2_r[14:12];
+  wire                        funct7_2_sub = inst_de2_r[30];
+
+  reg  [`ALU_OP_WIDTH-1:0]    alu_op2_r;             assign alu_op2_o = alu_op2_r;
+  reg  [`SRC_A_SEL_WIDTH-1:0] src_a_sel2_r;          assign src_a_sel2_o = src_a_sel2_r;
+  reg  [`SRC_B_SEL_WIDTH-1:0] src_b_sel2_r;          assign src_b_sel2_o = src_b_sel2_r;
+  reg  [`IMM_TYPE_WIDTH-1:0]  imm_type2_r;           assign imm_type2_o = imm_type2_r;
+  reg                         uses2_rs1_r;           assign uses2_rs1_o = uses2_rs1_r;
+  reg                         uses2_rs2_r;           assign uses2_rs2_o = uses2_rs2_r;
+
+  always @(*) begin
+    alu_op2_r    = `ALU_OP_ADD;
+    src_a_sel2_r = `SRC_A_RS1;
+    src_b_sel2_r = `SRC_B_IMM;
+    imm_type2_r  = `IMM_I;
+    uses2_rs1_r  = 1'b1;
+    uses2_rs2_r  = 1'b0;
+    case (funct3_2)
+      `RV32_FUNCT3_ADD_SUB : alu_op2_r = ((opcode2 == `RV32_OP) && funct7_2_sub) ? `ALU_OP_SUB : `ALU_OP_ADD;
+      `RV32_FUNCT3_SLL     : alu_op2_r = `ALU_OP_SLL;
+      `RV32_FUNCT3_SLT     : alu_op2_r = `ALU_OP_SLT;
+      `RV32_FUNCT3_SLTU    : alu_op2_r = `ALU_OP_SLTU;
+      `RV32_FUNCT3_XOR     : alu_op2_r = `ALU_OP_XOR;
+      `RV32_FUNCT3_SRA_SRL : alu_op2_r = funct7_2_sub ? `ALU_OP_SRA : `ALU_OP_SRL;
+      `RV32_FUNCT3_OR      : alu_op2_r = `ALU_OP_OR;
+      `RV32_FUNCT3_AND     : alu_op2_r = `ALU_OP_AND;
+    endcase
+    case (opcode2)
+      `RV32_OP : begin
+        src_b_sel2_r = `SRC_B_RS2;
+        uses2_rs2_r  = 1'b1;
+      end
+      `RV32_AUIPC : begin
+        alu_op2_r    = `ALU_OP_ADD;
+        src_a_sel2_r = `SRC_A_PC;
+        uses2_rs1_r  = 1'b0;
+        imm_type2_r  = `IMM_U;
+      end
+      `RV32_LUI : begin
+        alu_op2_r    = `ALU_OP_ADD;
+        src_a_sel2_r = `SRC_A_ZERO;
+        uses2_rs1_r  = 1'b0;
+        imm_type2_r  = `IMM_U;
+      end
+      default : ; // OP-IMM (or NOP)
+    endcase
+  end
+
   always @(posedge clk_i or negedge rst_ni) begin
     if(~rst_ni) begin
       inst_de_r            <= `RV_NOP;
@@ -28,6 +28,10 @@
 //                    03.08.22 - Notice inserted, Fixing SlowRedirect functionality
 //                    15.12.22 - [nolting] complete rework; general concept/code adapted from github.com/stnolting/neorv32/blob/main/rtl/core/neorv32_cpu_control.vhd
 //                    22.12.22 - [nolting] add option for SAFETY version of instruction prefetch buffer; minor cleanups
+//                    16.10.26 - [stanitzki] branch prediction at instruction issue (see BRANCH_PREDICTION)
+//                    17.10.26 - [stanitzki] return address stack
+//                    17.10.26 - [stanitzki] 64-bit fetch (IFETCH_WIDTH = 64), no refetch after a full IPB
+//                    17.10.26 - [stanitzki] second instruction for dual issue (DUAL_ISSUE)
 //
 
 `include "rv32_opcodes.vh"
@@ -51,10 +55,23 @@ module airi5c_fetch (
   output wire                          compressed_o,
   output wire                          predicted_branch_if_o,
   output wire [2:0]                    error_in_if_o,
+// second instruction (DUAL_ISSUE)
+  output wire [`XPR_LEN-1:0]           pc_if2_o,
+  output wire [`XPR_LEN-1:0]           inst_if2_o,
+  output wire                          if_valid2_o,   // valid and both instructions without fetch error
+  output wire                          compressed2_o,
+  input                                de_take2_i,    // DE issues both instructions
+// branch predictor training (resolve point in EX)
+  input                                bp_update_i,
+  input                                bp_taken_i,
+  input       [`XPR_LEN-1:0]           bp_pc_i,
+  input       [`XPR_LEN-1:0]           bp_inst_i,
+  input                                bp_compressed_i,
+  input       [`XPR_LEN-1:0]           bp_target_i,
 // memory-side I/O  
   input                                imem_hready_i, 
   output wire [`XPR_LEN-1:0]           imem_haddr_o,
-  input       [`XPR_LEN-1:0]           imem_hrdata_i,
+  input       [`IFETCH_WIDTH-1:0]      imem_hrdata_i,
   input                                imem_badmem_i,
   output wire [`HASTI_TRANS_WIDTH-1:0] imem_htrans_o,
   output wire [`HASTI_BURST_WIDTH-1:0] imem_hburst_o,
@@ -66,18 +83,18 @@ module airi5c_fetch (
 );
 
 // instruction fetcher
-reg [`XPR_LEN-1:0] imem_haddr_r;
-reg [`XPR_LEN-1:0] last_addr_r;
-reg                if_unaligned_r;
-reg [1:0]          state_r, state_prev_r;
+localparam FETCH_BYTES = `IFETCH_WIDTH / 8;  // 4 or 8
+localparam IPB_WR      = `IFETCH_WIDTH / 32; // half-words per IPB FIFO and fetch
+localparam IPB_W       = 3 + (`XPR_LEN/2);   // IPB entry: error/status bits + half-word
 
-localparam StRestart = 2'h0,
-           StFetch   = 2'h1,
-           StWait    = 2'h2;
+wire [`XPR_LEN-1:0] last_addr; // address of the last fetch (ECC region check)
 
 // Instruction prefetch buffer
 wire                    ipb_clear;
-wire [1:0]              ipb_we;
+wire [IPB_WR-1:0]       ipb_we_lo;
+wire [IPB_WR-1:0]       ipb_we_hi;
+wire [IPB_WR*IPB_W-1:0] ipb_wdata_lo;
+wire [IPB_WR*IPB_W-1:0] ipb_wdata_hi;
 wire [1:0]              ipb_re;
 wire [1:0]              ipb_hfull;
 wire [1:0]              ipb_free;
@@ -88,6 +105,12 @@ wire [(`XPR_LEN/2)-1:0] ipb_cmd_lo;
 wire [(`XPR_LEN/2)-1:0] ipb_cmd_hi;
 wire [2:0]              ipb_err_lo;
 wire [2:0]              ipb_err_hi;
+wire [1:0]              ipb_re2;
+wire [1:0]              ipb_avail2;
+wire [(`XPR_LEN/2)-1:0] ipb_cmd2_lo;
+wire [(`XPR_LEN/2)-1:0] ipb_cmd2_hi;
+wire [2:0]              ipb_err2_lo;
+wire [2:0]              ipb_err2_hi;
 
 // instruction issue
 reg                issue_unaligned_r;
@@ -98,6 +121,13 @@ reg [`XPR_LEN-1:0] issue_pc_r;
 reg [1:0]          issue_valid;
 reg [2:0]          issue_err;
 
+// second instruction (DUAL_ISSUE)
+wire               issue2_valid;
+wire               issue2_take;
+wire [2:0]         issue2_hw;  // half-words of both instructions
+wire [`XPR_LEN-1:0] issue2_cmd;
+wire               issue2_c;
+
 // decompression
 wire [15:0]         c_input;
 wire                c_valid;
@@ -107,85 +137,176 @@ wire                c_beqz, c_bnez;
 wire [20:0]         c_jal_imm, c_j_imm;
 wire [12:0]         c_beqz_imm, c_bnez_imm;
 
+// branch prediction
+wire                predict;
+wire [`XPR_LEN-1:0] predict_target;
+wire                predict_redirect;
+wire                restart;
+wire [`XPR_LEN-1:0] restart_pc;
+
 
 // --------------------------------------------------------------------------------------------
 // Instruction fetcher
-// -> always fetching full 32-bit words from 32-bit-aligned addresses
 // --------------------------------------------------------------------------------------------
 
-always @(posedge clk_i or negedge rst_ni) begin
-  if (~rst_ni) begin
-    state_r        <= StRestart;
-    state_prev_r   <= StRestart;
-    if_unaligned_r <= 1'b0;
-    imem_haddr_r   <= 32'h80000000;
-    last_addr_r    <= 32'h80000000;
-  end else begin
-    state_prev_r <= state_r;
-
-    case (state_r)
-
-      // start new fetch
-      StRestart: begin
-        last_addr_r <= imem_haddr_r;
-        if (kill_if_i) begin // restart fetcher
-          imem_haddr_r   <= {pc_pif_i[`XPR_LEN-1:2], 2'b00}; // always align to 32-bit-boundary
-          if_unaligned_r <= pc_pif_i[1]; // set if starting unaligned
-          state_r        <= StRestart;
-        end else if (imem_hready_i) begin
-          imem_haddr_r   <= imem_haddr_r + 32'h4;
-          state_r        <= StFetch;       
-        end
-      end
+genvar i_gv;
+generate
+  if (`IFETCH_WIDTH == 32) begin : fetch32
+
+    // -> always fetching full 32-bit words from 32-bit-aligned addresses
+
+    reg [`XPR_LEN-1:0] imem_haddr_r;
+    reg [`XPR_LEN-1:0] last_addr_r;
+    reg                if_unaligned_r;
+    reg [1:0]          state_r, state_prev_r;
+
+    localparam StRestart = 2'h0,
+               StFetch   = 2'h1,
+               StWait    = 2'h2;
+
+    always @(posedge clk_i or negedge rst_ni) begin
+      if (~rst_ni) begin
+        state_r        <= StRestart;
+        state_prev_r   <= StRestart;
+        if_unaligned_r <= 1'b0;
+        imem_haddr_r   <= 32'h80000000;
+        last_addr_r    <= 32'h80000000;
+      end else begin
+        state_prev_r <= state_r;
+
+        case (state_r)
+
+          // start new fetch
+          StRestart: begin
+            last_addr_r <= imem_haddr_r;
+            if (restart) begin // restart fetcher
+              imem_haddr_r   <= {restart_pc[`XPR_LEN-1:2], 2'b00}; // always align to 32-bit-boundary
+              if_unaligned_r <= restart_pc[1]; // set if starting unaligned
+              state_r        <= StRestart;
+            end else if (imem_hready_i) begin
+              imem_haddr_r   <= imem_haddr_r + 32'h4;
+              state_r        <= StFetch;
+            end
+          end
 
-      // continuous fetch in progress
-      StFetch: begin
-        if (kill_if_i) begin // restart fetcher
-          imem_haddr_r   <= {pc_pif_i[`XPR_LEN-1:2], 2'b00}; // always align to 32-bit-boundary
-          if_unaligned_r <= pc_pif_i[1]; // set if starting unaligned
-          state_r        <= StRestart;
-        end else begin
-          if_unaligned_r <= 1'b0; // set if we are aligned again
-          last_addr_r    <= imem_haddr_r;
-          if (ipb_hfull_global) begin // no free IPB entry -> wait
-            state_r      <= StWait;
-          end else if (imem_hready_i) begin 
-            // memory completes access and we have space left in the IPB
-            // -> store the new fetched instruction to IPB
-            // -> increment address for next access
-            imem_haddr_r <= imem_haddr_r + 32'h4;
-            state_r      <= StFetch;
+          // continuous fetch in progress
+          StFetch: begin
+            if (restart) begin // restart fetcher
+              imem_haddr_r   <= {restart_pc[`XPR_LEN-1:2], 2'b00}; // always align to 32-bit-boundary
+              if_unaligned_r <= restart_pc[1]; // set if starting unaligned
+              state_r        <= StRestart;
+            end else begin
+              if_unaligned_r <= 1'b0; // set if we are aligned again
+              last_addr_r    <= imem_haddr_r;
+              if (ipb_hfull_global) begin // no free IPB entry -> wait
+                state_r      <= StWait;
+              end else if (imem_hready_i) begin
+                // memory completes access and we have space left in the IPB
+                // -> store the new fetched instruction to IPB
+                // -> increment address for next access
+                imem_haddr_r <= imem_haddr_r + 32'h4;
+                state_r      <= StFetch;
+              end
+            end
           end
-        end
+
+          // wait for free space in IPB
+          StWait: begin
+            if (restart) begin // restart fetcher
+              imem_haddr_r   <= {restart_pc[`XPR_LEN-1:2], 2'b00}; // always align to 32-bit-boundary
+              if_unaligned_r <= restart_pc[1]; // set if starting unaligned
+              state_r        <= StRestart;
+            end else if (~ipb_hfull_global) begin
+              imem_haddr_r   <= last_addr_r; // resume from last-accessed address
+              state_r        <= StFetch;
+            end
+          end
+
+        endcase
+      end
+    end
+
+    // bus request
+    assign imem_htrans_o = `HASTI_TRANS_NONSEQ;
+    assign imem_haddr_o  = imem_haddr_r;
+    assign last_addr     = last_addr_r;
+
+    // write to IPB
+    assign ipb_we_lo[0] = ((state_r == StFetch) && (state_prev_r != StWait) && (~if_unaligned_r) && (imem_hready_i) && (ipb_free_global)) ? 1'b1 : 1'b0; // instruction half-word LOW
+    assign ipb_we_hi[0] = ((state_r == StFetch) && (state_prev_r != StWait) &&                      (imem_hready_i) && (ipb_free_global)) ? 1'b1 : 1'b0; // instruction half-word HIGH
+    assign ipb_wdata_lo = {2'b00, imem_badmem_i, imem_hrdata_i[(`XPR_LEN/2)-1:0]};
+    assign ipb_wdata_hi = {2'b00, imem_badmem_i, imem_hrdata_i[`XPR_LEN-1:`XPR_LEN/2]};
+
+  end else begin : fetch64
+
+    // -> always fetching 64-bit double words from 64-bit-aligned addresses
+    // -> a fetch is only requested while the IPB is less than half full, so the fetch that is
+    //    still in its data phase always finds space (no refetch, needs IPB_DEPTH >= 8)
+
+    reg [`XPR_LEN-1:0] imem_haddr_r;
+    reg [`XPR_LEN-1:0] last_addr_r;
+    reg [1:0]          if_skip_r;  // half-words to skip in the fetch at imem_haddr_r (unaligned restart)
+    reg                dph_v_r;    // data phase of a fetch in progress
+    reg [1:0]          dph_skip_r; // half-words to skip in that data phase
+    wire               fetch_req;
+    wire               fetch_done;
+
+    // the IPB FIFOs drop a two-entry write without room (see airi5c_prebuf_fifo.v)
+    if (`IPB_DEPTH < 8) begin : ipb_depth_check
+      initial begin
+        $display("ERROR: airi5c_fetch: IFETCH_WIDTH = 64 requires IPB_DEPTH >= 8 (IPB_DEPTH = %0d)", `IPB_DEPTH);
+        $finish;
       end
+    end
 
-      // wait for free space in IPB
-      StWait: begin
-        if (kill_if_i) begin // restart fetcher
-          imem_haddr_r   <= {pc_pif_i[`XPR_LEN-1:2], 2'b00}; // always align to 32-bit-boundary
-          if_unaligned_r <= pc_pif_i[1]; // set if starting unaligned
-          state_r        <= StRestart;
-        end else if (~ipb_hfull_global) begin
-          imem_haddr_r   <= last_addr_r; // resume from last-accessed address
-          state_r        <= StFetch;
+    always @(posedge clk_i or negedge rst_ni) begin
+      if (~rst_ni) begin
+        imem_haddr_r <= 32'h80000000;
+        last_addr_r  <= 32'h80000000;
+        if_skip_r    <= 2'b00;
+        dph_v_r      <= 1'b0;
+        dph_skip_r   <= 2'b00;
+      end else begin
+        if (restart) begin // restart fetcher, the data of a fetch in progress is dropped
+          imem_haddr_r <= restart_pc & ~(FETCH_BYTES - 1); // align to fetch width
+          if_skip_r    <= restart_pc[2:1];
+          dph_v_r      <= 1'b0;
+        end else if (imem_hready_i) begin // address phase accepted, data phase done
+          dph_v_r    <= fetch_req;
+          dph_skip_r <= if_skip_r;
+          if (fetch_req) begin
+            last_addr_r  <= imem_haddr_r;
+            imem_haddr_r <= imem_haddr_r + FETCH_BYTES;
+            if_skip_r    <= 2'b00; // aligned again
+          end
         end
       end
+    end
+
+    assign fetch_req  = ~ipb_hfull_global;
+    assign fetch_done = dph_v_r & imem_hready_i;
+
+    // bus request
+    assign imem_htrans_o = (fetch_req) ? `HASTI_TRANS_NONSEQ : `HASTI_TRANS_IDLE;
+    assign imem_haddr_o  = imem_haddr_r;
+    assign last_addr     = last_addr_r;
+
+    // write to IPB: half-word 2*i goes to the LOW FIFO, half-word 2*i+1 to the HIGH FIFO,
+    // the half-words before an unaligned restart address are skipped
+    for (i_gv = 0; i_gv < IPB_WR; i_gv = i_gv + 1) begin : ipb_wr
+      assign ipb_we_lo[i_gv] = fetch_done && (dph_skip_r <= 2*i_gv);
+      assign ipb_we_hi[i_gv] = fetch_done && (dph_skip_r <= 2*i_gv+1);
+      assign ipb_wdata_lo[IPB_W*i_gv +: IPB_W] = {2'b00, imem_badmem_i, imem_hrdata_i[32*i_gv +: (`XPR_LEN/2)]};
+      assign ipb_wdata_hi[IPB_W*i_gv +: IPB_W] = {2'b00, imem_badmem_i, imem_hrdata_i[32*i_gv+(`XPR_LEN/2) +: (`XPR_LEN/2)]};
+    end
 
-    endcase
   end
-end
+endgenerate
 
-// bus request
-assign imem_htrans_o    = `HASTI_TRANS_NONSEQ;
-assign imem_haddr_o     = imem_haddr_r;
 assign imem_hburst_o    = `HASTI_BURST_SINGLE;
 assign imem_hmastlock_o = `HASTI_MASTER_NO_LOCK;
 assign imem_hprot_o     = `HASTI_NO_PROT;
 
-// write to IPB
-assign ipb_we[0] = ((state_r == StFetch) && (state_prev_r != StWait) && (~if_unaligned_r) && (imem_hready_i) && (ipb_free_global)) ? 1'b1 : 1'b0; // instruction half-word LOW
-assign ipb_we[1] = ((state_r == StFetch) && (state_prev_r != StWait) &&                      (imem_hready_i) && (ipb_free_global)) ? 1'b1 : 1'b0; // instruction half-word HIGH
-
 
 // --------------------------------------------------------------------------------------------
 // Instruction prefetch buffer
@@ -198,7 +319,7 @@ assign ipb_we[1] = ((state_r == StFetch) && (state_prev_r != StWait) &&
 
 `ifdef WITH_SAFETY_FEATURES // -------- SAFETY prefetch buffer -------- /
 
-  wire ecc_enable = ((last_addr_r & `ECC_REGION_ENABLE_MASK) == (`ECC_REGION_COMPARE_MASK & `ECC_REGION_ENABLE_MASK)) ? 1'b1 : 1'b0;
+  wire ecc_enable = ((last_addr & `ECC_REGION_ENABLE_MASK) == (`ECC_REGION_COMPARE_MASK & `ECC_REGION_ENABLE_MASK)) ? 1'b1 : 1'b0;
 
   // "dual slot" FIFO with ECC
   airi5c_safety_prebuf_fifo #(
@@ -209,10 +330,10 @@ assign ipb_we[1] = ((state_r == StFetch) && (state_prev_r != StWait) &&
     .clear_i(ipb_clear),
     .ecc_en_i(ecc_enable),
     .hfull_o(ipb_hfull[1:0]),
-    .we_i(ipb_we[1:0]),
+    .we_i({ipb_we_hi[0], ipb_we_lo[0]}),
     .parity_i(parity_i),
     .data_i(imem_hrdata_i),
-    .addr_i(last_addr_r),
+    .addr_i(last_addr),
     .free_o(ipb_free[1:0]),
     .re_i(ipb_re[1:0]),
     .data_lo_o(ipb_cmd_lo),
@@ -222,50 +343,67 @@ assign ipb_we[1] = ((state_r == StFetch) && (state_prev_r != StWait) &&
     .avail_o(ipb_avail[1:0])
   );
 
+  // no two-entry read
+  assign ipb_avail2  = 2'b00;
+  assign ipb_cmd2_lo = {(`XPR_LEN/2){1'b0}};
+  assign ipb_cmd2_hi = {(`XPR_LEN/2){1'b0}};
+  assign ipb_err2_lo = 3'b000;
+  assign ipb_err2_hi = 3'b000;
+
 `else // -------- normal prefetch buffer -------- //
 
   // low half-word of instruction word (+ memory error)
   airi5c_prebuf_fifo #(
     .FIFO_DEPTH(`IPB_DEPTH),
-    .FIFO_WIDTH(3 + (`XPR_LEN/2))
+    .FIFO_WIDTH(IPB_W),
+    .WRITE_WIDTH(IPB_WR),
+    .READ_WIDTH((`DUAL_ISSUE != 0) ? 2 : 1)
   ) ipb_lo (
     .clk_i(clk_i),
     .rstn_i(rst_ni),
     .clear_i(ipb_clear),
     .hfull_o(ipb_hfull[0]),
-    .we_i(ipb_we[0]),
-    .data_i({2'b00, imem_badmem_i, imem_hrdata_i[(`XPR_LEN/2)-1:0]}),
+    .we_i(ipb_we_lo),
+    .data_i(ipb_wdata_lo),
     .free_o(ipb_free[0]),
     .re_i(ipb_re[0]),
     .data_o({ipb_err_lo, ipb_cmd_lo}),
-    .avail_o(ipb_avail[0])
+    .avail_o(ipb_avail[0]),
+    .re2_i(ipb_re2[0]),
+    .data2_o({ipb_err2_lo, ipb_cmd2_lo}),
+    .avail2_o(ipb_avail2[0])
   );
 
   // high half-word of instruction word (+ memory error)
   airi5c_prebuf_fifo #(
     .FIFO_DEPTH(`IPB_DEPTH),
-    .FIFO_WIDTH(3 + (`XPR_LEN/2))
+    .FIFO_WIDTH(IPB_W),
+    .WRITE_WIDTH(IPB_WR),
+    .READ_WIDTH((`DUAL_ISSUE != 0) ? 2 : 1)
   ) ipb_hi (
     .clk_i(clk_i),
     .rstn_i(rst_ni),
     .clear_i(ipb_clear),
     .hfull_o(ipb_hfull[1]),
-    .we_i(ipb_we[1]),
-    .data_i({2'b00, imem_badmem_i, imem_hrdata_i[`XPR_LEN-1:`XPR_LEN/2]}),
+    .we_i(ipb_we_hi),
+    .data_i(ipb_wdata_hi),
     .free_o(ipb_free[1]),
     .re_i(ipb_re[1]),
     .data_o({ipb_err_hi, ipb_cmd_hi}),
-    .avail_o(ipb_avail[1])
+    .avail_o(ipb_avail[1]),
+    .re2_i(ipb_re2[1]),
+    .data2_o({ipb_err2_hi, ipb_cmd2_hi}),
+    .avail2_o(ipb_avail2[1])
   );
 
 `endif
 
-// free entry in _all_ IPB FIFOs?
+// free entry in _all_ IPB FIFOs? at least one IPB FIFO half full?
 assign ipb_free_global  = &ipb_free;
 assign ipb_hfull_global = |ipb_hfull;
 
-// invalidate all IPB FIFOs when flushing IF stage
-assign ipb_clear = kill_if_i;
+// invalidate all IPB FIFOs when flushing IF stage or when following a predicted branch
+assign ipb_clear = restart;
 
 
 // --------------------------------------------------------------------------------------------
@@ -277,9 +415,12 @@ always @(posedge clk_i or negedge rst_ni) begin
     issue_pc_r        <= 32'h80000000; // "shadow" PC for instruction issueing
     issue_unaligned_r <= 1'b0; // start aligned
   end else begin
-    if (kill_if_i) begin // flush IF
-      issue_pc_r        <= {pc_pif_i[`XPR_LEN-1:1], 1'b0};
-      issue_unaligned_r <= pc_pif_i[1]; // set if new address is unaligned
+    if (restart) begin // flush IF
+      issue_pc_r        <= {restart_pc[`XPR_LEN-1:1], 1'b0};
+      issue_unaligned_r <= restart_pc[1]; // set if new address is unaligned
+    end else if (issue2_take) begin // two instructions issued
+      issue_unaligned_r <= issue_unaligned_r ^ issue2_hw[0];
+      issue_pc_r        <= issue_pc_r + {issue2_hw, 1'b0};
     end else if (de_ready_i) begin // update only if DE is ready for new instruction
       issue_unaligned_r <= (issue_unaligned_r & (~issue_unaligned_clr)) | issue_unaligned_set; // "sync. RS flip-flop"
       if (|issue_valid) begin
@@ -326,8 +467,8 @@ end
   end
 
   // interface to IPB
-  assign ipb_re[0] = de_ready_i & issue_valid[0]; // low half-word FIFO
-  assign ipb_re[1] = de_ready_i & issue_valid[1]; // high half-word FIFO
+  assign ipb_re[0] = de_ready_i & (issue_valid[0] | issue2_take); // low half-word FIFO
+  assign ipb_re[1] = de_ready_i & (issue_valid[1] | issue2_take); // high half-word FIFO
 
   // is compressed isntruction?
   assign compressed_o = c_valid;
@@ -365,6 +506,80 @@ assign if_valid_o    = |issue_valid;
 assign error_in_if_o = (|issue_valid) ? issue_err : 3'b000;
 
 
+// --------------------------------------------------------------------------------------------
+// Second instruction (DUAL_ISSUE)
+// -> the instruction behind the issued one is taken from the half-word stream h0..h3 at the
+//    issue PC (first and second entry of both IPB FIFOs, starting with the HIGH FIFO when
+//    unaligned), DE decides if both instructions are issued together (de_take2_i)
+// -> both instructions together use two to four half-words, at most two per FIFO
+// --------------------------------------------------------------------------------------------
+
+generate
+  if (`DUAL_ISSUE != 0) begin : issue2
+
+    wire             u   = issue_unaligned_r;
+    wire [IPB_W-1:0] hw0 = u ? {ipb_err_hi,  ipb_cmd_hi}  : {ipb_err_lo,  ipb_cmd_lo};
+    wire [IPB_W-1:0] hw1 = u ? {ipb_err_lo,  ipb_cmd_lo}  : {ipb_err_hi,  ipb_cmd_hi};
+    wire [IPB_W-1:0] hw2 = u ? {ipb_err2_hi, ipb_cmd2_hi} : {ipb_err2_lo, ipb_cmd2_lo};
+    wire [IPB_W-1:0] hw3 = u ? {ipb_err2_lo, ipb_cmd2_lo} : {ipb_err2_hi, ipb_cmd2_hi};
+    wire [3:0]       hw_avail = u ? {ipb_avail2[0], ipb_avail2[1], ipb_avail[0], ipb_avail[1]} :
+                                    {ipb_avail2[1], ipb_avail2[0], ipb_avail[1], ipb_avail[0]};
+
+    // the second instruction starts behind the first one
+    wire [IPB_W-1:0] first        = compressed_o ? hw1 : hw2;
+    wire [IPB_W-1:0] second       = compressed_o ? hw2 : hw3;
+    wire             first_avail  = compressed_o ? hw_avail[1] : hw_avail[2];
+    wire             second_avail = compressed_o ? hw_avail[2] : hw_avail[3];
+    wire [2:0]       err2         = first[IPB_W-1 -: 3] | (issue2_c ? 3'b000 : second[IPB_W-1 -: 3]);
+
+  `ifdef ISA_EXT_C
+    assign issue2_c = (first[1:0] != 2'b11);
+
+    airi5c_decompression decompression_logic2 (
+      .instruction_i(first[(`XPR_LEN/2)-1:0]),
+      .instruction_o(issue2_cmd),
+      .c_inst_detected_o(),
+      .c_jal_o(),
+      .c_j_o(),
+      .c_beqz_o(),
+      .c_bnez_o(),
+      .jal_imm_o(),
+      .j_imm_o(),
+      .beqz_imm_o(),
+      .bnez_imm_o()
+    );
+  `else
+    assign issue2_c   = 1'b0;
+    assign issue2_cmd = {second[(`XPR_LEN/2)-1:0], first[(`XPR_LEN/2)-1:0]};
+  `endif
+
+    assign issue2_valid = (|issue_valid) & ~(|issue_err) & first_avail & (issue2_c | second_avail) & ~(|err2);
+    assign issue2_take  = de_ready_i & de_take2_i & issue2_valid & ~kill_if_i;
+    assign issue2_hw    = (compressed_o ? 3'd1 : 3'd2) + (issue2_c ? 3'd1 : 3'd2);
+
+    // the FIFO holding h0 supplies h0/h2, the other one h1/h3
+    wire re2_first = issue2_take & (issue2_hw >= 3);
+    wire re2_other = issue2_take & (issue2_hw == 4);
+    assign ipb_re2 = u ? {re2_first, re2_other} : {re2_other, re2_first};
+
+  end else begin : no_issue2
+
+    assign issue2_valid = 1'b0;
+    assign issue2_take  = 1'b0;
+    assign issue2_hw    = 3'd0;
+    assign issue2_cmd   = `RV_NOP;
+    assign issue2_c     = 1'b0;
+    assign ipb_re2      = 2'b00;
+
+  end
+endgenerate
+
+assign inst_if2_o    = issue2_cmd;
+assign pc_if2_o      = issue_pc_r + (compressed_o ? 2 : 4);
+assign if_valid2_o   = issue2_valid;
+assign compressed2_o = issue2_c;
+
+
 // --------------------------------------------------------------------------------------------
 // Decompression
 // --------------------------------------------------------------------------------------------
@@ -409,12 +624,53 @@ assign error_in_if_o = (|issue_valid) ? issue_err : 3'b000;
 // Branch Prediction
 // --------------------------------------------------------------------------------------------
 
-assign predicted_branch_if_o = 1'b0; // coming soon!
-
-
+// The prediction is made on the (decompressed) instruction that is issued to DE.
+// A predicted-taken branch is issued normally, then the IPB is cleared and the
+// fetcher restarts at the predicted target. EX checks the prediction and
+// redirects on a misprediction (see airi5c_ctrl.v).
+
+generate
+  if (`BRANCH_PREDICTION != 0) begin : bp
+
+    airi5c_branch_prediction #(
+      .DYNAMIC((`BRANCH_PREDICTION == 2) ? 1 : 0),
+      .BHT_ENTRIES(`BP_BHT_ENTRIES),
+      .BTB_ENTRIES(`BP_BTB_ENTRIES),
+      .GHR_BITS(`BP_GHR_BITS),
+      .RAS_DEPTH(`BP_RAS_DEPTH)
+    ) branch_prediction (
+      .clk_i(clk_i),
+      .rst_ni(rst_ni),
+      .instruction_i(issue_cmd),
+      .PC_i(issue_pc_r),
+      .compressed_i(compressed_o),
+      .issue_i(de_ready_i & (|issue_valid) & ~kill_if_i),
+      .flush_i(kill_if_i),
+      .predicted_branch_o(predict),
+      .branch_target_o(predict_target),
+      .update_i(bp_update_i),
+      .update_taken_i(bp_taken_i),
+      .update_pc_i(bp_pc_i),
+      .update_inst_i(bp_inst_i),
+      .update_compressed_i(bp_compressed_i),
+      .update_target_i(bp_target_i)
+    );
+
+  end else begin : no_bp
+
+    assign predict        = 1'b0;
+    assign predict_target = `XPR_LEN'h0;
 
+  end
+endgenerate
 
+// only predict valid instructions without fetch error
+assign predicted_branch_if_o = predict & (|issue_valid) & ~(|issue_err);
 
+// follow the prediction when the branch is issued
+assign predict_redirect = predicted_branch_if_o & de_ready_i & ~kill_if_i;
+assign restart          = kill_if_i | predict_redirect;
+assign restart_pc       = kill_if_i ? pc_pif_i : predict_target;
 
 
 endmodule
@@ -36,6 +36,8 @@
 
 `define HASTI_BURST_WIDTH    3
 `define HASTI_BURST_SINGLE   `HASTI_BURST_WIDTH'd0
+`define HASTI_BURST_INCR4    `HASTI_BURST_WIDTH'd3
+`define HASTI_BURST_INCR8    `HASTI_BURST_WIDTH'd5
 
 `define HASTI_MASTER_NO_LOCK 1'b0
 
@@ -0,0 +1,278 @@
+//
+// Copyright 2022 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File             : airi5c_icache.v
+// Author           : A. Stanitzki
+// Creation Date    : 17.10.26
+// Version          : 1.0
+// Abstract         : Instruction cache between the fetcher and the IMEM bus
+// Notes            : Direct-mapped (WAYS = 1) or 2-way set associative
+//                    (WAYS = 2, LRU replacement), read-only, word accesses.
+//                    The fetcher side is an AHB-Lite slave: the tags and data
+//                    are read in the address phase, a hit completes in the
+//                    first data phase cycle. A miss refills the whole line
+//                    with an INCR4/INCR8 burst (LINE_WORDS = 4/8) starting at
+//                    the line base, then the requested word is delivered.
+//                    Transfers with HTRANS = IDLE (e.g. debug ROM fetches,
+//                    see airi5c_core.v) complete without a lookup.
+//                    invalidate_i (fence.i) clears all lines, during a refill
+//                    it is postponed until the line is complete.
+//                    hit_o/miss_o flag each lookup, hit_count/miss_count sum
+//                    them up (read by the testbench).
+//                    FETCH_WORDS = 2 (IFETCH_WIDTH = 64) returns two words
+//                    per lookup from an 8-byte aligned address, the data
+//                    array is then split into two banks (even/odd words).
+//
+
+`include "airi5c_hasti_constants.vh"
+
+module airi5c_icache #(
+  parameter WAYS       = 1,  // 1 = direct-mapped, 2 = 2-way set associative
+  parameter SETS       = 64, // power of 2
+  parameter LINE_WORDS = 4,  // 4 or 8 (refill burst INCR4/INCR8)
+  parameter FETCH_WORDS = 1  // words per lookup, 1 or 2
+) (
+  input                               clk_i,
+  input                               rst_ni,
+  input                               invalidate_i,
+
+  // fetcher side
+  input       [`HASTI_ADDR_WIDTH-1:0] s_haddr_i,
+  input       [`HASTI_TRANS_WIDTH-1:0] s_htrans_i,
+  output      [`HASTI_BUS_WIDTH*FETCH_WORDS-1:0] s_hrdata_o,
+  output                              s_hready_o,
+
+  // memory side
+  output      [`HASTI_ADDR_WIDTH-1:0] m_haddr_o,
+  output      [`HASTI_TRANS_WIDTH-1:0] m_htrans_o,
+  output      [`HASTI_BURST_WIDTH-1:0] m_hburst_o,
+  input       [`HASTI_BUS_WIDTH-1:0]  m_hrdata_i,
+  input                               m_hready_i,
+
+  // statistics
+  output                              hit_o,
+  output                              miss_o
+);
+
+localparam WORD_BITS = $clog2(LINE_WORDS);
+localparam SET_BITS  = $clog2(SETS);
+localparam TAG_LSB   = 2 + WORD_BITS + SET_BITS;
+localparam TAG_BITS  = `HASTI_ADDR_WIDTH - TAG_LSB;
+localparam ROWS      = LINE_WORDS / FETCH_WORDS; // data array rows per line
+localparam FW        = `HASTI_BUS_WIDTH * FETCH_WORDS;
+
+localparam S_LOOKUP = 2'd0,  // data phase of a lookup
+           S_REFILL = 2'd1,  // line refill burst
+           S_DONE   = 2'd2;  // deliver the requested word of the refilled line
+
+reg [1:0]                   state_r;
+
+// data phase of the fetcher transfer
+reg                         req_v_r;
+reg [`HASTI_ADDR_WIDTH-1:0] req_addr_r;
+
+wire [WORD_BITS-1:0]        req_word = req_addr_r[WORD_BITS+1:2];
+wire [SET_BITS-1:0]         req_set  = req_addr_r[TAG_LSB-1:WORD_BITS+2];
+wire [TAG_BITS-1:0]         req_tag  = req_addr_r[`HASTI_ADDR_WIDTH-1:TAG_LSB];
+
+// address phase lookup
+wire                        rd_en    = s_hready_o;
+wire [WORD_BITS-1:0]        rd_word  = s_haddr_i[WORD_BITS+1:2];
+wire [SET_BITS-1:0]         rd_set   = s_haddr_i[TAG_LSB-1:WORD_BITS+2];
+
+// valid bits and replacement
+reg  [SETS-1:0]             valid_r [0:WAYS-1];
+reg  [SETS-1:0]             lru_r;      // 2-way: way to replace next
+reg                         inval_pend_r;
+
+// refill
+reg                         refill_way_r;
+reg  [WORD_BITS:0]          beat_a_r;   // address phases issued
+reg  [WORD_BITS-1:0]        beat_d_r;   // data phases completed
+reg                         d_pend_r;   // data phase outstanding
+reg  [FW-1:0]               crit_r;     // requested word(s)
+
+wire                        addr_phase = (state_r == S_REFILL) && !beat_a_r[WORD_BITS];
+wire                        beat_done  = (state_r == S_REFILL) && d_pend_r && m_hready_i;
+wire                        last_beat  = beat_done && (beat_d_r == LINE_WORDS-1);
+
+// lookup result
+wire [WAYS-1:0]             way_hit;
+wire [FW*WAYS-1:0]          way_rdata;
+wire                        hit  = |way_hit;
+wire                        miss = (state_r == S_LOOKUP) && req_v_r && !hit;
+
+reg                         hit_way;
+reg                         victim_way;
+
+reg  [31:0]                 hit_count;
+reg  [31:0]                 miss_count;
+
+
+// --------------------------------------------------------------------------------------------
+// Tag and data arrays
+// --------------------------------------------------------------------------------------------
+
+genvar w, b;
+generate
+  for (w = 0; w < WAYS; w = w + 1) begin : way
+
+    reg [TAG_BITS-1:0]         tag_ram  [0:SETS-1];
+    reg [TAG_BITS-1:0]         tag_q;
+
+    always @(posedge clk_i) begin
+      if (rd_en)
+        tag_q <= tag_ram[rd_set];
+      if (last_beat && (refill_way_r == w))
+        tag_ram[req_set] <= req_tag;
+    end
+
+    // one bank per word of a lookup
+    for (b = 0; b < FETCH_WORDS; b = b + 1) begin : bank
+
+      reg [`HASTI_BUS_WIDTH-1:0] data_ram [0:SETS*ROWS-1];
+      reg [`HASTI_BUS_WIDTH-1:0] data_q;
+
+      always @(posedge clk_i) begin
+        if (rd_en)
+          data_q <= data_ram[rd_set*ROWS + rd_word/FETCH_WORDS];
+        if (beat_done && (refill_way_r == w) && ((beat_d_r % FETCH_WORDS) == b))
+          data_ram[req_set*ROWS + beat_d_r/FETCH_WORDS] <= m_hrdata_i;
+      end
+
+      assign way_rdata[FW*w + `HASTI_BUS_WIDTH*b +: `HASTI_BUS_WIDTH] = data_q;
+
+    end
+
+    assign way_hit[w] = valid_r[w][req_set] && (tag_q == req_tag);
+
+  end
+endgenerate
+
+always @(*) begin
+  hit_way    = (WAYS == 2) ? way_hit[WAYS-1] : 1'b0;
+  victim_way = 1'b0;
+  if (WAYS == 2) begin
+    if (!valid_r[0][req_set])
+      victim_way = 1'b0;
+    else if (!valid_r[WAYS-1][req_set])
+      victim_way = 1'b1;
+    else
+      victim_way = lru_r[req_set];
+  end
+end
+
+
+// --------------------------------------------------------------------------------------------
+// Control
+// --------------------------------------------------------------------------------------------
+
+integer i;
+
+always @(posedge clk_i or negedge rst_ni) begin
+  if (~rst_ni) begin
+    state_r      <= S_LOOKUP;
+    req_v_r      <= 1'b0;
+    req_addr_r   <= `HASTI_ADDR_WIDTH'h0;
+    lru_r        <= {SETS{1'b0}};
+    inval_pend_r <= 1'b0;
+    refill_way_r <= 1'b0;
+    beat_a_r     <= {(WORD_BITS+1){1'b0}};
+    beat_d_r     <= {WORD_BITS{1'b0}};
+    d_pend_r     <= 1'b0;
+    crit_r       <= {FW{1'b0}};
+    hit_count    <= 32'h0;
+    miss_count   <= 32'h0;
+    for (i = 0; i < WAYS; i = i + 1)
+      valid_r[i] <= {SETS{1'b0}};
+  end else begin
+
+    // accept the next address phase
+    if (rd_en) begin
+      req_v_r    <= s_htrans_i[1];
+      req_addr_r <= s_haddr_i;
+    end
+
+    case (state_r)
+
+      S_LOOKUP: begin
+        if (req_v_r && hit) begin
+          hit_count <= hit_count + 32'h1;
+          if (WAYS == 2)
+            lru_r[req_set] <= ~hit_way;
+        end
+        if (miss) begin
+          miss_count   <= miss_count + 32'h1;
+          refill_way_r <= victim_way;
+          beat_a_r     <= {(WORD_BITS+1){1'b0}};
+          beat_d_r     <= {WORD_BITS{1'b0}};
+          d_pend_r     <= 1'b0;
+          state_r      <= S_REFILL;
+        end
+      end
+
+      S_REFILL: begin
+        if (m_hready_i) begin
+          d_pend_r <= addr_phase;
+          if (addr_phase)
+            beat_a_r <= beat_a_r + 1'b1;
+        end
+        if (beat_done) begin
+          beat_d_r <= beat_d_r + 1'b1;
+          if ((beat_d_r / FETCH_WORDS) == (req_word / FETCH_WORDS))
+            crit_r[`HASTI_BUS_WIDTH*(beat_d_r % FETCH_WORDS) +: `HASTI_BUS_WIDTH] <= m_hrdata_i;
+        end
+        if (last_beat) begin
+          valid_r[refill_way_r][req_set] <= 1'b1;
+          if (WAYS == 2)
+            lru_r[req_set] <= ~refill_way_r;
+          state_r <= S_DONE;
+        end
+      end
+
+      default: begin // S_DONE
+        state_r <= S_LOOKUP;
+      end
+
+    endcase
+
+    // fence.i: invalidate all lines, but let a running refill finish
+    if (state_r == S_REFILL) begin
+      inval_pend_r <= inval_pend_r | invalidate_i;
+    end else if (invalidate_i || inval_pend_r) begin
+      inval_pend_r <= 1'b0;
+      for (i = 0; i < WAYS; i = i + 1)
+        valid_r[i] <= {SETS{1'b0}};
+    end
+
+  end
+end
+
+
+// --------------------------------------------------------------------------------------------
+// Bus interfaces
+// --------------------------------------------------------------------------------------------
+
+assign s_hready_o = ((state_r == S_LOOKUP) && !miss) || (state_r == S_DONE);
+assign s_hrdata_o = (state_r == S_DONE) ? crit_r : way_rdata[FW*hit_way +: FW];
+
+assign m_haddr_o  = {req_addr_r[`HASTI_ADDR_WIDTH-1:WORD_BITS+2], beat_a_r[WORD_BITS-1:0], 2'b00};
+assign m_htrans_o = !addr_phase        ? `HASTI_TRANS_IDLE :
+                    (beat_a_r == 0)    ? `HASTI_TRANS_NONSEQ : `HASTI_TRANS_SEQ;
+assign m_hburst_o = (LINE_WORDS == 8) ? `HASTI_BURST_INCR8 : `HASTI_BURST_INCR4;
+
+assign hit_o  = (state_r == S_LOOKUP) && req_v_r && hit;
+assign miss_o = miss;
+
+
+endmodule
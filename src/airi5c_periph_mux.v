@@ -48,6 +48,8 @@ module airi5c_periph_mux #
   localparam CL_S_COUNT = $clog2(S_COUNT);
     
   // hold register to store addr during data phase.
+  // The address phase is only accepted with hready high, so the
+  // register keeps the data phase slave while it inserts wait states.
   reg  [`HASTI_ADDR_WIDTH-1:0]  data_phase_addr;
   reg     match, match2;
   integer i,j;
@@ -55,13 +57,13 @@ module airi5c_periph_mux #
   always @(posedge clk_i or negedge rst_ni) begin
     if(~rst_ni) begin
       data_phase_addr <= 0;
-    end else begin
+    end else if(m_hready) begin
       data_phase_addr <= m_haddr;
     end
   end
   
   // Adress phase mux forwards the 
-  // appropriate hready and hresp signals
+  // appropriate hresp signal
   // to the master during the addr phase.
   reg [CL_S_COUNT-1:0] select, select2;
 
@@ -75,10 +77,8 @@ module airi5c_periph_mux #
       end
     end
     if(match) begin
-      m_hready = s_hready[select];
       m_hresp  = s_hresp[select*`HASTI_RESP_WIDTH +: `HASTI_RESP_WIDTH];
     end else begin
-      m_hready = &s_hready; //1'b1;
       m_hresp = `HASTI_RESP_ERROR; 
     end
   end
@@ -92,8 +92,15 @@ module airi5c_periph_mux #
         match2 = 1'b1;
       end
     end
-    if(match2) m_hrdata[31:0] = s_hrdata[select2*32 +: 32];
-    else m_hrdata[31:0] = 32'hdeadbeef;          
+    // hready belongs to the data phase: a slave inserting wait
+    // states stalls the master, whatever it addresses next.
+    if(match2) begin
+      m_hrdata[31:0] = s_hrdata[select2*32 +: 32];
+      m_hready = s_hready[select2];
+    end else begin
+      m_hrdata[31:0] = 32'hdeadbeef;
+      m_hready = &s_hready; //1'b1;
+    end
   end
   
 endmodule
@@ -33,12 +33,14 @@ module airi5c_pipeline(
 
   input                        imem_hready_i,
   output [`XPR_LEN-1:0]        imem_haddr_o,         // Instruction Memory Address
-  input  [`XPR_LEN-1:0]        imem_hrdata_i,        // Instruction Memory Data
+  input  [`IFETCH_WIDTH-1:0]   imem_hrdata_i,        // Instruction Memory Data (IFETCH_WIDTH)
   input                        imem_badmem_e,     // Instruction Memory error signal
   output [`HASTI_TRANS_WIDTH-1:0] imem_htrans_o,
   output [`HASTI_BURST_WIDTH-1:0] imem_hburst_o,
   output                          imem_hmastlock_o,
   output [`HASTI_PROT_WIDTH-1:0]  imem_hprot_o,
+  output                          imem_invalidate_o, // fence.i, invalidate the instruction cache
+  input                           icache_miss_i,     // instruction cache miss (performance counters)
 
   input                        dmem_hready_i,
   output                       dmem_hwrite_o,          // Data Memory Write Enable
@@ -51,6 +53,11 @@ module airi5c_pipeline(
   output [`HASTI_PROT_WIDTH-1:0]  dmem_hprot_o,
   input  [`XPR_LEN-1:0]        dmem_hrdata_i,        // Word read from data memory
   input                        dmem_badmem_e,     // Data memory error signal
+  output                          dmem_fence_o,      // fence/fence.i, write back the data cache
+  output                          dmem_fence_inv_o,  // fence.i, also invalidate the data cache
+  input                           dmem_fence_done_i,
+  output                          dmem_wt_o,         // debug mode, data cache write-through
+  input                           dcache_miss_i,     // data cache miss (performance counters)
 
   // debug module register access port
 
@@ -110,6 +117,15 @@ module airi5c_pipeline(
   ,
   input                        pcpi_ready_mul_div
   `endif
+  `ifdef PCPI_SCOREBOARD
+  ,
+  input                        pcpi_accept,       // decoupled coprocessor operations (see airi5c_ctrl.v)
+  output                       pcpi_issue,
+  input                        pcpi_late_wr,      // late coprocessor result
+  input  [`REG_ADDR_WIDTH-1:0] pcpi_late_wa,
+  input  [`XPR_LEN-1:0]        pcpi_late_rd,
+  output                       pcpi_late_ack
+  `endif
 `endif
 );
 
@@ -150,6 +166,11 @@ module airi5c_pipeline(
   wire                              imem_compressed_IF;
   wire                              if_valid;
   wire                              predicted_branch_if;
+  wire [`XPR_LEN-1:0]               jalr_target_EX;
+  wire                              jalr_target_hit;
+  wire                              bp_update;
+  wire                              bp_taken;
+  wire                              bp_mispredict;
 
   // DECODE stage signals
   wire                              de_valid;
@@ -266,6 +287,7 @@ module airi5c_pipeline(
   wire  [`XPR_LEN-1:0]           pcpi_rd_WB;
   wire  [`XPR_LEN-1:0]           pcpi_rd2_WB;
   wire                           pcpi_rd64_WB;
+  wire                           compressed_WB;
   wire                          kill_WB;
   wire                          stall_WB;
   wire  [`XPR_LEN-1:0]           bypass_data_WB;
@@ -303,6 +325,13 @@ module airi5c_pipeline(
   wire                        stepmode;
   wire                        dmode_WB;
 
+  // hardware performance monitor events (see airi5c_csr_addr_map.vh)
+  wire                        hpm_load_use;
+  wire                        hpm_pcpi;
+  wire                        hpm_fpu;
+  wire                        hpm_dmem_wait;
+  wire [`HPM_EVENTS-1:0]      hpm_events;
+
   `ifdef ISA_EXT_F
   // FPU
   wire                        fpu_ena;
@@ -334,11 +363,70 @@ module airi5c_pipeline(
   wire                        fpu_busy;
   wire                        fpu_ready;
 
+  // pipelined FPU (FPU_PIPELINED), results are written late
+  wire                        fpu_accept;
+  wire                        fpu_issue;
+  wire                        fpu_late_wr;
+  wire  [`REG_ADDR_WIDTH-1:0] fpu_late_wa;
+  wire    [31:0]              fpu_late_rd;
+  wire                        fpu_late_ack;
+  wire                        fpu_late_NV;
+  wire                        fpu_late_OF;
+  wire                        fpu_late_UF;
+  wire                        fpu_late_NX;
+
   wire [2:0]                  rounding_mode;
   `endif
 
   wire   [`XPR_LEN-1:0]        rs1_data_WB;
 
+  // second issue slot (DUAL_ISSUE), ALU operations paired with the instruction in slot 1
+  wire [`XPR_LEN-1:0]          PC_IF2;
+  wire [`XPR_LEN-1:0]          inst_IF2;
+  wire                         if_valid2;
+  wire                         imem_compressed_IF2;
+  wire                         take2;
+  wire [`XPR_LEN-1:0]          PC_DE2;
+  wire [`XPR_LEN-1:0]          inst_DE2;
+  wire                         de_valid2;
+  wire                         imem_compressed_DE2;
+  wire [`ALU_OP_WIDTH-1:0]     alu_op_DE2;
+  wire [`SRC_A_SEL_WIDTH-1:0]  src_a_sel_DE2;
+  wire [`SRC_B_SEL_WIDTH-1:0]  src_b_sel_DE2;
+  wire [`IMM_TYPE_WIDTH-1:0]   imm_type_DE2;
+  wire                         uses_rs1_DE2;
+  wire                         uses_rs2_DE2;
+  wire                         ex_valid2;
+  wire [`XPR_LEN-1:0]          PC_EX2;
+  wire [`INST_WIDTH-1:0]       inst_EX2;
+  wire                         imem_compressed_EX2;
+  wire [`ALU_OP_WIDTH-1:0]     alu_op_EX2;
+  wire [`SRC_A_SEL_WIDTH-1:0]  src_a_sel_EX2;
+  wire [`SRC_B_SEL_WIDTH-1:0]  src_b_sel_EX2;
+  wire [`IMM_TYPE_WIDTH-1:0]   imm_type_EX2;
+  wire                         uses_rs1_EX2;
+  wire                         uses_rs2_EX2;
+  wire [`XPR_LEN-1:0]          imm2;
+  wire [`XPR_LEN-1:0]          rs1_data2;
+  wire [`XPR_LEN-1:0]          rs1_data2_bypassed;
+  wire [`XPR_LEN-1:0]          rs2_data2;
+  wire [`XPR_LEN-1:0]          rs2_data2_bypassed;
+  wire [`XPR_LEN-1:0]          alu_src_a2;
+  wire [`XPR_LEN-1:0]          alu_src_b2;
+  wire [`XPR_LEN-1:0]          alu_out2;
+  wire                         bypass2_rs1;      // slot 2 source from WB (slot 1)
+  wire                         bypass2_rs2;
+  wire                         bypass_rs1_WB2;   // slot 1 source from WB slot 2
+  wire                         bypass_rs2_WB2;
+  wire                         bypass_rs3_WB2;
+  wire                         bypass2_rs1_WB2;  // slot 2 source from WB slot 2
+  wire                         bypass2_rs2_WB2;
+  wire [`XPR_LEN-1:0]          alu_out_WB2;
+  wire                         compressed_WB2;
+  wire                         wr_reg2_WB;
+  wire [`REG_ADDR_WIDTH-1:0]   reg_to_wr2_WB;
+  wire                         retire2_WB;
+
 // ===================================
 // PCPI coprocessor interface
 // ===================================
@@ -362,6 +450,10 @@ airi5c_ctrl ctrl(
   .if_valid_i(if_valid),
   .imem_badmem_e(badmem_e_IF),
   .predicted_branch_ex_i(predicted_branch_ex),
+  .jalr_target_hit_i(jalr_target_hit),
+  .bp_update_o(bp_update),
+  .bp_taken_o(bp_taken),
+  .bp_mispredict_o(bp_mispredict),
     
   // port to DE stage
   .de_ready_i(de_ready),
@@ -380,6 +472,15 @@ airi5c_ctrl ctrl(
   .uses_rs1(uses_rs1_EX),
   .uses_rs2(uses_rs2_EX),
   .eret_unkilled(eret_unkilled_EX),
+  .fence_i_unkilled(fence_i_EX),
+  .fence_i_o(imem_invalidate_o),
+  .dmem_fence_o(dmem_fence_o),
+  .dmem_fence_inv_o(dmem_fence_inv_o),
+  .dmem_fence_done_i(dmem_fence_done_i),
+  .hpm_load_use_o(hpm_load_use),
+  .hpm_pcpi_o(hpm_pcpi),
+  .hpm_fpu_o(hpm_fpu),
+  .hpm_dmem_wait_o(hpm_dmem_wait),
   .bypass_rs1(bypass_rs1),
   .bypass_rs2(bypass_rs2),
   .uses_rs3(uses_rs3_EX),
@@ -408,6 +509,12 @@ airi5c_ctrl ctrl(
   .pcpi_wr(pcpi_wr),
   .pcpi_valid_unkilled(pcpi_valid_unkilled_EX),
   .pcpi_valid(pcpi_valid_EX),
+`ifdef PCPI_SCOREBOARD
+  .pcpi_accept(pcpi_accept),
+  .pcpi_issue(pcpi_issue),
+  .pcpi_late_ack(pcpi_late_ack),
+  .pcpi_late_wa(pcpi_late_wa),
+`endif
 
   .wb_src_sel_EX(wb_src_sel_EX),
   .wr_reg_unkilled_EX(wr_reg_unkilled_EX),
@@ -433,7 +540,23 @@ airi5c_ctrl ctrl(
   .wb_src_sel_WB(wb_src_sel_WB),
   .dmode_WB(dmode_WB),
   .prev_killed_WB(prev_killed_WB),
-  .had_ex_WB(had_ex_WB)
+  .had_ex_WB(had_ex_WB),
+
+  // second issue slot
+  .inst2_ex_i(inst_EX2),
+  .ex_valid2_i(ex_valid2),
+  .uses2_rs1(uses_rs1_EX2),
+  .uses2_rs2(uses_rs2_EX2),
+  .bypass2_rs1(bypass2_rs1),
+  .bypass2_rs2(bypass2_rs2),
+  .bypass_rs1_WB2(bypass_rs1_WB2),
+  .bypass_rs2_WB2(bypass_rs2_WB2),
+  .bypass_rs3_WB2(bypass_rs3_WB2),
+  .bypass2_rs1_WB2(bypass2_rs1_WB2),
+  .bypass2_rs2_WB2(bypass2_rs2_WB2),
+  .wr_reg2_WB(wr_reg2_WB),
+  .reg_to_wr2_WB(reg_to_wr2_WB),
+  .retire2_WB(retire2_WB)
   `ifdef ISA_EXT_P
   ,
   .pcpi_ready_mul_div(pcpi_ready_mul_div)
@@ -450,7 +573,11 @@ airi5c_ctrl ctrl(
   .sel_fpu_rd_EX(sel_fpu_rd_EX),
   .sel_fpu_rd_WB(sel_fpu_rd_WB),
   .load_fpu(load_fpu),
-  .kill_fpu(kill_fpu)
+  .kill_fpu(kill_fpu),
+  .fpu_accept(fpu_accept),
+  .fpu_issue(fpu_issue),
+  .fpu_late_ack(fpu_late_ack),
+  .fpu_late_wa(fpu_late_wa)
 `endif
 );
 
@@ -473,8 +600,12 @@ airi5c_pc_mux PCmux(
   .handler_pc_i(handler_PC),
   .epc_i(mepc),
   .dpc_i(dpc),
-  .pc_pif_o(PC_PIF)
+  .pc_pif_o(PC_PIF),
+  .jalr_target_o(jalr_target_EX)
 );
+
+// a predicted jalr was right if the next instruction (DE) is at its target
+assign jalr_target_hit = (jalr_target_EX == PC_DE);
 // ==============================================================
 
 // ==============================================================
@@ -493,6 +624,18 @@ airi5c_fetch fetcher(
   .compressed_o(imem_compressed_IF),
   .predicted_branch_if_o(predicted_branch_if),
   .error_in_if_o(badmem_e_IF),
+  .pc_if2_o(PC_IF2),
+  .inst_if2_o(inst_IF2),
+  .if_valid2_o(if_valid2),
+  .compressed2_o(imem_compressed_IF2),
+  .de_take2_i(take2),
+
+  .bp_update_i(bp_update),
+  .bp_taken_i(bp_taken),
+  .bp_pc_i(PC_EX),
+  .bp_inst_i(inst_EX),
+  .bp_compressed_i(imem_compressed_EX),
+  .bp_target_i(jalr_target_EX),
 
   .imem_hready_i(imem_hready_i),
   .imem_haddr_o(imem_haddr_o),
@@ -559,7 +702,24 @@ airi5c_decode decoder(
   .ecall_o(ecall_DE),
   .ebreak_o(ebreak_DE),
   .dret_unkilled_o(dret_unkilled_DE),
-  .wfi_unkilled_o(wfi_unkilled_DE)
+  .wfi_unkilled_o(wfi_unkilled_DE),
+
+  .dual_issue_en_i(~stepmode),
+  .pc_if2_i(PC_IF2),
+  .inst_if2_i(inst_IF2),
+  .if_valid2_i(if_valid2),
+  .imem_compressed_if2_i(imem_compressed_IF2),
+  .take2_o(take2),
+  .pc_de2_o(PC_DE2),
+  .inst_de2_o(inst_DE2),
+  .de_valid2_o(de_valid2),
+  .imem_compressed_de2_o(imem_compressed_DE2),
+  .alu_op2_o(alu_op_DE2),
+  .src_a_sel2_o(src_a_sel_DE2),
+  .src_b_sel2_o(src_b_sel_DE2),
+  .imm_type2_o(imm_type_DE2),
+  .uses2_rs1_o(uses_rs1_DE2),
+  .uses2_rs2_o(uses_rs2_DE2)
 `ifdef ISA_EXT_F
   ,
   .fpu_ena_i(fpu_ena),
@@ -629,6 +789,17 @@ airi5c_EX_pregs EX_pipeline_regs(
   .rs3_addr_de_i(rs3_addr_DE),
   .loadstore_de_i(loadstore_DE),
 
+  .de_valid2_i(de_valid2),
+  .pc_de2_i(PC_DE2),
+  .inst_de2_i(inst_DE2),
+  .imem_compressed_de2_i(imem_compressed_DE2),
+  .alu_op2_de_i(alu_op_DE2),
+  .src_a_sel2_de_i(src_a_sel_DE2),
+  .src_b_sel2_de_i(src_b_sel_DE2),
+  .imm_type2_de_i(imm_type_DE2),
+  .uses2_rs1_de_i(uses_rs1_DE2),
+  .uses2_rs2_de_i(uses_rs2_DE2),
+
 `ifdef ISA_EXT_F
   .fpu_op_de_i(fpu_op_DE),
   .sel_fpu_rs1_de_i(sel_fpu_rs1_DE),
@@ -670,7 +841,18 @@ airi5c_EX_pregs EX_pipeline_regs(
   .rs1_addr_EX_o(rs1_addr_EX),
   .rs2_addr_EX_o(rs2_addr_EX),
   .rs3_addr_EX_o(rs3_addr_EX),
-  .loadstore_EX_o(loadstore_EX)
+  .loadstore_EX_o(loadstore_EX),
+
+  .ex_valid2_o(ex_valid2),
+  .PC2_EX_o(PC_EX2),
+  .inst2_EX_o(inst_EX2),
+  .imem_compressed2_EX_o(imem_compressed_EX2),
+  .alu_op2_EX_o(alu_op_EX2),
+  .src_a_sel2_EX_o(src_a_sel_EX2),
+  .src_b_sel2_EX_o(src_b_sel_EX2),
+  .imm_type2_EX_o(imm_type_EX2),
+  .uses2_rs1_EX_o(uses_rs1_EX2),
+  .uses2_rs2_EX_o(uses_rs2_EX2)
 `ifdef ISA_EXT_F
   ,
   .fpu_op_EX_o(fpu_op_EX),
@@ -691,9 +873,50 @@ assign src_b_sel   = src_b_sel_EX;
 assign imm_type    = imm_type_EX;
 assign pcpi_valid  = pcpi_valid_EX;
 assign dmem_hsize_o   = dmem_size_EX;
+assign dmem_wt_o      = dmode_WB;
 
 // ==============================================================
 
+// Late coprocessor results (PCPI_SCOREBOARD) and late results of the
+// pipelined FPU (FPU_PIPELINED) use the register file write port in
+// cycles without a write from the WB stage, coprocessor results first.
+wire                          rf_wen;
+wire  [`REG_ADDR_WIDTH-1:0]   rf_wa;
+wire  [`XPR_LEN-1:0]          rf_wd;
+wire                          rf_use_rd64;
+`ifdef ISA_EXT_F
+wire                          rf_sel_fpu_rd;
+`endif
+
+`ifdef PCPI_SCOREBOARD
+assign pcpi_late_ack = pcpi_late_wr && !wr_reg_WB && !dm_wen;
+`ifdef ISA_EXT_F
+assign fpu_late_ack  = fpu_late_wr && !pcpi_late_wr && !wr_reg_WB && !dm_wen;
+assign rf_wen        = wr_reg_WB || pcpi_late_ack || fpu_late_ack;
+assign rf_wa         = wr_reg_WB ? reg_to_wr_WB : pcpi_late_ack ? pcpi_late_wa : fpu_late_wa;
+assign rf_wd         = wr_reg_WB ? wb_data_WB   : pcpi_late_ack ? pcpi_late_rd : fpu_late_rd;
+assign rf_sel_fpu_rd = wr_reg_WB ? sel_fpu_rd_WB : fpu_late_ack;
+`else
+assign rf_wen        = wr_reg_WB || pcpi_late_ack;
+assign rf_wa         = wr_reg_WB ? reg_to_wr_WB : pcpi_late_wa;
+assign rf_wd         = wr_reg_WB ? wb_data_WB   : pcpi_late_rd;
+`endif
+assign rf_use_rd64   = wr_reg_WB && pcpi_rd64_WB;
+`else
+`ifdef ISA_EXT_F
+assign fpu_late_ack  = fpu_late_wr && !wr_reg_WB && !dm_wen;
+assign rf_wen        = wr_reg_WB || fpu_late_ack;
+assign rf_wa         = wr_reg_WB ? reg_to_wr_WB : fpu_late_wa;
+assign rf_wd         = wr_reg_WB ? wb_data_WB   : fpu_late_rd;
+assign rf_sel_fpu_rd = wr_reg_WB ? sel_fpu_rd_WB : fpu_late_ack;
+`else
+assign rf_wen        = wr_reg_WB;
+assign rf_wa         = reg_to_wr_WB;
+assign rf_wd         = wb_data_WB;
+`endif
+assign rf_use_rd64   = pcpi_rd64_WB;
+`endif
+
 airi5c_regfile regfile(
   .clk_i(clk_i),
   .rst_ni(rst_ni),
@@ -703,16 +926,23 @@ airi5c_regfile regfile(
   .rd2_o(rs2_data),
   .ra3_i(rs3_addr),
   .rd3_o(rs3_data),
-  .wen_i(wr_reg_WB),
-  .wa_i(reg_to_wr_WB),
-  .wd_i(wb_data_WB),
+  .wen_i(rf_wen),
+  .wa_i(rf_wa),
+  .wd_i(rf_wd),
   .wd2_i(pcpi_rd2_WB),
-  .use_rd64_i(pcpi_rd64_WB),
+  .use_rd64_i(rf_use_rd64),
+  .ra4_i(inst_EX2[19:15]),
+  .rd4_o(rs1_data2),
+  .ra5_i(inst_EX2[24:20]),
+  .rd5_o(rs2_data2),
+  .wen_b_i(wr_reg2_WB),
+  .wa_b_i(reg_to_wr2_WB),
+  .wd_b_i(alu_out_WB2),
 `ifdef ISA_EXT_F
   .sel_fpu_rs1_i(sel_fpu_rs1_EX),
   .sel_fpu_rs2_i(sel_fpu_rs2_EX),
   .sel_fpu_rs3_i(sel_fpu_rs3_EX),
-  .sel_fpu_rd_i(sel_fpu_rd_WB),
+  .sel_fpu_rd_i(rf_sel_fpu_rd),
   .dm_sel_fpu_reg_i(dm_sel_fpu_reg),
 `endif
   .dm_wara_i(dm_wara),
@@ -742,9 +972,9 @@ airi5c_src_b_mux src_b_mux(
   .alu_src_b_o(alu_src_b)
 );
 
-assign rs1_data_bypassed = bypass_rs1 ? bypass_data_WB : rs1_data;
-assign rs2_data_bypassed = bypass_rs2 ? bypass_data_WB : rs2_data;
-assign rs3_data_bypassed = bypass_rs3 ? bypass_data_WB : rs3_data;
+assign rs1_data_bypassed = bypass_rs1 ? bypass_data_WB : bypass_rs1_WB2 ? alu_out_WB2 : rs1_data;
+assign rs2_data_bypassed = bypass_rs2 ? bypass_data_WB : bypass_rs2_WB2 ? alu_out_WB2 : rs2_data;
+assign rs3_data_bypassed = bypass_rs3 ? bypass_data_WB : bypass_rs3_WB2 ? alu_out_WB2 : rs3_data;
 
 airi5c_alu alu(
   .op_i(alu_op),
@@ -754,6 +984,40 @@ airi5c_alu alu(
   .cmp_true_o(cmp_true)
 );
 
+// second issue slot (DUAL_ISSUE): operands and ALU of the paired instruction
+
+airi5c_imm_gen imm_gen2(
+  .inst_i(inst_EX2),
+  .imm_type_i(imm_type_EX2),
+  .imm_o(imm2)
+);
+
+airi5c_src_a_mux src_a_mux2(
+  .src_a_sel_i(src_a_sel_EX2),
+  .pc_ex_i(PC_EX2),
+  .rs1_data_i(rs1_data2_bypassed),
+  .alu_src_a_o(alu_src_a2)
+);
+
+airi5c_src_b_mux src_b_mux2(
+  .src_b_sel_i(src_b_sel_EX2),
+  .was_compressed_i(imem_compressed_EX2),
+  .imm_i(imm2),
+  .rs2_data_i(rs2_data2_bypassed),
+  .alu_src_b_o(alu_src_b2)
+);
+
+assign rs1_data2_bypassed = bypass2_rs1 ? bypass_data_WB : bypass2_rs1_WB2 ? alu_out_WB2 : rs1_data2;
+assign rs2_data2_bypassed = bypass2_rs2 ? bypass_data_WB : bypass2_rs2_WB2 ? alu_out_WB2 : rs2_data2;
+
+airi5c_alu alu2(
+  .op_i(alu_op_EX2),
+  .in1_i(alu_src_a2),
+  .in2_i(alu_src_b2),
+  .out_o(alu_out2),
+  .cmp_true_o()
+);
+
 // a comparison performed by the ALU (BEQ, BEL, ...)
 // sets the LSB according to the result.
 
@@ -785,6 +1049,48 @@ airi5c_alu alu(
 	.busy(fpu_busy),
     .ready(fpu_ready)
   );
+
+  // FADD/FSUB/FMUL and fused multiply-add, one issue per cycle (FPU_PIPELINED)
+  generate
+  if (`FPU_PIPELINED != 0) begin : fpu_pipe
+    airi5c_FPU_pipe FPU_pipe
+    (
+      .clk(clk_i),
+      .n_reset(rst_ni),
+      .load(fpu_issue),
+
+      .op(fpu_op_EX),
+      .rm(inst_EX[14:12] == `FPU_RM_DYN ? rounding_mode : inst_EX[14:12]),
+      .rd(inst_EX[11:7]),
+
+      .a(rs1_data_bypassed),
+      .b(rs2_data_bypassed),
+      .c(rs3_data_bypassed),
+
+      .accept(fpu_accept),
+
+      .late_wr(fpu_late_wr),
+      .late_wa(fpu_late_wa),
+      .result(fpu_late_rd),
+
+      .IV(fpu_late_NV),
+      .OF(fpu_late_OF),
+      .UF(fpu_late_UF),
+      .IE(fpu_late_NX),
+
+      .late_ack(fpu_late_ack)
+    );
+  end else begin : no_fpu_pipe
+    assign fpu_accept  = 1'b0;
+    assign fpu_late_wr = 1'b0;
+    assign fpu_late_wa = `REG_ADDR_WIDTH'h0;
+    assign fpu_late_rd = 32'h00000000;
+    assign fpu_late_NV = 1'b0;
+    assign fpu_late_OF = 1'b0;
+    assign fpu_late_UF = 1'b0;
+    assign fpu_late_NX = 1'b0;
+  end
+  endgenerate
 `endif
 
 // ==============================================================
@@ -826,6 +1132,9 @@ airi5c_WB_pregs WB_pipeline_regs(
   .pcpi_use_rd64_i(pcpi_use_rd64),
   .inst_ex_i(inst_EX),
   .rs1_data_i(rs1_data_bypassed),
+  .compressed_ex_i(imem_compressed_EX),
+  .alu_out2_i(alu_out2),
+  .compressed2_ex_i(imem_compressed_EX2),
 
   .PC_WB_o(PC_WB),
   .prev_killed_WB_o(prev_killed_WB),
@@ -838,7 +1147,10 @@ airi5c_WB_pregs WB_pipeline_regs(
   .pcpi_rd2_wb_o(pcpi_rd2_WB),
   .pcpi_use_rd64_wb_o(pcpi_rd64_WB),
   .inst_wb_o(inst_WB),
-  .rs1_data_wb_o(rs1_data_WB)
+  .rs1_data_wb_o(rs1_data_WB),
+  .compressed_wb_o(compressed_WB),
+  .alu_out2_wb_o(alu_out_WB2),
+  .compressed2_wb_o(compressed_WB2)
 
 `ifdef ISA_EXT_F
   ,
@@ -880,6 +1192,19 @@ airi5c_wb_src_mux wb_src_mux(
 assign csr_addr  = inst_EX[31:20];
 assign csr_wdata = csr_imm_sel_EX ? {27'd0,inst_EX[19:15]} : rs1_data_bypassed;
 
+// performance counter events, taken interrupts are detected in the CSR file
+assign hpm_events[`HPM_EVENT_NONE]        = 1'b0;
+assign hpm_events[`HPM_EVENT_LOAD_USE]    = hpm_load_use;
+assign hpm_events[`HPM_EVENT_PCPI]        = hpm_pcpi;
+assign hpm_events[`HPM_EVENT_FPU]         = hpm_fpu;
+assign hpm_events[`HPM_EVENT_MISPREDICT]  = bp_mispredict;
+assign hpm_events[`HPM_EVENT_FETCH]       = de_ready && !if_valid && !flush_pipeline;
+assign hpm_events[`HPM_EVENT_DMEM_WAIT]   = hpm_dmem_wait;
+assign hpm_events[`HPM_EVENT_IRQ]         = 1'b0;
+assign hpm_events[`HPM_EVENT_C_RETIRED]   = (retire_WB && compressed_WB) || (retire2_WB && compressed_WB2);
+assign hpm_events[`HPM_EVENT_ICACHE_MISS] = icache_miss_i;
+assign hpm_events[`HPM_EVENT_DCACHE_MISS] = dcache_miss_i;
+
 // instantiation of the CSR file
 airi5c_csr_file csr(
   .clk(clk_i),
@@ -924,8 +1249,10 @@ airi5c_csr_file csr(
 
   .inst_WB(inst_WB),
   .retire(retire_WB),
+  .retire2(retire2_WB),
   .redirect(redirect_WB),
   .stall_WB(stall_WB),
+  .hpm_events(hpm_events),
 
 `ifdef ISA_EXT_F
   .fpu_op(fpu_op_EX),
@@ -937,7 +1264,9 @@ airi5c_csr_file csr(
   .NV(NV),
   .rounding_mode(rounding_mode),
   .fpu_ena(fpu_ena),
-  .fpu_reg_dirty(sel_fpu_rd_WB && wr_reg_WB),
+  .fpu_reg_dirty((sel_fpu_rd_WB && wr_reg_WB) || fpu_late_ack),
+  .fpu_late_ack(fpu_late_ack),
+  .fpu_late_flags({fpu_late_NV, 1'b0, fpu_late_OF, fpu_late_UF, fpu_late_NX}),
 `endif
   .dmode_WB(dmode_WB)
 );
@@ -20,6 +20,8 @@
 //                    and depth and async. (!) read access.
 // Note             : Derived from https://github.com/stnolting/neorv32/blob/main/rtl/core/neorv32_fifo.vhd (BSD-License)
 // History          : 15.12.2021 - initial setup / complete redesign
+//                    17.10.2026 - optional second write port (WRITE_WIDTH) [stanitzki]
+//                    17.10.2026 - optional two-entry read (READ_WIDTH) [stanitzki]
 //
 //
 
@@ -27,8 +29,10 @@
 
 module airi5c_prebuf_fifo
 #(
-  parameter FIFO_DEPTH = 2, // has to be a power of two
-  parameter FIFO_WIDTH = 32
+  parameter FIFO_DEPTH  = 2, // has to be a power of two
+  parameter FIFO_WIDTH  = 32,
+  parameter WRITE_WIDTH = 1, // entries per write (1 or 2, 2 requires FIFO_DEPTH >= 4)
+  parameter READ_WIDTH  = 1  // entries per read (1 or 2, 2 requires FIFO_DEPTH >= 4)
 )
 (
   // global control
@@ -36,14 +40,18 @@ module airi5c_prebuf_fifo
   input                   rstn_i,  // async reset
   input                   clear_i, // sync reset
   output                  hfull_o, // at least half full
-  // write port
-  input                   we_i,
-  input  [FIFO_WIDTH-1:0] data_i,
-  output                  free_o,
+  // write port (we_i[k] writes data_i entry k, enabled entries are stored in order)
+  input  [WRITE_WIDTH-1:0]            we_i,
+  input  [WRITE_WIDTH*FIFO_WIDTH-1:0] data_i,
+  output                              free_o, // space for WRITE_WIDTH entries
   // read port
   input  [2:0]            re_i,
   output [FIFO_WIDTH-1:0] data_o,
-  output                  avail_o
+  output                  avail_o,
+  // second read entry (READ_WIDTH = 2 only, re2_i reads data_o and data2_o)
+  input                   re2_i,
+  output [FIFO_WIDTH-1:0] data2_o,
+  output                  avail2_o  // at least two entries
 );
 
 // status flags
@@ -55,8 +63,10 @@ wire avail;
 wire half;
 
 // internal access
-wire we;
-wire re;
+wire [WRITE_WIDTH-1:0] we;
+wire [1:0]             we_num; // number of entries written
+wire                   re;
+wire                   re2;
 
 
 // --------------------------------------------------------------------------------------------
@@ -74,12 +84,14 @@ always @(posedge clk_i or negedge rstn_i) begin
     // write pointer
     if (clear_i) begin
       wr_pnt <= 0;
-    end else if (we) begin
-      wr_pnt <= wr_pnt + 1;
+    end else if (|we) begin
+      wr_pnt <= wr_pnt + we_num;
     end
     // read pointer
     if (clear_i) begin
       rd_pnt <= 0;
+    end else if (re2) begin
+      rd_pnt <= rd_pnt + 2;
     end else if (re) begin
       rd_pnt <= rd_pnt + 1;
     end
@@ -87,9 +99,17 @@ always @(posedge clk_i or negedge rstn_i) begin
 end
 
 // safe access - ignore read/write commands if FIFO is empty/full
-assign we = we_i & free;
+assign we = we_i & {WRITE_WIDTH{free}};
 assign re = re_i & avail;
 
+generate
+  if (WRITE_WIDTH == 2) begin
+    assign we_num = {1'b0, we[0]} + {1'b0, we[1]};
+  end else begin
+    assign we_num = {1'b0, we[0]};
+  end
+endgenerate
+
 
 // --------------------------------------------------------------------------------------------
 // FIFO status
@@ -98,12 +118,30 @@ assign match = ((rd_pnt[$clog2(FIFO_DEPTH)-1:0] == wr_pnt[$clog2(FIFO_DEPTH)-1:0
 assign full  = ((rd_pnt[$clog2(FIFO_DEPTH)] != wr_pnt[$clog2(FIFO_DEPTH)]) && match) ? 1'b1 : 1'b0;
 assign empty = ((rd_pnt[$clog2(FIFO_DEPTH)] == wr_pnt[$clog2(FIFO_DEPTH)]) && match) ? 1'b1 : 1'b0;
 
-assign free  = ~full;
+generate
+  if (WRITE_WIDTH == 2) begin
+    wire [$clog2(FIFO_DEPTH):0] level = wr_pnt - rd_pnt;
+    assign free = (level <= (FIFO_DEPTH - 2)) ? 1'b1 : 1'b0;
+  end else begin
+    assign free = ~full;
+  end
+endgenerate
 assign avail = ~empty;
 
 assign free_o  = free;
 assign avail_o = avail;
 
+generate
+  if (READ_WIDTH == 2) begin
+    wire [$clog2(FIFO_DEPTH):0] level_rd = wr_pnt - rd_pnt;
+    assign avail2_o = (level_rd >= 2) ? 1'b1 : 1'b0;
+    assign re2      = re2_i & avail2_o;
+  end else begin
+    assign avail2_o = 1'b0;
+    assign re2      = 1'b0;
+  end
+endgenerate
+
 
 // half full?
 generate
@@ -130,7 +168,24 @@ generate
         fifo_mem <= data_i;
       end
     end
-    assign data_o = fifo_mem; // async. read!
+    assign data_o  = fifo_mem; // async. read!
+    assign data2_o = {FIFO_WIDTH{1'b0}};
+
+  end else if (WRITE_WIDTH == 2) begin // two entries per write
+
+    reg [FIFO_WIDTH-1:0] fifo_mem [0:FIFO_DEPTH-1];
+    wire [$clog2(FIFO_DEPTH)-1:0] wr_pnt_1 = wr_pnt[$clog2(FIFO_DEPTH)-1:0] + we[0];
+    wire [$clog2(FIFO_DEPTH)-1:0] rd_pnt_1 = rd_pnt[$clog2(FIFO_DEPTH)-1:0] + 1'b1;
+    always @(posedge clk_i) begin
+      if (we[0]) begin
+        fifo_mem[wr_pnt[$clog2(FIFO_DEPTH)-1:0]] <= data_i[FIFO_WIDTH-1:0];
+      end
+      if (we[1]) begin
+        fifo_mem[wr_pnt_1] <= data_i[2*FIFO_WIDTH-1:FIFO_WIDTH];
+      end
+    end
+    assign data_o  = fifo_mem[rd_pnt[$clog2(FIFO_DEPTH)-1:0]]; // async. read!
+    assign data2_o = (READ_WIDTH == 2) ? fifo_mem[rd_pnt_1] : {FIFO_WIDTH{1'b0}};
 
   end else begin // implement a "real" FIFO memory (several entries deep)
 
@@ -140,7 +195,9 @@ generate
         fifo_mem[wr_pnt[$clog2(FIFO_DEPTH)-1:0]] <= data_i;
       end
     end
-    assign data_o = fifo_mem[rd_pnt[$clog2(FIFO_DEPTH)-1:0]]; // async. read!
+    wire [$clog2(FIFO_DEPTH)-1:0] rd_pnt_1 = rd_pnt[$clog2(FIFO_DEPTH)-1:0] + 1'b1;
+    assign data_o  = fifo_mem[rd_pnt[$clog2(FIFO_DEPTH)-1:0]]; // async. read!
+    assign data2_o = (READ_WIDTH == 2) ? fifo_mem[rd_pnt_1] : {FIFO_WIDTH{1'b0}};
 
   end
 endgenerate
@@ -18,6 +18,7 @@
 // Version          : 1.0
 // Abstract         : airi5c register file 
 // History          : 20.02.18 - added debug module (Ast)
+//                    17.10.26 - read/write ports of the second issue slot (ASt)
 //
 `include "rv32_opcodes.vh"
 `include "airi5c_arch_options.vh"
@@ -40,6 +41,14 @@ module airi5c_regfile(
   input       [`XPR_LEN-1:0]        wd_i,
   input       [`XPR_LEN-1:0]        wd2_i,
   input                             use_rd64_i,
+  // second issue slot (DUAL_ISSUE), integer registers only
+  input       [`REG_ADDR_WIDTH-1:0] ra4_i,
+  output      [`XPR_LEN-1:0]        rd4_o,
+  input       [`REG_ADDR_WIDTH-1:0] ra5_i,
+  output      [`XPR_LEN-1:0]        rd5_o,
+  input                             wen_b_i,
+  input       [`REG_ADDR_WIDTH-1:0] wa_b_i,
+  input       [`XPR_LEN-1:0]        wd_b_i,
 `ifdef ISA_EXT_F
   input                             sel_fpu_rs1_i,
   input                             sel_fpu_rs2_i,
@@ -95,6 +104,15 @@ module airi5c_regfile(
   assign  rd2_o = |ra2_i ? data[ra2_i] : 0;
   assign  rd3_o = |ra3_i ? data[ra3_i] : 0;
 `endif
+`ifdef ISA_EXT_E
+  // DUAL_ISSUE is forced off with ISA_EXT_E, keep the ports in range anyway
+  assign  rd4_o = |ra4_i ? data[ra4_i[3:0]] : 0;
+  assign  rd5_o = |ra5_i ? data[ra5_i[3:0]] : 0;
+`else
+  assign  rd4_o = |ra4_i ? data[ra4_i] : 0;
+  assign  rd5_o = |ra5_i ? data[ra5_i] : 0;
+`endif
+
   integer i;
 
   always @(*) begin
@@ -117,9 +135,10 @@ module airi5c_regfile(
 
 `ifdef ISA_EXT_F
   always @(wen_i or dm_wen_i or dm_wd_i or wd_i or wd2_i or rst_ni or dm_wara_i or wa_i or use_rd64_i\
-                 or dm_sel_fpu_reg_i or sel_fpu_rd_i) begin
+                 or wen_b_i or wa_b_i or wd_b_i or dm_sel_fpu_reg_i or sel_fpu_rd_i) begin
 `else 
-  always @(wen_i or dm_wen_i or dm_wd_i or wd_i or wd2_i or rst_ni or dm_wara_i or wa_i or use_rd64_i) begin
+  always @(wen_i or dm_wen_i or dm_wd_i or wd_i or wd2_i or rst_ni or dm_wara_i or wa_i or use_rd64_i\
+                 or wen_b_i or wa_b_i or wd_b_i) begin
 `endif
 
 `else
@@ -173,6 +192,15 @@ module airi5c_regfile(
         end
       `endif
       end
+
+      // second write port, never the same register as the first one
+      if (wen_b_i && !dm_wen_i) begin
+      `ifdef ISA_EXT_E
+        data[wa_b_i[3:0]] <= wd_b_i;
+      `else
+        data[wa_b_i] <= wd_b_i;
+      `endif
+      end
     end
   end
 
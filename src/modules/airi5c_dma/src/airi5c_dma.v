@@ -0,0 +1,310 @@
+//
+// Copyright 2022 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File              : airi5c_dma.v
+// Author            : A. Stanitzki
+// Creation Date     : 16.10.26
+// Version           : 1.0
+// Abstract          : Multi channel DMA controller. Each channel copies
+//                     LEN items of 1, 2 or 4 bytes from SRC to DST via an
+//                     AHB-Lite master port (memory -> memory, memory ->
+//                     peripheral, peripheral -> memory). An optional
+//                     handshake with a peripheral FIFO request line
+//                     paces the transfer, so a channel never over-/
+//                     underflows a peripheral FIFO.
+// Notes             : Register map (per channel, BASE_ADDR + 32*n):
+//                       0x00 SRC   source address
+//                       0x04 DST   destination address
+//                       0x08 LEN   remaining number of items
+//                       0x0C CTRL  [0] enable / busy, [1] interrupt enable,
+//                                  [3:2] item size (0: byte, 1: half, 2: word),
+//                                  [4] increment SRC, [5] increment DST,
+//                                  [6] handshake enable, [11:8] request select
+//                       0x10 STAT  [0] done, [1] bus error (write 1 to clear),
+//                                  [2] busy (read-only)
+//                     Channels are served round robin, one item at a time.
+//
+
+`include "airi5c_hasti_constants.vh"
+
+module airi5c_dma
+  #(
+    parameter BASE_ADDR   = 32'hC0000900,
+    parameter CHANNELS    = 2,    // has to be a power of 2, min 2, max 8
+    parameter DREQ_COUNT  = 4     // number of peripheral request lines, max 16
+  )
+(
+  // system clk and reset
+  input                                   nreset,
+  input                                   clk,
+
+  // peripheral requests (1 = peripheral can accept / provide an item)
+  input       [DREQ_COUNT-1:0]            dreq,
+
+  // completion interrupt (any channel)
+  output                                  int_any,
+
+  // AHB-Lite master port
+  output      [`HASTI_ADDR_WIDTH-1:0]     m_haddr,
+  output                                  m_hwrite,
+  output      [`HASTI_SIZE_WIDTH-1:0]     m_hsize,
+  output      [`HASTI_TRANS_WIDTH-1:0]    m_htrans,
+  output      [`HASTI_BUS_WIDTH-1:0]      m_hwdata,
+  input       [`HASTI_BUS_WIDTH-1:0]      m_hrdata,
+  input                                   m_hgrant,
+  input                                   m_hready,
+  input       [`HASTI_RESP_WIDTH-1:0]     m_hresp,
+
+  // AHB-Lite slave port (register interface)
+  input       [`HASTI_ADDR_WIDTH-1:0]     haddr,
+  input                                   hwrite,
+  input       [`HASTI_TRANS_WIDTH-1:0]    htrans,
+  input       [`HASTI_BUS_WIDTH-1:0]      hwdata,
+  output  reg [`HASTI_BUS_WIDTH-1:0]      hrdata,
+  output                                  hready,
+  output      [`HASTI_RESP_WIDTH-1:0]     hresp
+);
+
+localparam  CL_CHANNELS = $clog2(CHANNELS);
+
+localparam  REG_SRC     = 3'd0;
+localparam  REG_DST     = 3'd1;
+localparam  REG_LEN     = 3'd2;
+localparam  REG_CTRL    = 3'd3;
+localparam  REG_STAT    = 3'd4;
+
+localparam  IDLE        = 3'd0;
+localparam  RD_ADDR     = 3'd1;
+localparam  RD_DATA     = 3'd2;
+localparam  WR_ADDR     = 3'd3;
+localparam  WR_DATA     = 3'd4;
+localparam  HS_WAIT     = 3'd5;
+
+// cycles to wait after a handshaked item, until the
+// FIFO status of the peripheral reflects the access
+localparam  HS_DELAY    = 2'd2;
+
+// channel registers
+reg   [31:0]  src     [0:CHANNELS-1];
+reg   [31:0]  dst     [0:CHANNELS-1];
+reg   [31:0]  len     [0:CHANNELS-1];
+reg   [1:0]   size    [0:CHANNELS-1];
+reg   [3:0]   hs_sel  [0:CHANNELS-1];
+reg   [CHANNELS-1:0]  busy;
+reg   [CHANNELS-1:0]  ie;
+reg   [CHANNELS-1:0]  src_inc;
+reg   [CHANNELS-1:0]  dst_inc;
+reg   [CHANNELS-1:0]  hs_en;
+reg   [CHANNELS-1:0]  done;
+reg   [CHANNELS-1:0]  error;
+
+// transfer engine
+reg   [2:0]               state;
+reg   [CL_CHANNELS-1:0]   cur;
+reg   [31:0]              data;
+reg                       item_err;
+reg   [1:0]               hs_cnt;
+
+// ===================
+// = register access =
+// ===================
+
+reg   [`HASTI_ADDR_WIDTH-1:0]   haddr_r;
+reg                             hwrite_r;
+reg   [`HASTI_TRANS_WIDTH-1:0]  htrans_r;
+
+always @(posedge clk or negedge nreset) begin
+  if(~nreset) begin
+    haddr_r   <= 0;
+    hwrite_r  <= 1'b0;
+    htrans_r  <= `HASTI_TRANS_IDLE;
+  end else begin
+    haddr_r   <= haddr;
+    hwrite_r  <= hwrite;
+    htrans_r  <= htrans;
+  end
+end
+
+wire                    wr_sel  = hwrite_r && htrans_r[1] && ((haddr_r >> 8) == (BASE_ADDR >> 8));
+wire  [7:0]             wr_offs = haddr_r[7:0] - BASE_ADDR;
+wire  [2:0]             wr_ch   = wr_offs[7:5];
+wire  [2:0]             wr_reg  = wr_offs[4:2];
+
+wire                    rd_sel  = htrans[1] && ((haddr >> 8) == (BASE_ADDR >> 8));
+wire  [7:0]             rd_offs = haddr[7:0] - BASE_ADDR;
+wire  [2:0]             rd_ch   = rd_offs[7:5];
+wire  [2:0]             rd_reg  = rd_offs[4:2];
+
+always @(posedge clk or negedge nreset) begin
+  if(~nreset) begin
+    hrdata <= 0;
+  end else if(rd_sel) begin
+    hrdata <= 0;
+    if(rd_ch < CHANNELS) begin
+      case(rd_reg)
+        REG_SRC   : hrdata <= src[rd_ch];
+        REG_DST   : hrdata <= dst[rd_ch];
+        REG_LEN   : hrdata <= len[rd_ch];
+        REG_CTRL  : hrdata <= {20'h0, hs_sel[rd_ch], 1'b0, hs_en[rd_ch], dst_inc[rd_ch],
+                               src_inc[rd_ch], size[rd_ch], ie[rd_ch], busy[rd_ch]};
+        REG_STAT  : hrdata <= {29'h0, busy[rd_ch], error[rd_ch], done[rd_ch]};
+        default   : ;
+      endcase
+    end
+  end
+end
+
+// the register interface never issues wait states
+assign hready = 1'b1;
+assign hresp  = `HASTI_RESP_OKAY;
+
+assign int_any = |(done & ie);
+
+// ===================
+// = transfer engine =
+// ===================
+
+// a channel is ready, if it is enabled and its peripheral
+// request (if used) is asserted
+reg   [CHANNELS-1:0]      ready;
+reg                       pick_valid;
+reg   [CL_CHANNELS-1:0]   pick;
+integer i, k, n;
+
+always @* begin : channel_select
+  for (i = 0; i < CHANNELS; i = i + 1)
+    ready[i] = busy[i] && (!hs_en[i] || ((hs_sel[i] < DREQ_COUNT) && dreq[hs_sel[i]]));
+  // round robin, starting with the channel after the last one served
+  pick_valid  = 1'b0;
+  pick        = cur;
+  for (k = CHANNELS; k > 0; k = k - 1) begin
+    if(ready[(cur + k) & (CHANNELS-1)]) begin
+      pick_valid  = 1'b1;
+      pick        = (cur + k) & (CHANNELS-1);
+    end
+  end
+end
+
+wire  [1:0]   cur_size  = size[cur];
+wire  [31:0]  rd_shift  = m_hrdata >> {src[cur][1:0], 3'b000};
+wire  [31:0]  rd_item   = (cur_size == 2'd0) ? {24'h0, rd_shift[7:0]}  :
+                          (cur_size == 2'd1) ? {16'h0, rd_shift[15:0]} :
+                                               m_hrdata;
+wire  [31:0]  step      = 32'd1 << cur_size;
+
+assign m_haddr  = (state == RD_ADDR) ? src[cur] : dst[cur];
+assign m_hwrite = (state == WR_ADDR);
+assign m_hsize  = {1'b0, cur_size};
+assign m_htrans = ((state == RD_ADDR) || (state == WR_ADDR)) ? `HASTI_TRANS_NONSEQ : `HASTI_TRANS_IDLE;
+assign m_hwdata = (cur_size == 2'd0) ? {4{data[7:0]}}  :
+                  (cur_size == 2'd1) ? {2{data[15:0]}} :
+                                       data;
+
+always @(posedge clk or negedge nreset) begin
+  if(~nreset) begin
+    state     <= IDLE;
+    cur       <= 0;
+    data      <= 0;
+    item_err  <= 1'b0;
+    hs_cnt    <= 0;
+    busy      <= 0;
+    ie        <= 0;
+    src_inc   <= 0;
+    dst_inc   <= 0;
+    hs_en     <= 0;
+    done      <= 0;
+    error     <= 0;
+    for (n = 0; n < CHANNELS; n = n + 1) begin
+      src[n]    <= 0;
+      dst[n]    <= 0;
+      len[n]    <= 0;
+      size[n]   <= 0;
+      hs_sel[n] <= 0;
+    end
+  end else begin
+    case(state)
+      IDLE    : begin
+                  if(pick_valid) begin
+                    cur       <= pick;
+                    item_err  <= 1'b0;
+                    state     <= RD_ADDR;
+                  end
+                end
+      RD_ADDR : begin
+                  if(m_hgrant && m_hready) begin
+                    item_err  <= m_hresp == `HASTI_RESP_ERROR;
+                    state     <= RD_DATA;
+                  end
+                end
+      RD_DATA : begin
+                  if(m_hready) begin
+                    data      <= rd_item;
+                    state     <= WR_ADDR;
+                  end
+                end
+      WR_ADDR : begin
+                  if(m_hgrant && m_hready) begin
+                    item_err  <= item_err || (m_hresp == `HASTI_RESP_ERROR);
+                    state     <= WR_DATA;
+                  end
+                end
+      WR_DATA : begin
+                  if(m_hready) begin
+                    if(src_inc[cur]) src[cur] <= src[cur] + step;
+                    if(dst_inc[cur]) dst[cur] <= dst[cur] + step;
+                    len[cur] <= len[cur] - 1;
+                    if(item_err || (len[cur] == 1)) begin
+                      busy[cur]   <= 1'b0;
+                      done[cur]   <= 1'b1;
+                      error[cur]  <= item_err;
+                    end
+                    hs_cnt  <= HS_DELAY;
+                    state   <= hs_en[cur] ? HS_WAIT : IDLE;
+                  end
+                end
+      HS_WAIT : begin
+                  hs_cnt <= hs_cnt - 1;
+                  if(hs_cnt == 1)
+                    state <= IDLE;
+                end
+      default : state <= IDLE;
+    endcase
+
+    // bus writes take precedence over engine updates
+    if(wr_sel && (wr_ch < CHANNELS)) begin
+      case(wr_reg)
+        REG_SRC   : src[wr_ch] <= hwdata;
+        REG_DST   : dst[wr_ch] <= hwdata;
+        REG_LEN   : len[wr_ch] <= hwdata;
+        REG_CTRL  : begin
+                      // a zero length transfer is done immediately
+                      busy[wr_ch]     <= hwdata[0] && (len[wr_ch] != 0);
+                      done[wr_ch]     <= (hwdata[0] && (len[wr_ch] == 0)) || done[wr_ch];
+                      ie[wr_ch]       <= hwdata[1];
+                      size[wr_ch]     <= (hwdata[3:2] == 2'd3) ? 2'd2 : hwdata[3:2];
+                      src_inc[wr_ch]  <= hwdata[4];
+                      dst_inc[wr_ch]  <= hwdata[5];
+                      hs_en[wr_ch]    <= hwdata[6];
+                      hs_sel[wr_ch]   <= hwdata[11:8];
+                    end
+        REG_STAT  : begin
+                      done[wr_ch]     <= done[wr_ch]  && !hwdata[0];
+                      error[wr_ch]    <= error[wr_ch] && !hwdata[1];
+                    end
+        default   : ;
+      endcase
+    end
+  end
+end
+
+endmodule
@@ -0,0 +1,122 @@
+//
+// Copyright 2022 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File              : airi5c_dma_arbiter.v
+// Author            : A. Stanitzki
+// Creation Date     : 16.10.26
+// Version           : 1.0
+// Abstract          : Fixed priority AHB-Lite arbiter that shares the
+//                     DMEM bus between the core (high priority) and
+//                     the DMA master (low priority).
+// Notes             : The DMA is granted the address phase only in
+//                     cycles in which the core neither requests a
+//                     transfer nor has a data phase outstanding. A
+//                     granted DMA address phase is held while hready is
+//                     low (re-arbitration only at hready high), a core
+//                     request in that time waits (core_hready low) until
+//                     the DMA address phase has been accepted. The core
+//                     has no data phase in progress then, so its hready
+//                     only stalls the new request. hwdata is routed by
+//                     the owner of the current data phase.
+//
+
+`include "airi5c_hasti_constants.vh"
+
+module airi5c_dma_arbiter
+(
+  input                                 clk,
+  input                                 nreset,
+
+  // core master port (high priority)
+  input       [`HASTI_ADDR_WIDTH-1:0]   core_haddr,
+  input                                 core_hwrite,
+  input       [`HASTI_SIZE_WIDTH-1:0]   core_hsize,
+  input       [`HASTI_BURST_WIDTH-1:0]  core_hburst,
+  input                                 core_hmastlock,
+  input       [`HASTI_PROT_WIDTH-1:0]   core_hprot,
+  input       [`HASTI_TRANS_WIDTH-1:0]  core_htrans,
+  input       [`HASTI_BUS_WIDTH-1:0]    core_hwdata,
+  output                                core_hready,
+  output      [`HASTI_RESP_WIDTH-1:0]   core_hresp,
+
+  // dma master port (low priority)
+  input       [`HASTI_ADDR_WIDTH-1:0]   dma_haddr,
+  input                                 dma_hwrite,
+  input       [`HASTI_SIZE_WIDTH-1:0]   dma_hsize,
+  input       [`HASTI_TRANS_WIDTH-1:0]  dma_htrans,
+  input       [`HASTI_BUS_WIDTH-1:0]    dma_hwdata,
+  output                                dma_hgrant,   // address phase accepted (together with hready)
+  output                                dma_hready,
+  output      [`HASTI_RESP_WIDTH-1:0]   dma_hresp,
+
+  // shared slave bus
+  output      [`HASTI_ADDR_WIDTH-1:0]   haddr,
+  output                                hwrite,
+  output      [`HASTI_SIZE_WIDTH-1:0]   hsize,
+  output      [`HASTI_BURST_WIDTH-1:0]  hburst,
+  output                                hmastlock,
+  output      [`HASTI_PROT_WIDTH-1:0]   hprot,
+  output      [`HASTI_TRANS_WIDTH-1:0]  htrans,
+  output      [`HASTI_BUS_WIDTH-1:0]    hwdata,
+  input                                 hready,
+  input       [`HASTI_RESP_WIDTH-1:0]   hresp
+);
+
+// the core owns the address phase whenever it requests a transfer
+// or the dma is idle, so the core signals pass through unchanged
+// if no dma transfer is pending.
+wire  core_req      = core_htrans[1];
+wire  dma_sel;
+
+// owner of the current data phase
+reg   dma_data_phase;
+reg   core_data_phase;
+// dma address phase waiting for hready, keep the grant
+reg   dma_hold;
+
+always @(posedge clk or negedge nreset) begin
+  if(~nreset) begin
+    dma_data_phase  <= 1'b0;
+    core_data_phase <= 1'b0;
+    dma_hold        <= 1'b0;
+  end else begin
+    dma_hold <= dma_sel && !hready;
+    if(hready) begin
+      dma_data_phase  <= dma_sel;
+      core_data_phase <= !dma_sel && core_req;
+    end
+  end
+end
+
+assign dma_sel      = dma_hold || (!core_req && !core_data_phase && dma_htrans[1]);
+
+assign haddr        = dma_sel ? dma_haddr             : core_haddr;
+assign hwrite       = dma_sel ? dma_hwrite            : core_hwrite;
+assign hsize        = dma_sel ? dma_hsize             : core_hsize;
+assign hburst       = dma_sel ? `HASTI_BURST_SINGLE   : core_hburst;
+assign hmastlock    = dma_sel ? `HASTI_MASTER_NO_LOCK : core_hmastlock;
+assign hprot        = dma_sel ? `HASTI_NO_PROT        : core_hprot;
+assign htrans       = dma_sel ? dma_htrans            : core_htrans;
+assign hwdata       = dma_data_phase ? dma_hwdata : core_hwdata;
+
+// hready is shared, a stalled data phase stalls both masters.
+// The peripheral mux reports hresp along with the address phase,
+// so it is returned to the master that currently owns it.
+assign core_hready  = hready && !(dma_hold && core_req);
+assign core_hresp   = dma_sel ? `HASTI_RESP_OKAY : hresp;
+
+assign dma_hgrant   = dma_sel;
+assign dma_hready   = hready;
+assign dma_hresp    = dma_sel ? hresp : `HASTI_RESP_OKAY;
+
+endmodule
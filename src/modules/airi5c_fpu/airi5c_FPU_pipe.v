@@ -0,0 +1,592 @@
+//
+// Copyright 2022 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+
+`include "airi5c_FPU_constants.vh"
+
+/* Pipelined FADD/FSUB/FMUL and fused FMADD/FMSUB/FNMADD/FNMSUB (FPU_PIPELINED).
+ *
+ * Every operation is computed as x * y + z with a single rounding:
+ * add/sub use y = 1.0, mul has no addend (z is ignored). Five stages, one
+ * operation can be loaded per cycle:
+ *
+ *   1: operands             split, pre-normalize, special cases, 24x24 product
+ *   2: product              normalize product, order by magnitude, align smaller operand
+ *   3: aligned operands     add/subtract (50 bit + sticky)
+ *   4: sum                  normalize, denormalize tiny results
+ *   5: result               rounding, overflow/underflow (late_wr)
+ *
+ * A stage moves on when the next one is empty or moves on as well, the last
+ * stage waits for late_ack (register file write port, see airi5c_pipeline.v).
+ */
+
+module airi5c_FPU_pipe
+(
+    input               clk,
+    input               n_reset,
+    input               load,
+
+    input       [4:0]   op,
+    input       [2:0]   rm,
+    input       [4:0]   rd,
+
+    input       [31:0]  a,
+    input       [31:0]  b,
+    input       [31:0]  c,
+
+    output              accept,
+
+    output              late_wr,
+    output      [4:0]   late_wa,
+    output  reg [31:0]  result,
+
+    output  reg         IV,
+    output  reg         OF,
+    output  reg         UF,
+    output  reg         IE,
+
+    input               late_ack
+);
+
+    // stage valid and move
+    reg                 s1_v, s2_v, s3_v, s4_v, s5_v;
+    wire                s1_move, s2_move, s3_move, s4_move;
+
+    // special results (NaN, inf, zero, exact addend) bypass the datapath
+    reg                 s1_final, s2_final, s3_final, s4_final, s5_final;
+    reg         [31:0]  s1_res, s2_res, s3_res, s4_res, s5_res;
+    reg                 s1_IV, s2_IV, s3_IV, s4_IV, s5_IV;
+    reg         [2:0]   s1_rm, s2_rm, s3_rm, s4_rm, s5_rm;
+    reg         [4:0]   s1_rd, s2_rd, s3_rd, s4_rd, s5_rd;
+
+    // stage 1: operands
+    reg         [31:0]  s1_a;
+    reg         [31:0]  s1_b;
+    reg         [31:0]  s1_c;
+    reg                 s1_add;     // with addend
+    reg                 s1_neg_p;   // negate product
+
+    // stage 2: product
+    reg         [47:0]  s2_prod;
+    reg  signed [9:0]   s2_exp_p;
+    reg                 s2_sgn_p;
+    reg         [23:0]  s2_man_z;
+    reg  signed [9:0]   s2_exp_z;
+    reg                 s2_sgn_z;
+    reg                 s2_add;
+
+    // stage 3: aligned operands
+    reg         [49:0]  s3_big;
+    reg         [49:0]  s3_small;
+    reg                 s3_sticky;
+    reg                 s3_sub;
+    reg                 s3_sgn;
+    reg  signed [9:0]   s3_exp;
+
+    // stage 4: sum
+    reg         [50:0]  s4_sum;
+    reg                 s4_sticky;
+    reg                 s4_sgn;
+    reg  signed [9:0]   s4_exp;
+
+    // stage 5: result
+    reg         [22:0]  s5_man;
+    reg         [9:0]   s5_exp;
+    reg                 s5_sgn;
+    reg                 s5_round_bit;
+    reg                 s5_sticky_bit;
+    reg                 s5_equal;
+    reg                 s5_less;
+
+    assign              s4_move = s4_v && (!s5_v || late_ack);
+    assign              s3_move = s3_v && (!s4_v || s4_move);
+    assign              s2_move = s2_v && (!s3_v || s3_move);
+    assign              s1_move = s1_v && (!s2_v || s2_move);
+    assign              accept  = !s1_v || s1_move;
+
+    assign              late_wr = s5_v;
+    assign              late_wa = s5_rd;
+
+    // ------------------------------------------------------------------
+    // stage 1
+    // ------------------------------------------------------------------
+
+    wire                op_add_sub = op == `FPU_OP_ADD || op == `FPU_OP_SUB;
+
+    wire        [23:0]  man_x, man_y, man_z;
+    wire        [7:0]   exp_x, exp_y, exp_z;
+    wire                sgn_x, sgn_y, sgn_z;
+    wire                zero_x, zero_y, zero_z;
+    wire                inf_x, inf_y, inf_z;
+    wire                sNaN_x, sNaN_y, sNaN_z;
+    wire                qNaN_x, qNaN_y, qNaN_z;
+    wire                denormal_x, denormal_y, denormal_z;
+    wire        [23:0]  man_x_norm, man_y_norm, man_z_norm;
+    wire signed [9:0]   exp_x_norm, exp_y_norm, exp_z_norm;
+
+    wire                sgn_p   = sgn_x ^ sgn_y ^ s1_neg_p;
+    wire                IV_int  = sNaN_x || sNaN_y || (s1_add && sNaN_z) ||
+                                  (inf_x && zero_y) || (zero_x && inf_y) ||
+                                  (s1_add && (inf_x || inf_y) && inf_z && (sgn_p != sgn_z) && !(qNaN_x || qNaN_y));
+
+    reg                 sp_final;
+    reg         [31:0]  sp_res;
+
+    always @(*) begin
+        sp_final    = 1'b1;
+        sp_res      = 32'h7fc00000;
+
+        // NaN
+        if (IV_int || qNaN_x || qNaN_y || (s1_add && qNaN_z))
+            sp_res  = 32'h7fc00000;
+        // inf
+        else if (inf_x || inf_y)
+            sp_res  = {sgn_p, 31'h7f800000};
+
+        else if (s1_add && inf_z)
+            sp_res  = {sgn_z, 31'h7f800000};
+        // zero product
+        else if (zero_x || zero_y) begin
+            if (!s1_add)
+                sp_res  = {sgn_p, 31'h00000000};
+
+            else if (zero_z)
+                sp_res  = {sgn_p == sgn_z ? sgn_p : s1_rm == `FPU_RM_RDN, 31'h00000000};
+            // z is exact
+            else
+                sp_res  = s1_c;
+        end
+
+        else
+            sp_final    = 1'b0;
+    end
+
+    always @(posedge clk, negedge n_reset) begin
+        if (!n_reset) begin
+            s1_v        <= 1'b0;
+            s1_a        <= 32'h00000000;
+            s1_b        <= 32'h00000000;
+            s1_c        <= 32'h00000000;
+            s1_add      <= 1'b0;
+            s1_neg_p    <= 1'b0;
+            s1_rm       <= 3'b000;
+            s1_rd       <= 5'd0;
+        end
+
+        else if (load) begin
+            s1_v        <= 1'b1;
+            s1_a        <= a;
+            s1_b        <= op_add_sub ? 32'h3f800000 : b;
+            s1_c        <= op_add_sub ? {b[31] ^ (op == `FPU_OP_SUB), b[30:0]} :
+                                        {c[31] ^ (op == `FPU_OP_MSUB || op == `FPU_OP_NMADD), c[30:0]};
+            s1_add      <= op != `FPU_OP_MUL;
+            s1_neg_p    <= op == `FPU_OP_NMSUB || op == `FPU_OP_NMADD;
+            s1_rm       <= rm;
+            s1_rd       <= rd;
+        end
+
+        else if (s1_move)
+            s1_v        <= 1'b0;
+    end
+
+    // ------------------------------------------------------------------
+    // stage 2
+    // ------------------------------------------------------------------
+
+    always @(posedge clk, negedge n_reset) begin
+        if (!n_reset) begin
+            s2_v        <= 1'b0;
+            s2_prod     <= 48'h000000000000;
+            s2_exp_p    <= 10'h000;
+            s2_sgn_p    <= 1'b0;
+            s2_man_z    <= 24'h000000;
+            s2_exp_z    <= 10'h000;
+            s2_sgn_z    <= 1'b0;
+            s2_add      <= 1'b0;
+            s2_final    <= 1'b0;
+            s2_res      <= 32'h00000000;
+            s2_IV       <= 1'b0;
+            s2_rm       <= 3'b000;
+            s2_rd       <= 5'd0;
+        end
+
+        else if (s1_move) begin
+            s2_v        <= 1'b1;
+            s2_prod     <= man_x_norm * man_y_norm;
+            s2_exp_p    <= exp_x_norm + exp_y_norm;
+            s2_sgn_p    <= sgn_p;
+            s2_man_z    <= man_z_norm;
+            s2_exp_z    <= exp_z_norm;
+            s2_sgn_z    <= sgn_z;
+            s2_add      <= s1_add && !zero_z;   // a zero addend does not change a nonzero product
+            s2_final    <= sp_final;
+            s2_res      <= sp_res;
+            s2_IV       <= IV_int;
+            s2_rm       <= s1_rm;
+            s2_rd       <= s1_rd;
+        end
+
+        else if (s2_move)
+            s2_v        <= 1'b0;
+    end
+
+    // ------------------------------------------------------------------
+    // stage 3
+    // ------------------------------------------------------------------
+
+    // product and addend as 1.xxx (48 bit) with exponent
+    wire        [47:0]  man_p   = s2_prod[47] ? s2_prod : {s2_prod[46:0], 1'b0};
+    wire signed [9:0]   exp_p   = s2_exp_p + {9'h000, s2_prod[47]};
+    wire        [47:0]  man_z48 = {s2_man_z, 24'h000000};
+
+    // swap if abs(z) > abs(product), the difference is then always >= 0
+    wire                swap    = s2_add && ((s2_exp_z > exp_p) || ((s2_exp_z == exp_p) && (man_z48 > man_p)));
+    wire        [47:0]  man_big = swap ? man_z48 : man_p;
+    wire        [47:0]  man_sml = swap ? man_p : man_z48;
+    wire signed [9:0]   exp_big = swap ? s2_exp_z : exp_p;
+    wire        [9:0]   align   = swap ? s2_exp_z - exp_p : exp_p - s2_exp_z;
+
+    wire        [49:0]  shifter_out;
+    wire                sticky_bit_align;
+
+    always @(posedge clk, negedge n_reset) begin
+        if (!n_reset) begin
+            s3_v        <= 1'b0;
+            s3_big      <= 50'h0000000000000;
+            s3_small    <= 50'h0000000000000;
+            s3_sticky   <= 1'b0;
+            s3_sub      <= 1'b0;
+            s3_sgn      <= 1'b0;
+            s3_exp      <= 10'h000;
+            s3_final    <= 1'b0;
+            s3_res      <= 32'h00000000;
+            s3_IV       <= 1'b0;
+            s3_rm       <= 3'b000;
+            s3_rd       <= 5'd0;
+        end
+
+        else if (s2_move) begin
+            s3_v        <= 1'b1;
+            s3_big      <= {man_big, 2'b00};
+            s3_small    <= s2_add ? shifter_out : 50'h0000000000000;
+            s3_sticky   <= s2_add && sticky_bit_align;
+            s3_sub      <= s2_add && (s2_sgn_p ^ s2_sgn_z);
+            s3_sgn      <= swap ? s2_sgn_z : s2_sgn_p;
+            s3_exp      <= exp_big;
+            s3_final    <= s2_final;
+            s3_res      <= s2_res;
+            s3_IV       <= s2_IV;
+            s3_rm       <= s2_rm;
+            s3_rd       <= s2_rd;
+        end
+
+        else if (s3_move)
+            s3_v        <= 1'b0;
+    end
+
+    airi5c_rshifter #(50, 6) rshifter_align_inst
+    (
+        .in({man_sml, 2'b00}),
+        .sel(|align[9:6] ? 6'b111111 : align[5:0]),
+        .sgn(1'b0),
+
+        .out(shifter_out),
+        .sticky_bit(sticky_bit_align)
+    );
+
+    // ------------------------------------------------------------------
+    // stage 4
+    // ------------------------------------------------------------------
+
+    /* A sticky bit lost in the alignment of a subtracted operand lowers the
+     * exact difference by less than one LSB: big - small - 1 with sticky set.
+     * For alignments of 0 or 1 (the only cases with cancellation of more than
+     * one bit) the sticky bit is always 0.
+     */
+    always @(posedge clk, negedge n_reset) begin
+        if (!n_reset) begin
+            s4_v        <= 1'b0;
+            s4_sum      <= 51'h0000000000000;
+            s4_sticky   <= 1'b0;
+            s4_sgn      <= 1'b0;
+            s4_exp      <= 10'h000;
+            s4_final    <= 1'b0;
+            s4_res      <= 32'h00000000;
+            s4_IV       <= 1'b0;
+            s4_rm       <= 3'b000;
+            s4_rd       <= 5'd0;
+        end
+
+        else if (s3_move) begin
+            s4_v        <= 1'b1;
+            s4_sum      <= s3_sub ? {1'b0, s3_big} - {1'b0, s3_small} - {50'h0000000000000, s3_sticky} :
+                                    {1'b0, s3_big} + {1'b0, s3_small};
+            s4_sticky   <= s3_sticky;
+            s4_sgn      <= s3_sgn;
+            s4_exp      <= s3_exp;
+            s4_final    <= s3_final;
+            s4_res      <= s3_res;
+            s4_IV       <= s3_IV;
+            s4_rm       <= s3_rm;
+            s4_rd       <= s3_rd;
+        end
+
+        else if (s4_move)
+            s4_v        <= 1'b0;
+    end
+
+    // ------------------------------------------------------------------
+    // stage 5
+    // ------------------------------------------------------------------
+
+    // count leading zeros
+    function [5:0] clz51;
+        input [50:0] x;
+        integer i;
+        begin
+            clz51 = 6'd51;
+            for (i = 0; i < 51; i = i + 1)
+                if (x[i])
+                    clz51 = 6'd50 - i;
+        end
+    endfunction
+
+    wire        [5:0]   leading_zeros = clz51(s4_sum);
+    wire        [50:0]  sum_norm      = s4_sum << leading_zeros;
+    wire                zero_sum      = ~|s4_sum;   // exact cancellation
+
+    // sum_norm[50] is the hidden bit, the binary point of s4_sum is at bit 49
+    wire        [23:0]  man_n         = sum_norm[50:27];
+    wire                round_bit_n   = sum_norm[26];
+    wire                sticky_bit_n  = |sum_norm[25:0] || s4_sticky;
+
+    reg         [9:0]   exp_biased;
+    reg                 equal;
+    reg                 less;
+    reg         [9:0]   offset;
+
+    wire        [24:0]  shifter_dn_out;
+    wire                sticky_bit_dn;
+
+    // same as the input logic of airi5c_post_processing
+    always @(*) begin
+        exp_biased  = s4_exp + 10'd1 - {4'h0, leading_zeros} + 10'h07f;
+        equal       = ~|exp_biased;
+        less        = exp_biased[9];
+
+        if (equal || less) begin
+            offset      = 10'd1 - exp_biased;
+            exp_biased  = 10'd0;
+        end
+
+        else
+            offset      = 10'd0;
+    end
+
+    always @(posedge clk, negedge n_reset) begin
+        if (!n_reset) begin
+            s5_v            <= 1'b0;
+            s5_man          <= 23'h000000;
+            s5_exp          <= 10'h000;
+            s5_sgn          <= 1'b0;
+            s5_round_bit    <= 1'b0;
+            s5_sticky_bit   <= 1'b0;
+            s5_equal        <= 1'b0;
+            s5_less         <= 1'b0;
+            s5_final        <= 1'b0;
+            s5_res          <= 32'h00000000;
+            s5_IV           <= 1'b0;
+            s5_rm           <= 3'b000;
+            s5_rd           <= 5'd0;
+        end
+
+        else if (s4_move) begin
+            s5_v            <= 1'b1;
+            s5_man          <= shifter_dn_out[23:1];
+            s5_exp          <= exp_biased;
+            s5_sgn          <= s4_sgn;
+            s5_round_bit    <= shifter_dn_out[0];
+            s5_sticky_bit   <= sticky_bit_n || sticky_bit_dn;
+            s5_equal        <= equal;
+            s5_less         <= less;
+            s5_final        <= s4_final || zero_sum;
+            s5_res          <= s4_final ? s4_res : {s4_rm == `FPU_RM_RDN, 31'h00000000};
+            s5_IV           <= s4_IV;
+            s5_rm           <= s4_rm;
+            s5_rd           <= s4_rd;
+        end
+
+        else if (late_ack)
+            s5_v            <= 1'b0;
+    end
+
+    airi5c_rshifter #(25, 5) rshifter_dn_inst
+    (
+        .in({man_n, round_bit_n}),
+        .sel(|offset[9:5] ? 5'b11111 : offset[4:0]),
+        .sgn(1'b0),
+
+        .out(shifter_dn_out),
+        .sticky_bit(sticky_bit_dn)
+    );
+
+    // output logic (same as airi5c_post_processing)
+    wire        [22:0]  man_rounded;
+    reg         [9:0]   exp_rounded;
+    wire                inc_exp;
+    wire                inexact;
+
+    wire                RTZ = s5_rm == `FPU_RM_RTZ;
+    wire                RDN = s5_rm == `FPU_RM_RDN;
+    wire                RUP = s5_rm == `FPU_RM_RUP;
+
+    always @(*) begin
+        exp_rounded = 10'h000;
+        result      = s5_res;
+        IV          = s5_IV;
+        OF          = 1'b0;
+        UF          = 1'b0;
+        IE          = 1'b0;
+
+        if (!s5_final) begin
+            IV          = 1'b0;
+            exp_rounded = s5_exp + inc_exp;
+
+            // overflow
+            if (&exp_rounded[7:0] || exp_rounded[8] || exp_rounded[9]) begin
+                IE  = 1'b1;
+                OF  = 1'b1;
+
+                // setFmax
+                if (RTZ || (RDN && !s5_sgn) || (RUP && s5_sgn))
+                    result  = {s5_sgn, 31'h7f7fffff};
+
+                // setInf
+                else
+                    result  = {s5_sgn, 31'h7f800000};
+            end
+
+            else begin
+                // underflow
+                if (inexact && ((s5_equal && !inc_exp) || s5_less)) begin
+                    IE  = 1'b1;
+                    UF  = 1'b1;
+                end
+
+                // normal
+                else
+                    IE  = inexact;
+
+                result  = {s5_sgn, exp_rounded[7:0], man_rounded};
+            end
+        end
+    end
+
+    airi5c_rounding_logic #(23) rounding_logic_inst
+    (
+        .rm(s5_rm),
+
+        .sticky_bit(s5_sticky_bit),
+        .round_bit(s5_round_bit),
+
+        .in(s5_man),
+        .sgn(s5_sgn),
+
+        .out(man_rounded),
+        .carry(inc_exp),
+
+        .inexact(inexact)
+    );
+
+    // operands
+    airi5c_splitter splitter_x
+    (
+        .float_in(s1_a),
+
+        .man(man_x),
+        .Exp(exp_x),
+        .sgn(sgn_x),
+
+        .zero(zero_x),
+        .inf(inf_x),
+        .sNaN(sNaN_x),
+        .qNaN(qNaN_x),
+        .denormal(denormal_x)
+    );
+
+    airi5c_pre_normalizer pre_normalizer_x
+    (
+        .zero(zero_x),
+        .denormal(denormal_x),
+
+        .man_in(man_x),
+        .exp_in(exp_x),
+
+        .man_out(man_x_norm),
+        .exp_out(exp_x_norm)
+    );
+
+    airi5c_splitter splitter_y
+    (
+        .float_in(s1_b),
+
+        .man(man_y),
+        .Exp(exp_y),
+        .sgn(sgn_y),
+
+        .zero(zero_y),
+        .inf(inf_y),
+        .sNaN(sNaN_y),
+        .qNaN(qNaN_y),
+        .denormal(denormal_y)
+    );
+
+    airi5c_pre_normalizer pre_normalizer_y
+    (
+        .zero(zero_y),
+        .denormal(denormal_y),
+
+        .man_in(man_y),
+        .exp_in(exp_y),
+
+        .man_out(man_y_norm),
+        .exp_out(exp_y_norm)
+    );
+
+    airi5c_splitter splitter_z
+    (
+        .float_in(s1_c),
+
+        .man(man_z),
+        .Exp(exp_z),
+        .sgn(sgn_z),
+
+        .zero(zero_z),
+        .inf(inf_z),
+        .sNaN(sNaN_z),
+        .qNaN(qNaN_z),
+        .denormal(denormal_z)
+    );
+
+    airi5c_pre_normalizer pre_normalizer_z
+    (
+        .zero(zero_z),
+        .denormal(denormal_z),
+
+        .man_in(man_z),
+        .exp_in(exp_z),
+
+        .man_out(man_z_norm),
+        .exp_out(exp_z_norm)
+    );
+
+endmodule
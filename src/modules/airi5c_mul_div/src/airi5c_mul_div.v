@@ -14,14 +14,472 @@
 // File              : airi5c_mul_div.v 
 // Author            : A. Stanitzki
 // Creation Date     : 09.10.20
-// Last Modified     : 15.02.21
-// Version           : 1.0
+// Last Modified     : 17.10.26
+// Version           : 1.1
 // Abstract          : Implementation of multiplication and division   
+// Notes             : ARCH_M_SCOREBOARD (PCPI_SCOREBOARD): decoupled PCPI
+//                     operation, instructions leave EX when they are accepted
+//                     and write back later (see airi5c_ctrl.v). Pipelined 33x33
+//                     signed multiplier (DSP-inferable, result after 2 cycles,
+//                     one issue per cycle) and a radix-4 divider that skips the
+//                     leading quotient zeros (2 + 0..16 cycles).
+//                     ARCH_M_PIPELINED: same multiplier and divider, EX waits
+//                     for the result (3 cycles MUL, 3 + 0..16 cycles DIV).
+//                     Otherwise: sequential multiplier (ARCH_M_FAST: 2 cycles,
+//                     else 16x16 in 6 cycles) and radix-2 divider (36 cycles),
+//                     EX waits for the result.
 
 
 
 `include "airi5c_hasti_constants.vh"
 
+`ifdef PCPI_SCOREBOARD
+
+module airi5c_mul_div (
+  input                       nreset,
+  input                       clk,
+  input                       pcpi_valid,
+  input       [`XPR_LEN-1:0]  pcpi_insn,
+  input       [`XPR_LEN-1:0]  pcpi_rs1,
+  input       [`XPR_LEN-1:0]  pcpi_rs2,
+  output                      pcpi_wr,
+  output      [`XPR_LEN-1:0]  pcpi_rd,
+  output                      pcpi_wait,
+  output                      pcpi_ready,
+  // decoupled operation (PCPI_SCOREBOARD, see airi5c_ctrl.v)
+  output                      pcpi_accept,    // instruction in EX can be taken now
+  input                       pcpi_issue,     // instruction has been issued (leaves EX)
+  output                      pcpi_late_wr,   // result available
+  output  [`REG_ADDR_WIDTH-1:0] pcpi_late_wa, // destination register of the result
+  output  [`XPR_LEN-1:0]      pcpi_late_rd,
+  input                       pcpi_late_ack   // result has been written to the register file
+);
+
+// insn decoding
+
+wire  [6:0] funct7 = pcpi_insn[31:25];
+wire  [2:0] funct3 = pcpi_insn[14:12];
+wire  [6:0] opcode = pcpi_insn[6:0];
+wire  [`REG_ADDR_WIDTH-1:0] rd = pcpi_insn[11:7];
+
+wire  mul_div_funct = (funct7 == 7'h1) && (opcode == 7'h33);
+wire  inst_mul_any  = mul_div_funct && ~funct3[2];  // mul, mulh, mulhsu, mulhu
+wire  inst_div_any  = mul_div_funct &&  funct3[2];  // div, divu, rem, remu
+
+// Instructions are never executed while they wait in EX: the core issues an
+// instruction once it has been accepted, EX moves on and the result is written
+// back through the late write port. The destination register is marked busy by
+// the core until then. pcpi_wait only claims the instruction (no illegal
+// instruction exception).
+assign pcpi_wr    = 1'b0;
+assign pcpi_rd    = `XPR_LEN'h0; // important to allow wired OR
+assign pcpi_ready = 1'b0;
+assign pcpi_wait  = pcpi_valid && (inst_mul_any || inst_div_any);
+
+
+// Multiplier
+// ----------
+// Signed 33x33 product, operands are sign- or zero-extended according to funct3.
+// Two pipeline stages (operands, product) that map to the input/output registers
+// of a DSP block, a new multiplication can be issued every cycle.
+
+reg                         m1_v, m2_v;             // stage valid
+reg                         m1_hi, m2_hi;           // upper half of the product
+reg [`REG_ADDR_WIDTH-1:0]   m1_wa, m2_wa;
+reg signed [`XPR_LEN:0]     mul_opa_r, mul_opb_r;
+reg signed [2*`XPR_LEN+1:0] product_r;
+
+wire mul_opa_signed = (funct3 == 3'h1) || (funct3 == 3'h2); // mulh, mulhsu
+wire mul_opb_signed = (funct3 == 3'h1);                      // mulh
+
+
+// Divider
+// -------
+// Restoring radix-4 division of the absolute values, two quotient bits per cycle.
+// The first s iterations of a radix-2 division only shift in quotient zeros as long
+// as the upper s dividend bits are smaller than the divisor, this holds for
+// s <= clz(dividend) and for s <= 31 - clz(divisor). These are skipped by
+// preloading {remainder, quotient} with the dividend shifted left by s.
+// One division at a time.
+
+localparam D_IDLE = 2'd0; // wait for a division
+localparam D_INIT = 2'd1; // absolute values, leading zero skip
+localparam D_RUN  = 2'd2; // radix-4 iterations
+localparam D_DONE = 2'd3; // wait for the write back
+
+// count leading zeros
+function [5:0] clz;
+  input [`XPR_LEN-1:0] x;
+  integer i;
+  begin
+    clz = 6'd32;
+    for (i = 0; i < `XPR_LEN; i = i + 1)
+      if (x[i])
+        clz = 6'd31 - i;
+  end
+endfunction
+
+reg  [1:0]          div_state;
+reg  [2:0]          div_op_r;                       // funct3
+reg  [`REG_ADDR_WIDTH-1:0] div_wa_r;
+reg  [`XPR_LEN-1:0] rs1_r, rs2_r;
+reg  [`XPR_LEN-1:0] rem_r, quo_r;
+reg  [`XPR_LEN-1:0] div_d_r;                        // |divisor|
+reg  [`XPR_LEN+1:0] div_d3_r;                       // 3 * |divisor|
+reg  [4:0]          div_cnt_r;                      // remaining iterations
+reg                 div_zero_r, neg_quo_r, neg_rem_r;
+
+wire                op_div_signed = ~div_op_r[0];   // div, rem
+wire                op_rem        =  div_op_r[1];   // rem, remu
+
+wire [`XPR_LEN-1:0] div_a = (op_div_signed & rs1_r[31]) ? -rs1_r : rs1_r;
+wire [`XPR_LEN-1:0] div_d = (op_div_signed & rs2_r[31]) ? -rs2_r : rs2_r;
+wire [5:0]          clz_a = clz(div_a);
+wire [5:0]          clz_d = clz(div_d);
+wire [5:0]          skip_d = 6'd31 - clz_d;
+wire [5:0]          skip   = ((clz_a > skip_d) ? clz_a : skip_d) & 6'b111110; // even, 0..32
+wire [2*`XPR_LEN-1:0] div_init = {`XPR_LEN'h0, div_a} << skip;
+
+// one radix-4 step: remainder < divisor, so the partial remainder is < 4 * divisor
+wire [`XPR_LEN+1:0] part = {rem_r, quo_r[`XPR_LEN-1:`XPR_LEN-2]};
+wire [`XPR_LEN+2:0] sub1 = {1'b0, part} - {3'b000, div_d_r};
+wire [`XPR_LEN+2:0] sub2 = {1'b0, part} - {2'b00, div_d_r, 1'b0};
+wire [`XPR_LEN+2:0] sub3 = {1'b0, part} - {1'b0, div_d3_r};
+
+reg  [`XPR_LEN-1:0] rem_nxt;
+reg  [1:0]          quo_bits;
+
+always @(*) begin
+  if (~sub3[`XPR_LEN+2]) begin
+    rem_nxt  = sub3[`XPR_LEN-1:0];
+    quo_bits = 2'd3;
+  end else if (~sub2[`XPR_LEN+2]) begin
+    rem_nxt  = sub2[`XPR_LEN-1:0];
+    quo_bits = 2'd2;
+  end else if (~sub1[`XPR_LEN+2]) begin
+    rem_nxt  = sub1[`XPR_LEN-1:0];
+    quo_bits = 2'd1;
+  end else begin
+    rem_nxt  = part[`XPR_LEN-1:0];
+    quo_bits = 2'd0;
+  end
+end
+
+wire [`XPR_LEN-1:0] div_result = ~op_rem ? (div_zero_r ? {`XPR_LEN{1'b1}} : (neg_quo_r ? -quo_r : quo_r)) :
+                                           (div_zero_r ? rs1_r : (neg_rem_r ? -rem_r : rem_r));
+
+
+// Result port and issue
+// ---------------------
+// Multiplications have priority, a finished division waits in D_DONE.
+
+wire mul_ack = pcpi_late_ack &  m2_v;
+wire div_ack = pcpi_late_ack & ~m2_v;
+wire m1_move = m1_v & (~m2_v | mul_ack);            // stage 1 -> stage 2
+
+assign pcpi_late_wr = m2_v | (div_state == D_DONE);
+assign pcpi_late_wa = m2_v ? m2_wa : div_wa_r;
+assign pcpi_late_rd = m2_v ? (m2_hi ? product_r[2*`XPR_LEN-1:`XPR_LEN] : product_r[`XPR_LEN-1:0]) : div_result;
+
+assign pcpi_accept  = pcpi_valid && ((inst_mul_any && (~m1_v || m1_move)) ||
+                                     (inst_div_any && (div_state == D_IDLE)));
+
+wire issue_mul = pcpi_issue & inst_mul_any;
+wire issue_div = pcpi_issue & inst_div_any;
+
+always @(posedge clk or negedge nreset) begin
+  if(~nreset) begin
+    m1_v       <= 1'b0;
+    m2_v       <= 1'b0;
+    m1_hi      <= 1'b0;
+    m2_hi      <= 1'b0;
+    m1_wa      <= 0;
+    m2_wa      <= 0;
+    mul_opa_r  <= 0;
+    mul_opb_r  <= 0;
+    product_r  <= 0;
+  end else begin
+    // stage 1: operands
+    if(issue_mul) begin
+      m1_v      <= 1'b1;
+      m1_hi     <= (funct3 != 3'h0);
+      m1_wa     <= rd;
+      mul_opa_r <= {mul_opa_signed & pcpi_rs1[`XPR_LEN-1], pcpi_rs1};
+      mul_opb_r <= {mul_opb_signed & pcpi_rs2[`XPR_LEN-1], pcpi_rs2};
+    end else if(m1_move) begin
+      m1_v      <= 1'b0;
+    end
+    // stage 2: product
+    if(m1_move) begin
+      m2_v      <= 1'b1;
+      m2_hi     <= m1_hi;
+      m2_wa     <= m1_wa;
+      product_r <= mul_opa_r * mul_opb_r;
+    end else if(mul_ack) begin
+      m2_v      <= 1'b0;
+    end
+  end
+end
+
+always @(posedge clk or negedge nreset) begin
+  if(~nreset) begin
+    div_state  <= D_IDLE;
+    div_op_r   <= 3'h0;
+    div_wa_r   <= 0;
+    rs1_r      <= `XPR_LEN'h0;
+    rs2_r      <= `XPR_LEN'h0;
+    rem_r      <= `XPR_LEN'h0;
+    quo_r      <= `XPR_LEN'h0;
+    div_d_r    <= `XPR_LEN'h0;
+    div_d3_r   <= 0;
+    div_cnt_r  <= 5'h0;
+    div_zero_r <= 1'b0;
+    neg_quo_r  <= 1'b0;
+    neg_rem_r  <= 1'b0;
+  end else begin
+    case(div_state)
+      D_IDLE : begin
+        if(issue_div) begin
+          div_op_r  <= funct3;
+          div_wa_r  <= rd;
+          rs1_r     <= pcpi_rs1;
+          rs2_r     <= pcpi_rs2;
+          div_state <= D_INIT;
+        end
+      end
+      D_INIT : begin
+        div_zero_r <= ~(|rs2_r);
+        neg_quo_r  <= op_div_signed & (rs1_r[`XPR_LEN-1] ^ rs2_r[`XPR_LEN-1]);
+        neg_rem_r  <= op_div_signed & rs1_r[`XPR_LEN-1];
+        div_d_r    <= div_d;
+        div_d3_r   <= {2'b00, div_d} + {1'b0, div_d, 1'b0};
+        {rem_r, quo_r} <= div_init;
+        div_cnt_r  <= 5'd16 - skip[5:1];
+        div_state  <= ((~(|rs2_r)) || (skip == 6'd32)) ? D_DONE : D_RUN;
+      end
+      D_RUN : begin
+        rem_r     <= rem_nxt;
+        quo_r     <= {quo_r[`XPR_LEN-3:0], quo_bits};
+        div_cnt_r <= div_cnt_r - 5'd1;
+        if(div_cnt_r == 5'd1)
+          div_state <= D_DONE;
+      end
+      default : begin // D_DONE
+        if(div_ack)
+          div_state <= D_IDLE;
+      end
+    endcase
+  end
+end
+
+endmodule
+
+`elsif ARCH_M_PIPELINED
+
+module airi5c_mul_div (
+  input                       nreset,
+  input                       clk,
+  input                       pcpi_valid,
+  input       [`XPR_LEN-1:0]  pcpi_insn,
+  input       [`XPR_LEN-1:0]  pcpi_rs1,
+  input       [`XPR_LEN-1:0]  pcpi_rs2,
+  output  reg                 pcpi_wr,
+  output  reg [`XPR_LEN-1:0]  pcpi_rd,
+  output  reg                 pcpi_wait,
+  output  reg                 pcpi_ready
+);
+
+localparam S_IDLE     = 3'd0; // wait for an instruction, latch operands
+localparam S_MUL      = 3'd1; // multiply registered operands
+localparam S_DIV_INIT = 3'd2; // absolute values, leading zero skip
+localparam S_DIV      = 3'd3; // radix-4 iterations
+localparam S_DONE     = 3'd4; // result to WB
+
+reg [2:0] state;
+
+// insn decoding
+
+wire  [6:0] funct7 = pcpi_insn[31:25];
+wire  [2:0] funct3 = pcpi_insn[14:12];
+wire  [6:0] opcode = pcpi_insn[6:0];
+
+wire  mul_div_funct = (funct7 == 7'h1) && (opcode == 7'h33);
+wire  inst_mul_any  = mul_div_funct && ~funct3[2];  // mul, mulh, mulhsu, mulhu
+wire  inst_div_any  = mul_div_funct &&  funct3[2];  // div, divu, rem, remu
+
+// funct3 of the instruction in flight
+reg [2:0] op_r;
+wire      op_div_signed = ~op_r[0];                 // div, rem
+wire      op_rem        =  op_r[1];                 // rem, remu
+
+reg [`XPR_LEN-1:0]  rs1_r, rs2_r;
+
+
+// Multiplier
+// ----------
+// Signed 33x33 product, operands are sign- or zero-extended according to funct3.
+// Operand and product registers map to the input/output registers of a DSP block.
+
+reg signed [`XPR_LEN:0]     mul_opa_r, mul_opb_r;
+reg signed [2*`XPR_LEN+1:0] product_r;
+
+wire mul_opa_signed = (funct3 == 3'h1) || (funct3 == 3'h2); // mulh, mulhsu
+wire mul_opb_signed = (funct3 == 3'h1);                      // mulh
+
+
+// Divider
+// -------
+// Restoring radix-4 division of the absolute values, two quotient bits per cycle.
+// The first s iterations of a radix-2 division only shift in quotient zeros as long
+// as the upper s dividend bits are smaller than the divisor, this holds for
+// s <= clz(dividend) and for s <= 31 - clz(divisor). These are skipped by
+// preloading {remainder, quotient} with the dividend shifted left by s.
+
+// count leading zeros
+function [5:0] clz;
+  input [`XPR_LEN-1:0] x;
+  integer i;
+  begin
+    clz = 6'd32;
+    for (i = 0; i < `XPR_LEN; i = i + 1)
+      if (x[i])
+        clz = 6'd31 - i;
+  end
+endfunction
+
+reg  [`XPR_LEN-1:0] rem_r, quo_r;
+reg  [`XPR_LEN-1:0] div_d_r;                        // |divisor|
+reg  [`XPR_LEN+1:0] div_d3_r;                       // 3 * |divisor|
+reg  [4:0]          div_cnt_r;                      // remaining iterations
+reg                 div_zero_r, neg_quo_r, neg_rem_r;
+
+wire [`XPR_LEN-1:0] div_a = (op_div_signed & rs1_r[31]) ? -rs1_r : rs1_r;
+wire [`XPR_LEN-1:0] div_d = (op_div_signed & rs2_r[31]) ? -rs2_r : rs2_r;
+wire [5:0]          clz_a = clz(div_a);
+wire [5:0]          clz_d = clz(div_d);
+wire [5:0]          skip_d = 6'd31 - clz_d;
+wire [5:0]          skip   = ((clz_a > skip_d) ? clz_a : skip_d) & 6'b111110; // even, 0..32
+wire [2*`XPR_LEN-1:0] div_init = {`XPR_LEN'h0, div_a} << skip;
+
+// one radix-4 step: remainder < divisor, so the partial remainder is < 4 * divisor
+wire [`XPR_LEN+1:0] part = {rem_r, quo_r[`XPR_LEN-1:`XPR_LEN-2]};
+wire [`XPR_LEN+2:0] sub1 = {1'b0, part} - {3'b000, div_d_r};
+wire [`XPR_LEN+2:0] sub2 = {1'b0, part} - {2'b00, div_d_r, 1'b0};
+wire [`XPR_LEN+2:0] sub3 = {1'b0, part} - {1'b0, div_d3_r};
+
+reg  [`XPR_LEN-1:0] rem_nxt;
+reg  [1:0]          quo_bits;
+
+always @(*) begin
+  if (~sub3[`XPR_LEN+2]) begin
+    rem_nxt  = sub3[`XPR_LEN-1:0];
+    quo_bits = 2'd3;
+  end else if (~sub2[`XPR_LEN+2]) begin
+    rem_nxt  = sub2[`XPR_LEN-1:0];
+    quo_bits = 2'd2;
+  end else if (~sub1[`XPR_LEN+2]) begin
+    rem_nxt  = sub1[`XPR_LEN-1:0];
+    quo_bits = 2'd1;
+  end else begin
+    rem_nxt  = part[`XPR_LEN-1:0];
+    quo_bits = 2'd0;
+  end
+end
+
+
+// Control
+// -------
+
+always @(posedge clk or negedge nreset) begin
+  if(~nreset) begin
+    state      <= S_IDLE;
+    op_r       <= 3'h0;
+    rs1_r      <= `XPR_LEN'h0;
+    rs2_r      <= `XPR_LEN'h0;
+    mul_opa_r  <= 0;
+    mul_opb_r  <= 0;
+    product_r  <= 0;
+    rem_r      <= `XPR_LEN'h0;
+    quo_r      <= `XPR_LEN'h0;
+    div_d_r    <= `XPR_LEN'h0;
+    div_d3_r   <= 0;
+    div_cnt_r  <= 5'h0;
+    div_zero_r <= 1'b0;
+    neg_quo_r  <= 1'b0;
+    neg_rem_r  <= 1'b0;
+  end else begin
+    case(state)
+      S_IDLE : begin
+        if(pcpi_valid && (inst_mul_any || inst_div_any)) begin
+          op_r      <= funct3;
+          rs1_r     <= pcpi_rs1;
+          rs2_r     <= pcpi_rs2;
+          mul_opa_r <= {mul_opa_signed & pcpi_rs1[`XPR_LEN-1], pcpi_rs1};
+          mul_opb_r <= {mul_opb_signed & pcpi_rs2[`XPR_LEN-1], pcpi_rs2};
+          state     <= inst_mul_any ? S_MUL : S_DIV_INIT;
+        end
+      end
+      S_MUL : begin
+        product_r <= mul_opa_r * mul_opb_r;
+        state     <= S_DONE;
+      end
+      S_DIV_INIT : begin
+        div_zero_r <= ~(|rs2_r);
+        neg_quo_r  <= op_div_signed & (rs1_r[`XPR_LEN-1] ^ rs2_r[`XPR_LEN-1]);
+        neg_rem_r  <= op_div_signed & rs1_r[`XPR_LEN-1];
+        div_d_r    <= div_d;
+        div_d3_r   <= {2'b00, div_d} + {1'b0, div_d, 1'b0};
+        {rem_r, quo_r} <= div_init;
+        div_cnt_r  <= 5'd16 - skip[5:1];
+        state      <= ((~(|rs2_r)) || (skip == 6'd32)) ? S_DONE : S_DIV;
+      end
+      S_DIV : begin
+        rem_r     <= rem_nxt;
+        quo_r     <= {quo_r[`XPR_LEN-3:0], quo_bits};
+        div_cnt_r <= div_cnt_r - 5'd1;
+        if(div_cnt_r == 5'd1)
+          state   <= S_DONE;
+      end
+      default : begin // S_DONE
+        state     <= S_IDLE;
+      end
+    endcase
+    // instruction was killed in EX
+    if((state != S_IDLE) && (state != S_DONE) && ~pcpi_valid)
+      state <= S_IDLE;
+  end
+end
+
+always @(*) begin
+  pcpi_wr    = 1'b0;
+  pcpi_rd    = 0; // important to allow wired OR
+  pcpi_wait  = 1'b0;
+  pcpi_ready = 1'b0;
+
+  case(state)
+    S_IDLE : begin
+      pcpi_wait = pcpi_valid && (inst_mul_any || inst_div_any);
+    end
+    S_DONE : begin
+      pcpi_ready = 1'b1;
+      pcpi_wr    = 1'b1;
+      if(~op_r[2])
+        pcpi_rd = (op_r[1:0] == 2'h0) ? product_r[`XPR_LEN-1:0] : product_r[2*`XPR_LEN-1:`XPR_LEN];
+      else if(~op_rem)
+        pcpi_rd = div_zero_r ? {`XPR_LEN{1'b1}} : (neg_quo_r ? -quo_r : quo_r);
+      else
+        pcpi_rd = div_zero_r ? rs1_r : (neg_rem_r ? -rem_r : rem_r);
+    end
+    default : begin
+      pcpi_wait = 1'b1;
+    end
+  endcase
+end
+
+endmodule
+
+`else
+
 module airi5c_mul_div (
   input                       nreset,
   input                       clk,
@@ -354,4 +812,6 @@ always @(*) begin
   endcase
 end
 
-endmodule 
+endmodule
+
+`endif // PCPI_SCOREBOARD, ARCH_M_PIPELINED
@@ -59,6 +59,9 @@ module airi5c_spi
 
     output                                  Int,
 
+    output                                  dma_tx_req,     // tx FIFO not full
+    output                                  dma_rx_req,     // rx FIFO not empty
+
     // AHB-Lite interface
     input       [`HASTI_ADDR_WIDTH-1:0]     haddr,      // address
     input                                   hwrite,     // write enable
@@ -261,6 +264,9 @@ module airi5c_spi
                                                 (rx_overflow_error     && rx_overflow_error_IE)     ||
                                                 (rx_underflow_error    && rx_underflow_error_IE);
 
+    assign                                  dma_tx_req              = !tx_full;
+    assign                                  dma_rx_req              = !rx_empty;
+
     always @(posedge clk, negedge n_reset) begin
         if (!n_reset) begin
             haddr_reg   <= `HASTI_ADDR_WIDTH'h0;
@@ -15,6 +15,9 @@
 // Author        : S. Nolting
 // Creation Date : 05.04.2023
 // Abstract      : Technology-agnostic true-random number generator.
+// History       : 16.10.2026 - word read mode (DATA register), FIFO level
+//                              and FIFO-full interrupt (A. Stanitzki)
+//                 17.10.2026 - STAT register (A. Stanitzki)
 //
 
 `timescale 1ns/100ps
@@ -23,7 +26,7 @@
 module airi5c_trng
 #(
   parameter BASE_ADDR  = 'hC0000800,
-  parameter FIFO_DEPTH = 5
+  parameter FIFO_DEPTH = 8  // has to be a power of two, max. 128
 )
 (
   input                               n_reset,
@@ -35,9 +38,13 @@ module airi5c_trng
   input      [`HASTI_BUS_WIDTH-1:0]   hwdata,
   output reg [`HASTI_BUS_WIDTH-1:0]   hrdata,
   output                              hready,
-  output     [`HASTI_RESP_WIDTH-1:0]  hresp
+  output     [`HASTI_RESP_WIDTH-1:0]  hresp,
+  // interrupt
+  output                              int_full   // random pool (FIFO) is full
 );
 
+  localparam LEVEL_WIDTH = $clog2(FIFO_DEPTH) + 1;
+
 
   // bus interface
   reg [`HASTI_ADDR_WIDTH-1:0] haddr_r;
@@ -45,10 +52,22 @@ module airi5c_trng
 
   // control register
   reg enable;
+  reg word_mode;   // FIFO entries are 32-bit words, read via DATA register
+  reg irq_en;      // interrupt when FIFO is full
+  reg mode_clr;    // word_mode changed, flush FIFO and packer
 
   // trng/FIFO interface
-  wire [7:0] trng_data, rnd_data, rnd_masked;
-  wire       trng_valid, rnd_valid, rnd_rd, rnd_clr;
+  wire [7:0]  trng_data, rnd_masked;
+  wire [31:0] rnd_data, fifo_data;
+  wire        trng_valid, rnd_valid, rnd_free, rnd_we, rnd_rd, rnd_clr;
+  wire        ctrl_rd, data_rd, stat_rd;
+
+  // word packer (word mode)
+  reg  [23:0] pack_data;
+  reg  [1:0]  pack_cnt;
+
+  // FIFO fill level
+  reg  [LEVEL_WIDTH-1:0] level;
 
   // Check if we're inside the Matrix (aka "is this a simulation?")
   localparam IS_SIM = 0 // seems like we're on real hardware
@@ -80,24 +99,42 @@ module airi5c_trng
 
   always @(posedge clk, negedge n_reset) begin
     if (!n_reset) begin
-      hrdata <= `HASTI_BUS_WIDTH'h0;
-      enable <= 1'b0;
+      hrdata    <= `HASTI_BUS_WIDTH'h0;
+      enable    <= 1'b0;
+      word_mode <= 1'b0;
+      irq_en    <= 1'b0;
+      mode_clr  <= 1'b0;
     end else begin
       // write access
+      mode_clr <= 1'b0;
       if (hwrite_r) begin
         if (haddr_r == BASE_ADDR) begin
-          enable <= hwdata[30]; // enable TRNG
+          enable    <= hwdata[30]; // enable TRNG
+          irq_en    <= hwdata[28]; // FIFO full interrupt enable
+          word_mode <= hwdata[27]; // word read mode
+          mode_clr  <= hwdata[27] ^ word_mode;
         end
       end
       // read access
       hrdata <= `HASTI_BUS_WIDTH'h0; // default
-      if (|htrans & !hwrite) begin
-        if (haddr == BASE_ADDR) begin
+      if (ctrl_rd) begin
+        if (!word_mode) begin
           hrdata[7:0] <= rnd_masked; // random data byte
-          hrdata[29]  <= IS_SIM;     // to check if we are in a simulation
-          hrdata[30]  <= enable;     // enable TRNG
-          hrdata[31]  <= rnd_valid;  // data is valid when set
         end
+        hrdata[8+LEVEL_WIDTH-1:8] <= level; // FIFO fill level (entries)
+        hrdata[27]  <= word_mode;  // word read mode
+        hrdata[28]  <= irq_en;     // FIFO full interrupt enable
+        hrdata[29]  <= IS_SIM;     // to check if we are in a simulation
+        hrdata[30]  <= enable;     // enable TRNG
+        hrdata[31]  <= rnd_valid;  // data is valid when set
+      end
+      if (data_rd) begin
+        hrdata <= (word_mode & rnd_valid) ? rnd_data : `HASTI_BUS_WIDTH'h0; // 4 random bytes
+      end
+      if (stat_rd) begin // status only, does not read the FIFO
+        hrdata[8+LEVEL_WIDTH-1:8] <= level; // FIFO fill level (entries)
+        hrdata[26]  <= ~rnd_free;  // FIFO full
+        hrdata[31]  <= rnd_valid;  // data is valid when set
       end
     end
   end
@@ -130,33 +167,70 @@ module airi5c_trng
     .valid_o(trng_valid)
   );
 
+  // word mode: collect four random bytes (first byte in bits 7:0) per FIFO entry
+  always @(posedge clk, negedge n_reset) begin
+    if (!n_reset) begin
+      pack_data <= 24'h0;
+      pack_cnt  <= 2'b00;
+    end else if (rnd_clr) begin
+      pack_cnt  <= 2'b00;
+    end else if (word_mode & trng_valid) begin
+      pack_data <= {trng_data, pack_data[23:8]};
+      pack_cnt  <= pack_cnt + 2'b01;
+    end
+  end
+
+  assign rnd_we    = word_mode ? (trng_valid & (pack_cnt == 2'b11)) : trng_valid;
+  assign fifo_data = word_mode ? {trng_data, pack_data} : {24'h0, trng_data};
+
   // random data buffer (re-use the CPU's instruction prefetch buffer as general purpose FIFO)
   airi5c_prebuf_fifo
   #(
     .FIFO_DEPTH(FIFO_DEPTH),
-    .FIFO_WIDTH(8)
+    .FIFO_WIDTH(32)
   )
   random_pool (
     .clk_i(clk),
     .rstn_i(n_reset),
     .clear_i(rnd_clr),
     .hfull_o(),
-    .we_i(trng_valid),
-    .data_i(trng_data),
-    .free_o(),
+    .we_i(rnd_we),
+    .data_i(fifo_data),
+    .free_o(rnd_free),
     .re_i(rnd_rd),
     .data_o(rnd_data),
     .avail_o(rnd_valid)
   );
 
+  // fill level, same "safe access" conditions as the FIFO itself
+  always @(posedge clk, negedge n_reset) begin
+    if (!n_reset) begin
+      level <= {LEVEL_WIDTH{1'b0}};
+    end else if (rnd_clr) begin
+      level <= {LEVEL_WIDTH{1'b0}};
+    end else begin
+      case ({rnd_we & rnd_free, rnd_rd & rnd_valid})
+        2'b10:   level <= level + 1'b1;
+        2'b01:   level <= level - 1'b1;
+        default: level <= level;
+      endcase
+    end
+  end
+
   // mask output to make sure the same random byte cannot be read twice
-  assign rnd_masked = (rnd_valid == 1'b1) ? rnd_data : 8'h00;
+  assign rnd_masked = (rnd_valid == 1'b1) ? rnd_data[7:0] : 8'h00;
+
+  // clear FIFO when module is disabled or the read mode changes
+  assign rnd_clr = ~enable | mode_clr;
 
-  // clear FIFO when module is disabled
-  assign rnd_clr = ~enable;
+  // read FIFO when reading the TRNG's interface register (byte mode) or the data register (word mode)
+  assign ctrl_rd = ((|htrans == 1'b1) && (hwrite == 1'b0) && (haddr == BASE_ADDR))     ? 1'b1 : 1'b0;
+  assign data_rd = ((|htrans == 1'b1) && (hwrite == 1'b0) && (haddr == BASE_ADDR + 4)) ? 1'b1 : 1'b0;
+  assign stat_rd = ((|htrans == 1'b1) && (hwrite == 1'b0) && (haddr == BASE_ADDR + 8)) ? 1'b1 : 1'b0;
+  assign rnd_rd  = word_mode ? data_rd : ctrl_rd;
 
-  // read FIFO when reading the TRNG's interface register
-  assign rnd_rd = ((|htrans == 1'b1) && (hwrite == 1'b0) && (haddr == BASE_ADDR)) ? 1'b1 : 1'b0;
+  // interrupt: random pool is full
+  assign int_full = enable & irq_en & ~rnd_free;
 
 
 endmodule
@@ -41,6 +41,9 @@ module airi5c_uart
     output                                  int_rx_parity_error,
     output                                  int_rx_frame_error,
 
+    output                                  dma_tx_req,     // tx FIFO not full
+    output                                  dma_rx_req,     // rx FIFO not empty
+
     // AHB-Lite interface
     input       [`HASTI_ADDR_WIDTH-1:0]     haddr,      // address
     input                                   hwrite,     // write enable
@@ -197,6 +200,9 @@ module airi5c_uart
                                                 int_rx_underflow_error || int_rx_noise_error        || int_rx_parity_error      ||
                                                 int_rx_frame_error;
 
+    assign                                  dma_tx_req                  = !tx_full;
+    assign                                  dma_rx_req                  = !rx_empty;
+
     always @(posedge clk, negedge n_reset) begin
         if (!n_reset) begin
             haddr_reg   <= `HASTI_ADDR_WIDTH'h0;
@@ -327,7 +333,7 @@ module airi5c_uart
                                         tx_watermark_reached_IE <= !hwdata[25]   && tx_watermark_reached_IE;
                                         tx_empty_IE             <= !hwdata[24]   && tx_empty_IE;
                                         tx_overflow_error       <= !hwdata[19]   && tx_overflow_error;
-                                        tx_watermark            <= !hwdata[15:8] &  tx_watermark;
+                                        tx_watermark            <= ~hwdata[15:8] &  tx_watermark;
                                     end
                 `RX_STAT_REG_ADDR:  begin
                                         rx_clear                <= hwdata[31];
@@ -347,7 +353,7 @@ module airi5c_uart
                                     end
                 `RX_STAT_SET_ADDR:  begin
                                         rx_clear                <= hwdata[31]   || rx_clear;
-                                        rx_frame_error_IE       <= hwdata[30]   || rx_parity_error_IE;
+                                        rx_frame_error_IE       <= hwdata[30]   || rx_frame_error_IE;
                                         rx_parity_error_IE      <= hwdata[29]   || rx_parity_error_IE;
                                         rx_noise_error_IE       <= hwdata[28]   || rx_noise_error_IE;
                                         rx_underflow_error_IE   <= hwdata[27]   || rx_underflow_error_IE;
@@ -363,7 +369,7 @@ module airi5c_uart
                                     end
                 `RX_STAT_CLR_ADDR:  begin
                                         rx_clear                <= !hwdata[31]   && rx_clear;
-                                        rx_frame_error_IE       <= !hwdata[30]   && rx_parity_error_IE;
+                                        rx_frame_error_IE       <= !hwdata[30]   && rx_frame_error_IE;
                                         rx_parity_error_IE      <= !hwdata[29]   && rx_parity_error_IE;
                                         rx_noise_error_IE       <= !hwdata[28]   && rx_noise_error_IE;
                                         rx_underflow_error_IE   <= !hwdata[27]   && rx_underflow_error_IE;
@@ -375,7 +381,7 @@ module airi5c_uart
                                         rx_noise_error          <= !hwdata[21]   && rx_noise_error;
                                         rx_underflow_error      <= !hwdata[20]   && rx_underflow_error;
                                         rx_overflow_error       <= !hwdata[19]   && rx_overflow_error;
-                                        rx_watermark            <= !hwdata[15:8] &  rx_watermark;
+                                        rx_watermark            <= ~hwdata[15:8] &  rx_watermark;
                                     end
                 endcase
             end
@@ -56,6 +56,10 @@ wire  SDO;
 // peripherals typically integrated in DUT, which
 // may or may not be present in the configuration.
 
+// UART 0 is looped back (tx -> rx)
+wire            UART_TX;
+wire            UART_RX = UART_TX;
+
 // Signal declarations for testbench internal use
 // ==============================================
 
@@ -107,7 +111,23 @@ jtag
 //`define ASIC 1 //already defined in Makefile
 // number of testcases expect to fail, so the overall TB still passes
 integer expectederror=0;
+`define CORE_PIPELINE DUT.DUT.airi5c.pipeline // instruction/branch statistics of run_bench_program
+`define CORE_TOP DUT.DUT.airi5c // instruction cache statistics
+`define TB_MEM DUT.SRAM.mem // backdoor program loading (see load_program)
 airi5c_cfg_ideal_sram DUT(
+`elsif CONFIG_IDEAL_SRAM_CCRAM
+// Config: as above, but only the CCRAM (tb/sw/bench.mk layout) is
+// zero-wait-state, main RAM has 2 wait states
+//`define ASIC 1 //already defined in Makefile
+integer expectederror=0;
+`define CORE_PIPELINE DUT.DUT.airi5c.pipeline
+`define CORE_TOP DUT.DUT.airi5c
+`define TB_MEM DUT.SRAM.mem
+airi5c_cfg_ideal_sram #(
+  .RAM_WAIT_STATES(2),
+  .CCRAM_BASE(32'h80020000),
+  .CCRAM_SIZE(32'h00004000)
+) DUT(
 `elsif CONFIG_DOLPHIN_SRAM
 //`define ASIC 1 //already defined in Makefile
 // number of testcases expect to fail, so the overall TB still passes
@@ -202,6 +222,9 @@ reg [31:0] memimg[0:256000000-1]; // this avoids a warning
 reg [31:0] errorcount;            // tb collects exit codes from test steps and reports total fail count
 reg [31:0] errortotal;            // tb sum of testcase errors
 integer testtotal=0;              // tb sum of executed testcases
+reg [255*8:1] tb_test_file;       // single test mode (+test=<memfile>, see .ci/regression.py)
+reg [15:0] tb_test_length;
+reg [31:0] tb_test_units;          // +units=<n>: benchmark program (run_bench_program)
 
 `ifndef VPIMODE
 
@@ -219,6 +242,8 @@ initial begin
   
   `ifdef CONFIG_IDEAL_SRAM_1 
   $write("DUT: CONFIG_IDEAL_SRAM_1 \n");
+  `elsif CONFIG_IDEAL_SRAM_CCRAM
+  $write("DUT: CONFIG_IDEAL_SRAM_CCRAM \n");
   `elsif CONFIG_DOLPHIN_SRAM
   $write("DUT: CONFIG_DOLPHIN_SRAM \n");
   FCLK <= 0;
@@ -238,6 +263,27 @@ initial begin
   
   testcase = 98;
   `include "tests/init_tests.vh"
+
+  // single test mode: +test=<memfile> +length=<words> [+tohost=<hex>]
+  // [+expect_fail] [+timeout=<cycles>] runs only this program, so a
+  // regression can run every test in its own simulator process
+  // (tohost: see select_tohost in test_tasks.vh). +units=<n> runs it
+  // as a benchmark program (phase cycles per unit, benchmark_tests.vh).
+  if ($value$plusargs("test=%s", tb_test_file)) begin
+    if (!$value$plusargs("length=%d", tb_test_length))
+      tb_test_length = 16'hffff;
+    testtotal = 1;
+    $write("%0s: ", tb_test_file);
+    if ($value$plusargs("units=%d", tb_test_units))
+      run_bench_program(0, tb_test_file, tb_test_length, tb_test_units, result);
+    else
+      run_test_program_bulk(0, tb_test_file, tb_test_length, result);
+    $write("TB RESULT %0d CYCLES %0d\n", result, tb_cycles);
+    if ((result != 0) == $test$plusargs("expect_fail"))
+      $write("TB PASSED\n");
+    else
+      $write("TB FAILED\n");
+  end else begin
 //  testcase = 99;
 //  `include "tests/debug_tests.vh"
 
@@ -313,6 +359,7 @@ initial begin
     else
      $write("TB FAILED");
   $write("\n\n");
+  end // single test mode
 
   $finish();
 end
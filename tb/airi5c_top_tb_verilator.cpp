@@ -0,0 +1,256 @@
+//
+// Copyright 2022 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : airi5c_top_tb_verilator.cpp
+// Author        : A. Stanitzki
+// Creation Date : 17.10.26
+// Abstract      : Simulation driver for airi5c_top_tb_verilator.v.
+//                 Loads the PT_LOAD segments of a RV32 ELF file into the
+//                 ideal SRAM (0x80000000, no elf2hex/.mem step), runs
+//                 until the program stores its result to DEBUG_OUT or
+//                 to the "tohost" symbol of the ELF file and prints the
+//                 cycle count and mcycle/minstret.
+//
+//                 usage: airi5c-verilator [+elf=]<file.elf> [plusargs]
+//                   +max-cycles=<n>   stop after n cycles (default 100000000)
+//                   +trace=<file>     VCD file (default airi5c.vcd)
+//                   +trace-start=<n>  dump from cycle n ..
+//                   +trace-end=<n>    .. to cycle n (build with --trace)
+//                 Exit code: 0 = pass, 1 = fail, 2 = timeout, 3 = error.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <elf.h>
+
+#include "verilated.h"
+#include "svdpi.h"
+#include "Vairi5c_top_tb.h"
+#include "Vairi5c_top_tb__Dpi.h"
+#if VM_TRACE
+#include "verilated_vcd_c.h"
+#endif
+
+#define RAM_BASE   0x80000000U    // SRAM of airi5c_cfg_ideal_sram.v
+
+static uint64_t plusarg_u64(int argc, char **argv, const char *name, uint64_t def) {
+  size_t len = strlen(name);
+  for (int i = 1; i < argc; i++) {
+    if ((argv[i][0] == '+') && !strncmp(argv[i] + 1, name, len) && (argv[i][len + 1] == '='))
+      return strtoull(argv[i] + len + 2, NULL, 0);
+  }
+  return def;
+}
+
+static const char *plusarg_str(int argc, char **argv, const char *name, const char *def) {
+  size_t len = strlen(name);
+  for (int i = 1; i < argc; i++) {
+    if ((argv[i][0] == '+') && !strncmp(argv[i] + 1, name, len) && (argv[i][len + 1] == '='))
+      return argv[i] + len + 2;
+  }
+  return def;
+}
+
+
+// ELF loading
+// ==================================================================
+
+static bool read_file(const char *name, std::vector<uint8_t> &buf) {
+  FILE *f = fopen(name, "rb");
+  if (!f)
+    return false;
+  fseek(f, 0, SEEK_END);
+  long size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  buf.resize(size > 0 ? size : 0);
+  bool ok = (size > 0) && (fread(buf.data(), 1, size, f) == (size_t)size);
+  fclose(f);
+  return ok;
+}
+
+// copies all PT_LOAD segments (bss is cleared), returns the address of
+// the "tohost" symbol in tohost (0 if there is none)
+static bool load_elf(const char *name, uint32_t &tohost) {
+  std::vector<uint8_t> buf;
+  if (!read_file(name, buf)) {
+    fprintf(stderr, "error: cannot read %s\n", name);
+    return false;
+  }
+  const Elf32_Ehdr *eh = (const Elf32_Ehdr *)buf.data();
+  if ((buf.size() < sizeof(Elf32_Ehdr)) || memcmp(eh->e_ident, ELFMAG, SELFMAG) ||
+      (eh->e_ident[EI_CLASS] != ELFCLASS32) || (eh->e_ident[EI_DATA] != ELFDATA2LSB) ||
+      (eh->e_machine != EM_RISCV)) {
+    fprintf(stderr, "error: %s is not a RV32 ELF file\n", name);
+    return false;
+  }
+  if (eh->e_entry != RAM_BASE)
+    fprintf(stderr, "warning: entry point 0x%08x, the core starts at 0x%08x\n", eh->e_entry, RAM_BASE);
+
+  // the image covers the whole SRAM, so memory contents never depend on the previous run
+  uint32_t words = tb_mem_words();
+  uint32_t top   = RAM_BASE;
+  std::vector<uint32_t> image(words, 0);
+
+  const Elf32_Phdr *ph = (const Elf32_Phdr *)(buf.data() + eh->e_phoff);
+  for (int i = 0; i < eh->e_phnum; i++) {
+    if ((ph[i].p_type != PT_LOAD) || (ph[i].p_memsz == 0))
+      continue;
+    uint32_t addr = ph[i].p_paddr;
+    if ((addr < RAM_BASE) || ((uint64_t)addr + ph[i].p_memsz > RAM_BASE + 4ULL * words)) {
+      fprintf(stderr, "error: segment 0x%08x..0x%08x outside of the SRAM (0x%08x..0x%08llx)\n",
+              addr, addr + ph[i].p_memsz - 1, RAM_BASE, (unsigned long long)(RAM_BASE + 4ULL * words - 1));
+      return false;
+    }
+    // p_memsz > p_filesz: bss, stays 0
+    for (uint32_t j = 0; j < ph[i].p_filesz; j++) {
+      uint32_t b = addr + j - RAM_BASE;
+      image[b >> 2] |= (uint32_t)buf[ph[i].p_offset + j] << (8 * (b & 3));
+    }
+    if (addr + ph[i].p_memsz > top)
+      top = addr + ph[i].p_memsz;
+  }
+  for (uint32_t i = 0; i < words; i++)
+    tb_mem_write(i, image[i]);
+  printf("airi5c_top_tb: loaded %s, %u of %u kB SRAM\n", name, (top - RAM_BASE + 1023) / 1024, words / 256);
+
+  // tohost symbol (riscv-tests)
+  tohost = 0;
+  const Elf32_Shdr *sh = (const Elf32_Shdr *)(buf.data() + eh->e_shoff);
+  for (int i = 0; (eh->e_shoff != 0) && (i < eh->e_shnum); i++) {
+    if (sh[i].sh_type != SHT_SYMTAB)
+      continue;
+    const Elf32_Sym *sym = (const Elf32_Sym *)(buf.data() + sh[i].sh_offset);
+    const char *str = (const char *)(buf.data() + sh[sh[i].sh_link].sh_offset);
+    for (uint32_t j = 0; j < sh[i].sh_size / sizeof(Elf32_Sym); j++) {
+      if (!strcmp(str + sym[j].st_name, "tohost"))
+        tohost = sym[j].st_value;
+    }
+  }
+  if (tohost)
+    printf("airi5c_top_tb: tohost at 0x%08x\n", tohost);
+  return true;
+}
+
+
+// Simulation
+// ==================================================================
+
+int main(int argc, char **argv) {
+  const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+  contextp->commandArgs(argc, argv);
+
+  const char *elf = plusarg_str(argc, argv, "elf", NULL);
+  for (int i = 1; !elf && (i < argc); i++) {
+    if (argv[i][0] != '+')
+      elf = argv[i];
+  }
+  if (!elf) {
+    fprintf(stderr, "usage: %s [+elf=]<file.elf> [+max-cycles=<n>] [+trace=<file>] [+trace-start=<n>] [+trace-end=<n>]\n", argv[0]);
+    return 3;
+  }
+
+  uint64_t max_cycles  = plusarg_u64(argc, argv, "max-cycles", 100000000ULL);
+  uint64_t trace_start = plusarg_u64(argc, argv, "trace-start", 0);
+  uint64_t trace_end   = plusarg_u64(argc, argv, "trace-end", 0);
+
+#if VM_TRACE
+  if (trace_end > trace_start)
+    contextp->traceEverOn(true);
+#endif
+  const std::unique_ptr<Vairi5c_top_tb> top{new Vairi5c_top_tb{contextp.get()}};
+
+#if VM_TRACE
+  VerilatedVcdC *tfp = NULL;
+  if (trace_end > trace_start) {
+    tfp = new VerilatedVcdC;
+    top->trace(tfp, 99);
+    tfp->open(plusarg_str(argc, argv, "trace", "airi5c.vcd"));
+  }
+#else
+  if (trace_end > trace_start)
+    fprintf(stderr, "warning: +trace-start/+trace-end ignored, build with --trace\n");
+#endif
+
+  top->clk_i      = 0;
+  top->rst_ni     = 0;
+  top->ext_int_i  = 0;
+  top->tdi_i      = 0;
+  top->tck_i      = 0;
+  top->tms_i      = 0;
+  top->VDD_i      = 1;
+  top->testmode_i = 0;
+  top->sdi_i      = 0;
+  top->sen_i      = 0;
+  top->tohost_i   = 0;
+  top->eval();
+
+  // DPI exports of the testbench module
+  svSetScope(svGetScopeFromName("TOP.airi5c_top_tb"));
+  uint32_t tohost;
+  if (!load_elf(elf, tohost))
+    return 3;
+  top->tohost_i = tohost;
+
+  uint64_t cycle = 0;
+  int rst_cycles = 10;
+  while (!contextp->gotFinish() && !top->done_o && (cycle < max_cycles)) {
+    top->clk_i = 1;
+    top->eval();
+#if VM_TRACE
+    if (tfp && (cycle >= trace_start) && (cycle < trace_end))
+      tfp->dump(contextp->time());
+#endif
+    contextp->timeInc(1);
+    top->clk_i = 0;
+    top->eval();
+#if VM_TRACE
+    if (tfp && (cycle >= trace_start) && (cycle < trace_end))
+      tfp->dump(contextp->time());
+#endif
+    contextp->timeInc(1);
+    if (rst_cycles && !--rst_cycles)
+      top->rst_ni = 1;
+    else if (!rst_cycles)
+      cycle++;
+  }
+
+#if VM_TRACE
+  if (tfp) {
+    tfp->close();
+    delete tfp;
+  }
+#endif
+  top->final();
+
+  int ret;
+  printf("\n");
+  if (top->done_o) {
+    ret = (top->result_o == 1) ? 0 : 1;
+    printf("airi5c_top_tb: %s (%u) after %llu cycles\n", ret ? "FAIL" : "PASS", top->result_o,
+           (unsigned long long)cycle);
+  } else {
+    ret = 2;
+    printf("airi5c_top_tb: TIMEOUT after %llu cycles\n", (unsigned long long)cycle);
+  }
+  uint64_t mcycle   = top->mcycle_o;
+  uint64_t minstret = top->minstret_o;
+  printf("airi5c_top_tb: mcycle %llu, minstret %llu", (unsigned long long)mcycle, (unsigned long long)minstret);
+  if (minstret)
+    printf(", CPI %.3f", (double)mcycle / (double)minstret);
+  printf("\n");
+  return ret;
+}
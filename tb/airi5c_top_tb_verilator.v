@@ -1,6 +1,6 @@
 //
 // Copyright 2022 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
-// --- All rights reserved --- 
+// --- All rights reserved ---
 // SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
 // Licensed under the Solderpad Hardware License v 2.1 (the “License”);
 // you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
@@ -11,13 +11,21 @@
 // See the License for the specific language governing permissions and limitations under the License.
 //
 //
-// File              : airi5c_top_tb.v
+// File              : airi5c_top_tb_verilator.v
 // Author            : A. Stanitzki, I. Hoyer
 // Creation Date     : 09.10.20
-// Last Modified     : 08.08.22
+// Last Modified     : 17.10.26
 // Version           : 1.0
-// Abstract          : TOP testbench
-// Note               : Added MEM_RESET
+// Abstract          : TOP testbench for Verilator
+// Note              : Driven by airi5c_top_tb_verilator.cpp (build see
+//                     .ci/verilator_build.sh), which loads the program
+//                     into the SRAM (tb_mem_write), runs the clock and
+//                     ends the simulation on done_o.
+//                     done_o is set by the store of the result to
+//                     DEBUG_OUT (0x80010000, 1 = pass, 0 = fail) or to
+//                     tohost_i (riscv-tests, 1 = pass, other values =
+//                     fail; 0 = no tohost), see wait_test_end in
+//                     test_tasks.vh.
 `timescale 1ns/1ns
 `include "../src/airi5c_ctrl_constants.vh"
 `include "../src/airi5c_csr_addr_map.vh"
@@ -28,37 +36,46 @@
 `include "../src/airi5c_hasti_constants.vh"
 
 module airi5c_top_tb(
-  input        rst_ni,
-  input        clk_i,
-  input        ext_int_i,
-  
-  input        tdi_i,
-  output       tdo_o,
-  input        tck_i,
-  input        tms_i,
-  
-  input        VDD_i,
-  input        testmode_i,
-  input        sdi_i,
-  output       sdo_o,
-  input        sen_i,
-
-  output [7:0] debug_out_o
+  input         rst_ni,
+  input         clk_i,
+  input         ext_int_i,
+
+  input         tdi_i,
+  output        tdo_o,
+  input         tck_i,
+  input         tms_i,
+
+  input         VDD_i,
+  input         testmode_i,
+  input         sdi_i,
+  output        sdo_o,
+  input         sen_i,
+
+  output [7:0]  debug_out_o,
+
+  // end of simulation
+  input  [31:0] tohost_i,
+  output        done_o,
+  output [31:0] result_o,
+
+  // core statistics
+  output [`CSR_COUNTER_WIDTH-1:0] mcycle_o,
+  output [`CSR_COUNTER_WIDTH-1:0] minstret_o
 );
 
 wire uart_tx;
 
 // Config: AIRI5C with internal ideal SRAM (mainly for core verification)
 // ----------------------------------------------------------------------
-airi5c_cfg_ideal_sram DUT(  
+airi5c_cfg_ideal_sram DUT(
   .CLK(clk_i),
   .nRESET(rst_ni),
   .EXT_INT(ext_int_i),
 
-  .tdi(jtag_tdi),
-  .tdo(jtag_tdo),
-  .tck(jtag_tck),
-  .tms(jtag_tms),
+  .tdi(tdi_i),
+  .tdo(tdo_o),
+  .tck(tck_i),
+  .tms(tms_i),
 
   .VDD(VDD_i),
   .debug_state(),
@@ -68,7 +85,7 @@ airi5c_cfg_ideal_sram DUT(
   .sdi(sdi_i),
   .sdo(sdo_o),
   .sen(sen_i),
-   
+
   //.gpio0(),
 
   .uart0_tx(uart_tx),
@@ -79,7 +96,7 @@ airi5c_cfg_ideal_sram DUT(
   .spi1_miso(),
   .spi1_sclk(),
   .spi1_ss()*/
-); 
+);
 
 
 uart_monitor theMonitor(
@@ -88,21 +105,65 @@ uart_monitor theMonitor(
   .uart_tx_i(uart_tx)
 );
 
-reg [31:0] memimg[0:256000000-1];
-
 reg [31:0] simcyc;
 reg written;
 
 always @(posedge clk_i or negedge rst_ni) begin
   simcyc <= rst_ni ? simcyc + 1 : 0;
-  if((DUT.DUT.dmem_haddr == 32'hC0000200) && (DUT.DUT.dmem_hwrite)) written <= 1; 
+  if((DUT.DUT.dmem_haddr == 32'hC0000200) && (DUT.DUT.dmem_hwrite)) written <= 1;
   else written <= 0;
   if(written) $write("%c",DUT.DUT.dmem_hwdata);
 end
 
 
+// result store on the DMEM bus of the core (in front of the data cache)
+reg        mbox_wr;
+reg        mbox_dbg;
+reg        done_r;
+reg [31:0] result_r;
+
+always @(posedge clk_i or negedge rst_ni) begin
+  if (~rst_ni) begin
+    mbox_wr  <= 1'b0;
+    mbox_dbg <= 1'b0;
+    done_r   <= 1'b0;
+    result_r <= 32'h0;
+  end else if (DUT.DUT.airi5c.dmem_hready_core) begin
+    if (mbox_wr && !done_r) begin
+      if (mbox_dbg ? (DUT.DUT.airi5c.dmem_hwdata_core <= 1) : (DUT.DUT.airi5c.dmem_hwdata_core != 0)) begin
+        done_r   <= 1'b1;
+        result_r <= DUT.DUT.airi5c.dmem_hwdata_core;
+      end
+    end
+    mbox_wr  <= DUT.DUT.airi5c.dmem_htrans_ext[1] && DUT.DUT.airi5c.dmem_hwrite_core &&
+                ((DUT.DUT.airi5c.dmem_haddr_core == 32'h80010000) ||
+                 ((tohost_i != 0) && (DUT.DUT.airi5c.dmem_haddr_core == tohost_i)));
+    mbox_dbg <= (DUT.DUT.airi5c.dmem_haddr_core == 32'h80010000);
+  end
+end
+
+assign done_o     = done_r;
+assign result_o   = result_r;
+
+assign mcycle_o   = DUT.DUT.airi5c.pipeline.csr.cycle_full;
+assign minstret_o = DUT.DUT.airi5c.pipeline.csr.instret_full;
+
+
+// program loading from C++, addr = word index (byte address [17:2],
+// see airi5c_cfg_ideal_sram.v)
+export "DPI-C" function tb_mem_write;
+export "DPI-C" function tb_mem_words;
+
+function void tb_mem_write(input int unsigned addr, input int unsigned data);
+  DUT.SRAM.mem[addr] = data;
+endfunction
+
+function int unsigned tb_mem_words();
+  tb_mem_words = DUT.SRAM.nwords;
+endfunction
+
+
 initial begin
-  $readmemh("./memfiles/torture/coremark.mem",DUT.SRAM.mem);
   $write("airi5c_top_tb: tb started\r\n");
 end
 
@@ -21,6 +21,19 @@
 //                     when the memory system doesn't need to be taken into account.
 //                     This includes most of the work on the core complex itself, 
 //                     the peripherals and custom instructions.
+//                     RAM_WAIT_STATES > 0 slows down all memory accesses
+//                     outside the CCRAM window (see bsp/common/link.ld),
+//                     which then is the only zero-wait-state memory
+//                     (testbench define CONFIG_IDEAL_SRAM_CCRAM).
+//                     Further memory models (see airi5c_hasti_wait_states.v),
+//                     defaults from the defines below (e.g. -DMEM_JITTER=3),
+//                     at run time from plusargs:
+//                     RAM_JITTER      0..n random extra wait states   +mem_jitter, +mem_seed
+//                     SINGLE_PORT     1 = IMEM and DMEM share one     +mem_single_port
+//                                     port, DMEM goes first
+//                     XIP_SIZE > 0    QSPI flash latency for the      +xip_wait, +xip_seq_wait
+//                                     window at XIP_BASE
+//                     +mem_wait overrides RAM_WAIT_STATES.
 //
 `timescale 1ns/1ns
 
@@ -32,8 +45,47 @@
 `include "../src/airi5c_arch_options.vh"
 `include "../src/airi5c_hasti_constants.vh"
 
+`ifndef MEM_JITTER
+  `define MEM_JITTER 0
+`endif
 
-module airi5c_cfg_ideal_sram (
+`ifndef MEM_SINGLE_PORT
+  `define MEM_SINGLE_PORT 0
+`endif
+
+// XIP window, code executed in place from a QSPI flash (the SRAM behind
+// it only decodes address bits [17:0])
+`ifndef MEM_XIP_BASE
+  `define MEM_XIP_BASE 32'h80000000
+`endif
+
+`ifndef MEM_XIP_SIZE
+  `define MEM_XIP_SIZE 32'h00000000
+`endif
+
+// QSPI, 1-4-4 fast read: 8 command + 6 address + 4 dummy + 8 data clocks
+// at half the core clock
+`ifndef MEM_XIP_WAIT_STATES
+  `define MEM_XIP_WAIT_STATES 52
+`endif
+
+// next word of a running read: 8 data clocks at half the core clock
+`ifndef MEM_XIP_SEQ_WAIT_STATES
+  `define MEM_XIP_SEQ_WAIT_STATES 16
+`endif
+
+
+module airi5c_cfg_ideal_sram #(
+   parameter RAM_WAIT_STATES     = 0,
+   parameter CCRAM_BASE          = 32'h80020000,
+   parameter CCRAM_SIZE          = 32'h00004000,
+   parameter RAM_JITTER          = `MEM_JITTER,
+   parameter SINGLE_PORT         = `MEM_SINGLE_PORT,
+   parameter XIP_BASE            = `MEM_XIP_BASE,
+   parameter XIP_SIZE            = `MEM_XIP_SIZE,
+   parameter XIP_WAIT_STATES     = `MEM_XIP_WAIT_STATES,
+   parameter XIP_SEQ_WAIT_STATES = `MEM_XIP_SEQ_WAIT_STATES
+) (
    input                        VDD,
    input                        CLK,
    input                        nRESET,
@@ -115,6 +167,74 @@ wire  [`HASTI_BUS_WIDTH-1:0]    dmem_hrdata;
 wire                            dmem_hready;
 wire                            dmem_hresp;
 
+wire  [`HASTI_TRANS_WIDTH-1:0]  sram_imem_htrans;
+wire  [`HASTI_BUS_WIDTH-1:0]    sram_imem_hrdata;
+wire  [`HASTI_TRANS_WIDTH-1:0]  sram_dmem_htrans;
+wire  [`HASTI_BUS_WIDTH-1:0]    sram_dmem_hrdata;
+
+// single-port contention between the two SRAM ports
+wire  [7:0]                     imem_occ;
+wire  [7:0]                     imem_wait;
+wire  [7:0]                     dmem_occ;
+wire  [7:0]                     dmem_wait;
+
+// main RAM latency, the CCRAM window stays zero-wait-state
+airi5c_hasti_wait_states #(
+  .WAIT_STATES(RAM_WAIT_STATES),
+  .FAST_BASE(CCRAM_BASE),
+  .FAST_SIZE(CCRAM_SIZE),
+  .JITTER(RAM_JITTER),
+  .SEED(1),
+  .XIP_BASE(XIP_BASE),
+  .XIP_SIZE(XIP_SIZE),
+  .XIP_WAIT_STATES(XIP_WAIT_STATES),
+  .XIP_SEQ_WAIT_STATES(XIP_SEQ_WAIT_STATES),
+  .SINGLE_PORT(SINGLE_PORT),
+  .PRIORITY(0)
+) imem_wait_states (
+  .hclk(CLK),
+  .hresetn(nRESET),
+  .m_hsel(1'b1),
+  .m_haddr(imem_haddr),
+  .m_htrans(imem_htrans),
+  .m_hrdata(imem_hrdata),
+  .m_hready(imem_hready),
+  .s_htrans(sram_imem_htrans),
+  .s_hrdata(sram_imem_hrdata),
+  .occ_o(imem_occ),
+  .other_occ_i(dmem_occ),
+  .other_wait_i(dmem_wait),
+  .wait_o(imem_wait)
+);
+
+airi5c_hasti_wait_states #(
+  .WAIT_STATES(RAM_WAIT_STATES),
+  .FAST_BASE(CCRAM_BASE),
+  .FAST_SIZE(CCRAM_SIZE),
+  .JITTER(RAM_JITTER),
+  .SEED(2),
+  .XIP_BASE(XIP_BASE),
+  .XIP_SIZE(XIP_SIZE),
+  .XIP_WAIT_STATES(XIP_WAIT_STATES),
+  .XIP_SEQ_WAIT_STATES(XIP_SEQ_WAIT_STATES),
+  .SINGLE_PORT(SINGLE_PORT),
+  .PRIORITY(1)
+) dmem_wait_states (
+  .hclk(CLK),
+  .hresetn(nRESET),
+  .m_hsel(dmem_haddr[31:30] == 2'b10),
+  .m_haddr(dmem_haddr),
+  .m_htrans(dmem_htrans),
+  .m_hrdata(dmem_hrdata),
+  .m_hready(dmem_hready),
+  .s_htrans(sram_dmem_htrans),
+  .s_hrdata(sram_dmem_hrdata),
+  .occ_o(dmem_occ),
+  .other_occ_i(imem_occ),
+  .other_wait_i(imem_wait),
+  .wait_o(dmem_wait)
+);
+
 airi5c_dp_hasti_sram SRAM(
   .hclk(CLK),
   .hresetn(nRESET),
@@ -124,10 +244,10 @@ airi5c_dp_hasti_sram SRAM(
   .p0_hburst(dmem_hburst),
   .p0_hmastlock(dmem_hmastlock),
   .p0_hprot(dmem_hprot),
-  .p0_htrans(dmem_htrans),
+  .p0_htrans(sram_dmem_htrans),
   .p0_hwdata(dmem_hwdata),
-  .p0_hrdata(dmem_hrdata),
-  .p0_hready(dmem_hready),
+  .p0_hrdata(sram_dmem_hrdata),
+  .p0_hready(),
   .p0_hresp(dmem_hresp),
 
   .p1_haddr({14'h0,imem_haddr[17:0]}),
@@ -136,10 +256,10 @@ airi5c_dp_hasti_sram SRAM(
   .p1_hburst(imem_hburst),
   .p1_hmastlock(imem_hmastlock),
   .p1_hprot(imem_hprot),
-  .p1_htrans(imem_htrans),
+  .p1_htrans(sram_imem_htrans),
   .p1_hwdata(imem_hwdata),
-  .p1_hrdata(imem_hrdata),
-  .p1_hready(imem_hready),
+  .p1_hrdata(sram_imem_hrdata),
+  .p1_hready(),
   .p1_hresp(imem_hresp)
 );
 
@@ -148,6 +148,39 @@ module airi5c_top_asic(
   wire [`HASTI_RESP_WIDTH-1:0]    per_hresp_trng;
   wire                            per_hready_trng;
 
+  wire [`HASTI_BUS_WIDTH-1:0]     per_hrdata_dma0;
+  wire [`HASTI_RESP_WIDTH-1:0]    per_hresp_dma0;
+  wire                            per_hready_dma0;
+
+  // DMEM bus masters (core and DMA), arbitrated onto dmem_*
+  // ========================================================
+
+  wire [`HASTI_ADDR_WIDTH-1:0]    core_dmem_haddr;
+  wire                            core_dmem_hwrite;
+  wire [`HASTI_SIZE_WIDTH-1:0]    core_dmem_hsize;
+  wire [`HASTI_BURST_WIDTH-1:0]   core_dmem_hburst;
+  wire                            core_dmem_hmastlock;
+  wire [`HASTI_PROT_WIDTH-1:0]    core_dmem_hprot;
+  wire [`HASTI_TRANS_WIDTH-1:0]   core_dmem_htrans;
+  wire [`HASTI_BUS_WIDTH-1:0]     core_dmem_hwdata;
+  wire                            core_dmem_hready;
+  wire [`HASTI_RESP_WIDTH-1:0]    core_dmem_hresp;
+
+  wire [`HASTI_ADDR_WIDTH-1:0]    dma0_haddr;
+  wire                            dma0_hwrite;
+  wire [`HASTI_SIZE_WIDTH-1:0]    dma0_hsize;
+  wire [`HASTI_TRANS_WIDTH-1:0]   dma0_htrans;
+  wire [`HASTI_BUS_WIDTH-1:0]     dma0_hwdata;
+  wire                            dma0_hgrant;
+  wire                            dma0_hready;
+  wire [`HASTI_RESP_WIDTH-1:0]    dma0_hresp;
+
+  // DMA request lines of the peripherals (see DMA_REQ_* in airisc_dma.h)
+  wire                            uart0_dma_tx_req;
+  wire                            uart0_dma_rx_req;
+  wire                            spi0_dma_tx_req;
+  wire                            spi0_dma_rx_req;
+
   wire                            nrst = nreset & ndmreset;
   wire                            system_timer_tick;
 
@@ -155,8 +188,21 @@ module airi5c_top_asic(
 
   // Interrupt signals generated by core local peripherals
   // =====================================================
-  
-  
+  wire                            uart0_int;
+  wire                            dma0_int;
+  wire                            trng_int;
+
+  // the XIRQ lines of the peripherals are driven by the peripheral
+  // only (XIRQs are edge-triggered, an active ext_interrupt would hide
+  // their edges), all other lines are driven by ext_interrupt
+  reg  [`N_EXT_INTS-1:0]          ext_interrupts;
+
+  always @(*) begin
+    ext_interrupts              = {`N_EXT_INTS{ext_interrupt}};
+    ext_interrupts[`UART0_XIRQ] = uart0_int;
+    ext_interrupts[`DMA0_XIRQ]  = dma0_int;
+    ext_interrupts[`TRNG0_XIRQ] = trng_int;
+  end
   
   //Debugging statements 
 `ifdef ram_debug
@@ -188,13 +234,52 @@ always@(*) begin
 end
 `endif
 
+  // DMEM bus arbiter
+  // ================
+  // the core has priority, the DMA uses the idle bus cycles
+  airi5c_dma_arbiter dmem_arbiter (
+    .clk(clk),
+    .nreset(nrst),
+
+    .core_haddr(core_dmem_haddr),
+    .core_hwrite(core_dmem_hwrite),
+    .core_hsize(core_dmem_hsize),
+    .core_hburst(core_dmem_hburst),
+    .core_hmastlock(core_dmem_hmastlock),
+    .core_hprot(core_dmem_hprot),
+    .core_htrans(core_dmem_htrans),
+    .core_hwdata(core_dmem_hwdata),
+    .core_hready(core_dmem_hready),
+    .core_hresp(core_dmem_hresp),
+
+    .dma_haddr(dma0_haddr),
+    .dma_hwrite(dma0_hwrite),
+    .dma_hsize(dma0_hsize),
+    .dma_htrans(dma0_htrans),
+    .dma_hwdata(dma0_hwdata),
+    .dma_hgrant(dma0_hgrant),
+    .dma_hready(dma0_hready),
+    .dma_hresp(dma0_hresp),
+
+    .haddr(dmem_haddr),
+    .hwrite(dmem_hwrite),
+    .hsize(dmem_hsize),
+    .hburst(dmem_hburst),
+    .hmastlock(dmem_hmastlock),
+    .hprot(dmem_hprot),
+    .htrans(dmem_htrans),
+    .hwdata(dmem_hwdata),
+    .hready(muxed_hready),
+    .hresp(muxed_hresp)
+  );
+
   // DMEM bus multiplexer
   // ====================
   airi5c_periph_mux #
   (
-    .S_COUNT(7),
-    .S_BASE_ADDR({`MEMORY_BASE_ADDR,`SYSTEM_TIMER_BASE_ADDR,`UART0_BASE_ADDR,`SPI0_BASE_ADDR,`GPIO0_BASE_ADDR,`ICAP_BASE_ADDR,`TRNG_BASE_ADDR}),
-    .S_ADDR_WIDTH({`MEMORY_ADDR_WIDTH,`SYSTEM_TIMER_ADDR_WIDTH,`UART0_ADDR_WIDTH,`SPI0_ADDR_WIDTH,`GPIO0_ADDR_WIDTH,`ICAP_ADDR_WIDTH,`TRNG_ADDR_WIDTH})
+    .S_COUNT(8),
+    .S_BASE_ADDR({`MEMORY_BASE_ADDR,`SYSTEM_TIMER_BASE_ADDR,`UART0_BASE_ADDR,`SPI0_BASE_ADDR,`GPIO0_BASE_ADDR,`ICAP_BASE_ADDR,`TRNG_BASE_ADDR,`DMA0_BASE_ADDR}),
+    .S_ADDR_WIDTH({`MEMORY_ADDR_WIDTH,`SYSTEM_TIMER_ADDR_WIDTH,`UART0_ADDR_WIDTH,`SPI0_ADDR_WIDTH,`GPIO0_ADDR_WIDTH,`ICAP_ADDR_WIDTH,`TRNG_ADDR_WIDTH,`DMA0_ADDR_WIDTH})
   )
   peripheral_mux ( 
     .clk_i(clk),
@@ -205,9 +290,9 @@ end
     .m_hresp(muxed_hresp),
     .m_hrdata(muxed_hrdata), 
     
-    .s_hready({dmem_hready,per_hready_system_timer,per_hready_uart0,per_hready_spi0,per_hready_gpio0,per_hready_icap,per_hready_trng}),
-    .s_hresp({dmem_hresp,per_hresp_system_timer,per_hresp_uart0,per_hresp_spi0,per_hresp_gpio0,per_hresp_icap,per_hresp_trng}),
-    .s_hrdata({dmem_hrdata,per_hrdata_system_timer,per_hrdata_uart0,per_hrdata_spi0,per_hrdata_gpio0,per_hrdata_icap,per_hrdata_trng})
+    .s_hready({dmem_hready,per_hready_system_timer,per_hready_uart0,per_hready_spi0,per_hready_gpio0,per_hready_icap,per_hready_trng,per_hready_dma0}),
+    .s_hresp({dmem_hresp,per_hresp_system_timer,per_hresp_uart0,per_hresp_spi0,per_hresp_gpio0,per_hresp_icap,per_hresp_trng,per_hresp_dma0}),
+    .s_hrdata({dmem_hrdata,per_hrdata_system_timer,per_hrdata_uart0,per_hrdata_spi0,per_hrdata_gpio0,per_hrdata_icap,per_hrdata_trng,per_hrdata_dma0})
   );
 
   // Core Complex peripherals
@@ -265,7 +350,7 @@ end
   airi5c_uart
   #(
     .BASE_ADDR(`UART0_BASE_ADDR),
-    .TX_ADDR_WIDTH(5),
+    .TX_ADDR_WIDTH(5),  // 32 entries, UART_FIFO_DEPTH in bsp/include/airisc_uart.h
     .RX_ADDR_WIDTH(5)
   )
   uart0 (
@@ -277,7 +362,7 @@ end
     .cts(1'b1),
     .rts(),
   
-    .int_any(),
+    .int_any(uart0_int),
     .int_tx_empty(),
     .int_tx_watermark_reached(),
     .int_tx_overflow_error(),
@@ -289,6 +374,9 @@ end
     .int_rx_parity_error(),
     .int_rx_frame_error(),
 
+    .dma_tx_req(uart0_dma_tx_req),
+    .dma_rx_req(uart0_dma_rx_req),
+
     .haddr(dmem_haddr),
     .hwrite(dmem_hwrite),
     .htrans(dmem_htrans),
@@ -328,6 +416,9 @@ end
 
   .Int(),  
 
+  .dma_tx_req(spi0_dma_tx_req),
+  .dma_rx_req(spi0_dma_rx_req),
+
   .haddr(dmem_haddr),
   .hwrite(dmem_hwrite),
   .htrans(dmem_htrans),
@@ -364,7 +455,7 @@ end
   airi5c_trng
   #(
     .BASE_ADDR(`TRNG_BASE_ADDR), 
-    .FIFO_DEPTH(5)
+    .FIFO_DEPTH(8)
   )
   trng (
     .n_reset(nrst),
@@ -376,7 +467,41 @@ end
     .hwdata(dmem_hwdata),
     .hrdata(per_hrdata_trng),
     .hready(per_hready_trng),
-    .hresp(per_hresp_trng)
+    .hresp(per_hresp_trng),
+
+    .int_full(trng_int)
+  );
+
+  airi5c_dma
+  #(
+    .BASE_ADDR(`DMA0_BASE_ADDR),
+    .CHANNELS(2),
+    .DREQ_COUNT(4)
+  )
+  dma0 (
+    .nreset(nrst),
+    .clk(clk),
+
+    .dreq({spi0_dma_rx_req,spi0_dma_tx_req,uart0_dma_rx_req,uart0_dma_tx_req}),
+    .int_any(dma0_int),
+
+    .m_haddr(dma0_haddr),
+    .m_hwrite(dma0_hwrite),
+    .m_hsize(dma0_hsize),
+    .m_htrans(dma0_htrans),
+    .m_hwdata(dma0_hwdata),
+    .m_hrdata(muxed_hrdata),
+    .m_hgrant(dma0_hgrant),
+    .m_hready(dma0_hready),
+    .m_hresp(dma0_hresp),
+
+    .haddr(dmem_haddr),
+    .hwrite(dmem_hwrite),
+    .htrans(dmem_htrans),
+    .hwdata(dmem_hwdata),
+    .hrdata(per_hrdata_dma0),
+    .hready(per_hready_dma0),
+    .hresp(per_hresp_dma0)
   );
 
 // core/hart instances
@@ -388,7 +513,7 @@ airi5c_core airi5c(
   .testmode_i(testmode),
 
   .ndmreset_o(ndmreset),
-  .ext_interrupts_i({`N_EXT_INTS{ext_interrupt}}),
+  .ext_interrupts_i(ext_interrupts),
   .system_timer_tick_i(system_timer_tick),
 
   .imem_haddr_o(imem_haddr),
@@ -403,17 +528,17 @@ airi5c_core airi5c(
   .imem_hready_i(imem_hready),
   .imem_hresp_i(imem_hresp),
 
-  .dmem_haddr_o(dmem_haddr),
-  .dmem_hwrite_o(dmem_hwrite),
-  .dmem_hsize_o(dmem_hsize),
-  .dmem_hburst_o(dmem_hburst),
-  .dmem_hmastlock_o(dmem_hmastlock),
-  .dmem_hprot_o(dmem_hprot),
-  .dmem_htrans_o(dmem_htrans),
-  .dmem_hwdata_o(dmem_hwdata),
+  .dmem_haddr_o(core_dmem_haddr),
+  .dmem_hwrite_o(core_dmem_hwrite),
+  .dmem_hsize_o(core_dmem_hsize),
+  .dmem_hburst_o(core_dmem_hburst),
+  .dmem_hmastlock_o(core_dmem_hmastlock),
+  .dmem_hprot_o(core_dmem_hprot),
+  .dmem_htrans_o(core_dmem_htrans),
+  .dmem_hwdata_o(core_dmem_hwdata),
   .dmem_hrdata_i(muxed_hrdata),
-  .dmem_hready_i(muxed_hready),
-  .dmem_hresp_i(muxed_hresp),
+  .dmem_hready_i(core_dmem_hready),
+  .dmem_hresp_i(core_dmem_hresp),
 
   .lock_custom_i(lock_custom),
 
@@ -458,7 +583,8 @@ reg    debug_hwrite;
  // results from the official ISA tests.
  // It can be handy for silicon verification
  // as well, but might also be excluded from
- // synthesis.
+ // synthesis. Only core accesses are traced,
+ // DMA transfers never change debug_out.
 
 always @(posedge clk or negedge nreset) begin
   if(~nreset) begin
@@ -466,20 +592,20 @@ always @(posedge clk or negedge nreset) begin
     debug_addr <= 0;
     debug_hwrite <= 1'b0;
   end else begin
-    debug_addr <= muxed_hready ? dmem_haddr : debug_addr;
-    debug_hwrite <= muxed_hready ? dmem_hwrite : debug_hwrite;
+    debug_addr <= core_dmem_hready ? core_dmem_haddr : debug_addr;
+    debug_hwrite <= core_dmem_hready ? core_dmem_hwrite : debug_hwrite;
     `ifndef VPIMODE
     if(((debug_addr[7:0] == 8'h00) || (debug_addr == 32'h80010000)) && (debug_hwrite))
     begin
-      debug_out <= dmem_hwdata[7:0];
+      debug_out <= core_dmem_hwdata[7:0];
     end
     `endif
     `ifdef VPIMODE
     if((debug_addr == 32'hc0000024) && (debug_hwrite))
     begin
         //debug_out <= dmem_hwdata[7:0];
-        $write("%c",dmem_hwdata[7:0]);
-        if((dmem_hwdata[7:0] == 8'h13) || (dmem_hwdata[7:0] == 8'h10)) $fflush(1);
+        $write("%c",core_dmem_hwdata[7:0]);
+        if((core_dmem_hwdata[7:0] == 8'h13) || (core_dmem_hwdata[7:0] == 8'h10)) $fflush(1);
     end
     `endif
   end
@@ -94,18 +94,18 @@ always @* begin
 
   case(p0_state)
   2'b00    :    begin                                    // IDLE - ADDR CYCLE
-        p0_next_state = (p0_htrans != `HASTI_TRANS_NONSEQ) ? 2'b00 :
+        p0_next_state = !p0_htrans[1] ? 2'b00 :                // NONSEQ or SEQ (burst)
             p0_hwrite ? 2'b10 : 2'b01;            
       end
   2'b01    :    begin                                    // READ - DATA CYLCE
-        p0_next_state = (p0_htrans != `HASTI_TRANS_NONSEQ) ? 2'b00 :    // if last Read/Write, go back to IDLE.
+        p0_next_state = !p0_htrans[1] ? 2'b00 :    // if last Read/Write, go back to IDLE.
             p0_hwrite ? 2'b10 : 2'b01;
 
 //        p0_rdata = mem[p0_word_addr] >> ( 8* p0_addr_r[1:0]);            // read data from sampled addr.
         p0_rdata = mem[p0_word_addr];            // read data from sampled addr.
       end
   2'b10    :    begin                                    // WRITE - DATA CYCLE
-        p0_next_state = (p0_htrans != `HASTI_TRANS_NONSEQ) ? 2'b00 :    // if last Read/Write, go back to IDLE.
+        p0_next_state = !p0_htrans[1] ? 2'b00 :    // if last Read/Write, go back to IDLE.
             p0_hwrite ? 2'b10 : 2'b01;
 //        p0_rdata = mem[p0_word_addr] >> ( 8* p0_addr_r[1:0]);        
         p0_rdata = mem[p0_word_addr];        
@@ -132,13 +132,13 @@ always @(posedge hclk) begin
    p1_size_r <= 0;
   end else begin
    p1_size_r <= p1_hsize;
-   if (p1_htrans == `HASTI_TRANS_NONSEQ) begin
+   if (p1_htrans[1]) begin // NONSEQ or SEQ (burst)
     if (p1_hwrite) begin
       $write("error: write access to imem port");
     end else begin
        p1_bypass <= (p0_state == 2'b10) && (p0_word_addr == (p1_haddr >> 2));
     end
-   end // if (p1_htrans == `HASTI_TRANS_NONSEQ)
+   end // if (p1_htrans[1])
   end
 end
 
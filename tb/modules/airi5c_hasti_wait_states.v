@@ -0,0 +1,157 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File              : airi5c_hasti_wait_states.v
+// Author            : A. Stanitzki
+// Creation Date     : 16.10.26
+// Version           : 1.0
+// Abstract          : Inserts wait states into the data phase of a
+//                     zero-wait-state AHB-Lite slave (simulation only).
+// History           : 17.10.26 - random jitter, XIP window, single-port contention (ASt)
+// Notes             : Transfers to the fast window [FAST_BASE, FAST_BASE+FAST_SIZE)
+//                     (e.g. the CCRAM) pass unchanged, all other transfers
+//                     get WAIT_STATES extra data phase cycles, plus
+//                     0..JITTER random cycles (seed SEED).
+//                     Transfers to the XIP window [XIP_BASE, XIP_BASE+XIP_SIZE)
+//                     model a QSPI flash instead: XIP_WAIT_STATES for a
+//                     new read (command, address, dummy cycles),
+//                     XIP_SEQ_WAIT_STATES when it continues at the next
+//                     word of the previous XIP transfer.
+//                     SINGLE_PORT = 1: the slave behind this port and the
+//                     one of the instance connected to other_occ_i are the
+//                     same single-port memory. A transfer then also waits
+//                     while the memory is taken by the other port
+//                     (other_occ_i cycles); for transfers that start
+//                     in the same cycle, the port with PRIORITY = 1 goes
+//                     first.
+//                     The slave completes the transfer in the first data
+//                     phase cycle (read data is held here, write data is
+//                     taken from the master). While the wait states run,
+//                     the slave sees IDLE transfers.
+//                     The plusargs +mem_wait, +mem_jitter, +mem_seed,
+//                     +mem_single_port, +xip_wait and +xip_seq_wait
+//                     override the parameters at run time.
+//
+`timescale 1ns/100ps
+
+
+`include "airi5c_hasti_constants.vh"
+
+module airi5c_hasti_wait_states #(
+  parameter WAIT_STATES         = 0,
+  parameter FAST_BASE           = 32'h80020000,
+  parameter FAST_SIZE           = 32'h00004000,
+  parameter JITTER              = 0,
+  parameter SEED                = 1,
+  parameter XIP_BASE            = 32'h80000000,
+  parameter XIP_SIZE            = 32'h00000000, // 0 = no XIP window
+  parameter XIP_WAIT_STATES     = 52,
+  parameter XIP_SEQ_WAIT_STATES = 16,
+  parameter SINGLE_PORT         = 0,
+  parameter PRIORITY            = 0
+) (
+  input                          hclk,
+  input                          hresetn,
+
+  // master side
+  input                           m_hsel,
+  input  [`HASTI_ADDR_WIDTH-1:0]  m_haddr,
+  input  [`HASTI_TRANS_WIDTH-1:0] m_htrans,
+  output [`HASTI_BUS_WIDTH-1:0]   m_hrdata,
+  output                          m_hready,
+
+  // slave side
+  output [`HASTI_TRANS_WIDTH-1:0] s_htrans,
+  input  [`HASTI_BUS_WIDTH-1:0]   s_hrdata,
+
+  // single-port contention: cycles after the current one that the
+  // memory is taken by this / the other port
+  output [7:0]                    occ_o,
+  input  [7:0]                    other_occ_i,
+  input  [7:0]                    other_wait_i,
+  output [7:0]                    wait_o
+);
+
+reg  [7:0]                  wait_cnt;   // remaining wait states of the current data phase
+reg                         first_r;    // first data phase cycle, the slave delivers the read data
+reg                         hold_r;     // last data phase cycle, drive held read data
+reg  [`HASTI_BUS_WIDTH-1:0] rdata_r;
+reg  [`HASTI_ADDR_WIDTH-1:0] xip_addr_r; // address of the last XIP transfer
+reg  [7:0]                  jitter_r;   // random wait states of the next transfer
+
+// run time configuration
+integer                     wait_states;
+integer                     jitter;
+integer                     seed;
+integer                     single_port;
+integer                     xip_wait_states;
+integer                     xip_seq_wait_states;
+
+initial begin
+  wait_states         = WAIT_STATES;
+  jitter              = JITTER;
+  seed                = SEED;
+  single_port         = SINGLE_PORT;
+  xip_wait_states     = XIP_WAIT_STATES;
+  xip_seq_wait_states = XIP_SEQ_WAIT_STATES;
+  if ($value$plusargs("mem_wait=%d", wait_states)) ;
+  if ($value$plusargs("mem_jitter=%d", jitter)) ;
+  if ($value$plusargs("mem_seed=%d", seed))
+    seed = seed + SEED;                         // separate sequence per instance
+  if ($value$plusargs("mem_single_port=%d", single_port)) ;
+  if ($value$plusargs("xip_wait=%d", xip_wait_states)) ;
+  if ($value$plusargs("xip_seq_wait=%d", xip_seq_wait_states)) ;
+end
+
+wire fast   = (m_haddr >= FAST_BASE) && (m_haddr < FAST_BASE + FAST_SIZE);
+wire xip    = (XIP_SIZE != 0) && (m_haddr >= XIP_BASE) && (m_haddr < XIP_BASE + XIP_SIZE);
+wire accept = m_hsel && m_htrans[1] && m_hready && !fast;
+
+// wait states of a transfer accepted in this cycle
+wire [7:0] ws_mem  = xip ? ((m_haddr == xip_addr_r + 32'h4) ? xip_seq_wait_states : xip_wait_states) :
+                           wait_states + jitter_r;
+wire [7:0] ws_port = (single_port == 0) ? 8'h0 :
+                     (PRIORITY != 0)    ? other_wait_i : other_occ_i;
+wire [7:0] ws      = ws_mem + ws_port;
+
+always @(posedge hclk or negedge hresetn) begin
+  if (!hresetn) begin
+    wait_cnt   <= 8'h0;
+    first_r    <= 1'b0;
+    hold_r     <= 1'b0;
+    rdata_r    <= `HASTI_BUS_WIDTH'h0;
+    xip_addr_r <= `HASTI_ADDR_WIDTH'h0;
+    jitter_r   <= 8'h0;
+  end else begin
+    jitter_r <= (jitter != 0) ? ({$random(seed)} % (jitter + 1)) : 8'h0;
+    hold_r   <= (wait_cnt == 8'h1);
+    first_r  <= accept && (ws != 8'h0);
+    if (first_r)
+      rdata_r <= s_hrdata;
+    if (accept && xip)
+      xip_addr_r <= m_haddr;
+    if (wait_cnt != 8'h0)
+      wait_cnt <= wait_cnt - 8'h1;
+    else if (accept)
+      wait_cnt <= ws;
+  end
+end
+
+assign m_hready = (wait_cnt == 8'h0);
+assign m_hrdata = hold_r ? rdata_r : s_hrdata;
+assign s_htrans = (wait_cnt != 8'h0) ? `HASTI_TRANS_IDLE : m_htrans;
+
+assign occ_o    = accept ? (ws + 8'h1) : wait_cnt;
+assign wait_o   = wait_cnt;
+
+endmodule
@@ -0,0 +1,46 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : bench.h
+// Abstract      : Phase protocol of the testbench benchmark programs.
+//                 A program reports through DEBUG_OUT only:
+//                   PHASE_PASS (1) / PHASE_FAIL (0) end the run,
+//                   any other value marks the current phase.
+//                 run_bench_program (tb/test_tasks.vh) counts the
+//                 cycles spent in each phase and prints phases
+//                 2..253 per work unit. Setup and checking code runs
+//                 in PHASE_SETUP, which is not printed.
+//
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <stdint.h>
+#include <airisc.h>
+
+#define PHASE_FAIL  0
+#define PHASE_PASS  1
+#define PHASE_SETUP 254
+
+
+/**********************************************************************//**
+ * Enter a benchmark phase.
+ *
+ * @param[in] phase Phase number (2..253), PHASE_SETUP, PHASE_PASS or PHASE_FAIL.
+ **************************************************************************/
+static inline __attribute__ ((always_inline)) void bench_phase(uint32_t phase) {
+
+  DEBUG_OUT = phase;
+}
+
+#endif // BENCH_H_
@@ -0,0 +1,46 @@
+#
+# Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+# --- All rights reserved --- 
+# SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+# Licensed under the Solderpad Hardware License v 2.1 (the "License");
+# you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+# You may obtain a copy of the License at
+# https://solderpad.org/licenses/SHL-2.1/
+# Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and limitations under the License.
+#
+#
+# File             : bench.mk
+# Abstract         : Common makefile for the testbench benchmark programs.
+#                    Set BENCH_NAME and include this file.
+#                    The images are not part of the repository: run
+#                    "make tb_mem" here or in tb/sw for all of them, then
+#                    run .ci/regression.py --suites benchmark or simulate
+#                    with +bench_sw (tb/tests/benchmark_tests.vh).
+#                    Phase protocol: bench.h
+#
+
+# Memory layout of the simulation SRAM (256kB); keep the
+# DEBUG_OUT address (0x80010000) outside of RAM and CCRAM
+USER_FLAGS+="-Wl,--defsym,__airisc_ram_size=64k"
+USER_FLAGS+="-Wl,--defsym,__airisc_ccram_base=0x80020000"
+USER_FLAGS+="-Wl,--defsym,__airisc_ccram_size=16k"
+USER_FLAGS+="-Wl,--defsym,__airisc_xmem_size=0"
+
+EFFORT ?= -O2
+
+# Phase protocol (bench.h)
+APP_INC ?= -I . -I ..
+
+# Relative or absolute path to the "AIRISC Base Core" home folder
+AIRISC_HOME ?= ../../..
+include $(AIRISC_HOME)/bsp/common/common.mk
+
+# Install the memory image where tb/tests/benchmark_tests.vh expects it
+BENCH_MEM_PATH = $(AIRISC_HOME)/tb/memfiles/bench
+
+.PHONY: tb_mem
+tb_mem: $(APP_MEM)
+	@mkdir -p $(BENCH_MEM_PATH)
+	@cp $(APP_MEM) $(BENCH_MEM_PATH)/$(BENCH_NAME).mem
@@ -0,0 +1,101 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : main.c
+// Abstract      : Function call benchmark. Every phase executes 256
+//                 call/return pairs of small functions.
+//                 Phase 2: leaf function called from a loop
+//                 Phase 3: call chain of depth 4 (fits into the
+//                          default return address stack)
+//                 Phase 4: recursion of depth 16 (deeper than the
+//                          default return address stack)
+//                 Compare the cycles per pair for BRANCH_PREDICTION
+//                 and BP_RAS_DEPTH (airi5c_arch_options.vh).
+//
+
+#include <stdint.h>
+#include <airisc.h>
+#include "bench.h"
+
+#define PAIRS      256              // call/return pairs per phase
+#define CHAIN      4                // depth of the phase 3 call chain
+#define RECURSION  16               // calls per phase 4 recursion
+
+// noipa: keep every call (no inlining, cloning or constant propagation)
+#define CALLEE __attribute__ ((noipa))
+
+// the "+ 1" after each call prevents tail calls
+static CALLEE uint32_t leaf(uint32_t x) { return (x << 1) ^ 0x5a; }
+static CALLEE uint32_t chain3(uint32_t x) { return leaf(x) + 1; }
+static CALLEE uint32_t chain2(uint32_t x) { return chain3(x) + 1; }
+static CALLEE uint32_t chain1(uint32_t x) { return chain2(x) + 1; }
+
+static CALLEE uint32_t recurse(uint32_t x, int n) {
+
+  if (n == 0)
+    return x;
+  return recurse(x ^ (uint32_t)n, n - 1) + 1;
+}
+
+
+int main(void) {
+
+  uint32_t acc, ref;
+  int i;
+
+  bench_phase(PHASE_SETUP);
+
+  // phase 2: leaf calls
+  acc = 0;
+  bench_phase(2);
+  for (i = 0; i < PAIRS; i++)
+    acc = leaf(acc);
+  bench_phase(PHASE_SETUP);
+
+  ref = 0;
+  for (i = 0; i < PAIRS; i++)
+    ref = (ref << 1) ^ 0x5a;
+  if (acc != ref) goto fail;
+
+  // phase 3: call chain
+  acc = 0;
+  bench_phase(3);
+  for (i = 0; i < PAIRS / CHAIN; i++)
+    acc += chain1(i);
+  bench_phase(PHASE_SETUP);
+
+  ref = 0;
+  for (i = 0; i < PAIRS / CHAIN; i++)
+    ref += (((uint32_t)i << 1) ^ 0x5a) + 3;
+  if (acc != ref) goto fail;
+
+  // phase 4: recursion
+  acc = 0;
+  bench_phase(4);
+  for (i = 0; i < PAIRS / RECURSION; i++)
+    acc += recurse(i, RECURSION - 1);
+  bench_phase(PHASE_SETUP);
+
+  ref = 0;
+  // the XOR of 1..15 is 0
+  for (i = 0; i < PAIRS / RECURSION; i++)
+    ref += (uint32_t)i + RECURSION - 1;
+  if (acc != ref) goto fail;
+
+  bench_phase(PHASE_PASS);
+  return 0;
+
+fail:
+  bench_phase(PHASE_FAIL);
+  return 1;
+}
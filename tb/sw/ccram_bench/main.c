@@ -0,0 +1,109 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : main.c
+// Abstract      : CCRAM benchmark. Runs the same inference-style kernel
+//                 (bias add, ReLU, accumulate) with code and data in RAM
+//                 (phase 2), code in CCRAM (phase 3) and code and data
+//                 in CCRAM (phase 4). The gain is only visible with a
+//                 slower main RAM (testbench CONFIG_IDEAL_SRAM_CCRAM).
+//
+
+#include <stdint.h>
+#include <airisc.h>
+#include "bench.h"
+
+#define SIZE       256              // elements per kernel call
+#define ROUNDS     4                // 4 calls * 256 elements = 1024 elements per phase
+
+static int32_t ram_x[SIZE];
+static int32_t ram_b[SIZE];
+AIRISC_FAST_BSS static int32_t fast_x[SIZE];
+AIRISC_FAST_BSS static int32_t fast_b[SIZE];
+
+// keep the compiler from specializing the calls
+static volatile int size = SIZE;
+
+// the same kernel for both placements, no multiplications as
+// rv32i would call __mulsi3 in RAM
+#define KERNEL_BODY                        \
+  int32_t acc = 0;                         \
+  for (int i = 0; i < n; i++) {            \
+    int32_t v = x[i] + b[i];               \
+    if (v > 0)                             \
+      acc += v;                            \
+    acc ^= acc >> 7;                       \
+  }                                        \
+  return acc;
+
+
+static int32_t __attribute__ ((noinline)) kernel_ram(const int32_t* x, const int32_t* b, int n) {
+
+  KERNEL_BODY
+}
+
+
+AIRISC_FAST_CODE static int32_t kernel_fast(const int32_t* x, const int32_t* b, int n) {
+
+  KERNEL_BODY
+}
+
+
+/**********************************************************************//**
+ * Run one phase.
+ *
+ * @return Accumulated kernel results.
+ **************************************************************************/
+static int32_t run(int phase, int32_t (*fn)(const int32_t*, const int32_t*, int),
+                   const int32_t* x, const int32_t* b) {
+
+  int32_t res = 0;
+
+  bench_phase(phase);
+  for (int r = 0; r < ROUNDS; r++)
+    res += fn(x, b, size);
+  bench_phase(PHASE_SETUP);
+
+  return res;
+}
+
+
+int main(void) {
+
+  int32_t ref;
+
+  bench_phase(PHASE_SETUP);
+
+  for (int i = 0; i < SIZE; i++) {
+    ram_x[i]  = (int32_t)((i * 37) & 0xff) - 100;
+    ram_b[i]  = (int32_t)((i * 11) & 0x3f) - 20;
+    fast_x[i] = ram_x[i];
+    fast_b[i] = ram_b[i];
+  }
+
+  // phase 2: code and data in RAM
+  ref = run(2, kernel_ram, ram_x, ram_b);
+
+  // phase 3: code in CCRAM, data in RAM
+  if (run(3, kernel_fast, ram_x, ram_b) != ref) goto fail;
+
+  // phase 4: code and data in CCRAM
+  if (run(4, kernel_fast, fast_x, fast_b) != ref) goto fail;
+
+  bench_phase(PHASE_PASS);
+  return 0;
+
+fail:
+  bench_phase(PHASE_FAIL);
+  return 1;
+}
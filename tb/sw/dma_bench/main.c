@@ -0,0 +1,121 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : main.c
+// Abstract      : DMA benchmark. Compares a core copy loop against a
+//                 DMA memory to memory copy and moves a buffer through
+//                 the uart0 loopback with two handshaked DMA channels
+//                 (mem -> tx FIFO, rx FIFO -> mem), while the core
+//                 only waits for the completion interrupt.
+//
+
+#include <stdint.h>
+#include <airisc.h>
+#include "bench.h"
+
+#define SIZE       1024             // bytes per phase
+#define UART0_CPB  16               // cycles per bit, fast loopback in simulation
+
+#define CH_TX      0
+#define CH_RX      1
+
+#define PHASE_CORE_COPY 2
+#define PHASE_DMA_COPY  4
+#define PHASE_DMA_UART  6
+
+static uint32_t src_buf[SIZE/4];
+static uint32_t dst_buf[SIZE/4];
+
+static volatile int rx_done;
+static volatile int rx_error;
+
+
+/**********************************************************************//**
+ * DMA completion callback (interrupt context).
+ **************************************************************************/
+static void rx_callback(int ch, int error) {
+
+  (void)ch;
+  rx_error = error;
+  rx_done = 1;
+}
+
+
+/**********************************************************************//**
+ * Compare and clear the destination buffer.
+ *
+ * @return 0 if dst_buf matches src_buf.
+ **************************************************************************/
+static int check_dst(void) {
+
+  bench_phase(PHASE_SETUP);
+
+  for (int i = 0; i < SIZE/4; i++) {
+    if (dst_buf[i] != src_buf[i])
+      return 1;
+    dst_buf[i] = 0;
+  }
+  return 0;
+}
+
+
+int main(void) {
+
+  int i;
+
+  bench_phase(PHASE_SETUP);
+
+  for (i = 0; i < SIZE/4; i++)
+    src_buf[i] = 0x01020304 * (uint32_t)(i + 1);
+
+  // core copy loop
+  bench_phase(PHASE_CORE_COPY);
+  for (i = 0; i < SIZE/4; i++)
+    dst_buf[i] = src_buf[i];
+  if (check_dst())
+    goto fail;
+
+  // DMA copy, polled
+  bench_phase(PHASE_DMA_COPY);
+  if (dma_memcpy(dma0, CH_TX, dst_buf, src_buf, SIZE) || dma_wait(dma0, CH_TX))
+    goto fail;
+  if (check_dst())
+    goto fail;
+
+  // uart0 loopback via DMA, completion interrupt
+  uart_init(uart0, UART_DATA_BITS_8, UART_PARITY_NONE, UART_STOP_BITS_1, UART_FLOW_CTRL_NONE, UART0_CPB);
+  uart_clrRxFIFO(uart0);
+  dma_set_callback(CH_RX, rx_callback);
+  cpu_csr_set(CSR_MIE, 1UL << (IRQ_XIRQ0 + DMA0_XIRQ));
+  cpu_csr_set(CSR_MSTATUS, 1UL << MSTATUS_MIE);
+
+  bench_phase(PHASE_DMA_UART);
+  if (dma_start(dma0, CH_RX, &uart0->DATA, dst_buf, SIZE,
+                (DMA_SIZE_BYTE << DMA_CTRL_SIZE_POS) | DMA_CTRL_DST_INC | DMA_CTRL_IE |
+                DMA_CTRL_HS_EN | (DMA_REQ_UART0_RX << DMA_CTRL_HS_SEL_POS)))
+    goto fail;
+  if (dma_to_periph(dma0, CH_TX, &uart0->DATA, (const uint8_t*)src_buf, SIZE, DMA_REQ_UART0_TX))
+    goto fail;
+  while (!rx_done);
+
+  cpu_csr_clr(CSR_MSTATUS, 1UL << MSTATUS_MIE);
+  if (rx_error || dma_wait(dma0, CH_TX) || check_dst())
+    goto fail;
+
+  bench_phase(PHASE_PASS);
+  return 0;
+
+fail:
+  bench_phase(PHASE_FAIL);
+  return 1;
+}
@@ -0,0 +1,112 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : main.c
+// Abstract      : Float dot product benchmark, 256 elements (512 FLOPs)
+//                 per phase.
+//                 Phase 2: one accumulator, fmadd.s (dependent chain)
+//                 Phase 3: four accumulators, fmadd.s
+//                 Phase 4: four accumulators, fmul.s + fadd.s
+//                 Phase 5: axpy (y = a * x + y), fmadd.s
+//                 Compare with and without FPU_PIPELINED
+//                 (airi5c_arch_options.vh).
+//                 The inputs are small integers, so all sums are
+//                 exact and every phase has to match the integer
+//                 reference.
+//
+
+#include <stdint.h>
+#include <math.h>
+#include <airisc.h>
+#include "bench.h"
+
+#define N          256              // elements per phase
+
+static float x[N], y[N], z[N];
+static int32_t xi[N], yi[N];
+
+// keep the compiler from unrolling on its own
+static volatile int n_elem = N;
+
+
+int main(void) {
+
+  uint32_t seed = 0x12345678;
+  int32_t ref = 0;
+  float acc0, acc1, acc2, acc3;
+  int i, n;
+
+  bench_phase(PHASE_SETUP);
+
+  // integers in -64..63, |sum| < 2^24
+  for (i = 0; i < N; i++) {
+    seed = seed * 1664525 + 1013904223;
+    xi[i] = (int32_t)(seed >> 25) - 64;
+    seed = seed * 1664525 + 1013904223;
+    yi[i] = (int32_t)(seed >> 25) - 64;
+    x[i] = (float)xi[i];
+    y[i] = (float)yi[i];
+    ref += xi[i] * yi[i];
+  }
+
+  n = n_elem;
+
+  // phase 2: one accumulator, every fmadd waits for the previous one
+  acc0 = 0.0f;
+  bench_phase(2);
+  for (i = 0; i < n; i++)
+    acc0 = fmaf(x[i], y[i], acc0);
+  bench_phase(PHASE_SETUP);
+  if ((int32_t)acc0 != ref) goto fail;
+
+  // phase 3: four independent accumulators
+  acc0 = acc1 = acc2 = acc3 = 0.0f;
+  bench_phase(3);
+  for (i = 0; i < n; i += 4) {
+    acc0 = fmaf(x[i+0], y[i+0], acc0);
+    acc1 = fmaf(x[i+1], y[i+1], acc1);
+    acc2 = fmaf(x[i+2], y[i+2], acc2);
+    acc3 = fmaf(x[i+3], y[i+3], acc3);
+  }
+  bench_phase(PHASE_SETUP);
+  if ((int32_t)((acc0 + acc1) + (acc2 + acc3)) != ref) goto fail;
+
+  // phase 4: four accumulators, separate multiply and add (-ffp-contract=off)
+  acc0 = acc1 = acc2 = acc3 = 0.0f;
+  bench_phase(4);
+  for (i = 0; i < n; i += 4) {
+    acc0 += x[i+0] * y[i+0];
+    acc1 += x[i+1] * y[i+1];
+    acc2 += x[i+2] * y[i+2];
+    acc3 += x[i+3] * y[i+3];
+  }
+  bench_phase(PHASE_SETUP);
+  if ((int32_t)((acc0 + acc1) + (acc2 + acc3)) != ref) goto fail;
+
+  // phase 5: axpy with a = 3, z = 3 * x + y
+  bench_phase(5);
+  for (i = 0; i < n; i++)
+    z[i] = fmaf(3.0f, x[i], y[i]);
+  bench_phase(PHASE_SETUP);
+  for (i = 0; i < N; i++) {
+    if ((int32_t)z[i] != 3 * xi[i] + yi[i])
+      goto fail;
+  }
+
+  bench_phase(PHASE_PASS);
+  return 0;
+
+fail:
+  bench_phase(PHASE_FAIL);
+  return 1;
+}
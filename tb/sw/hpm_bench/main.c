@@ -0,0 +1,121 @@
+//
+// Copyright 2026 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : main.c
+// Abstract      : Hardware performance counter check, needs
+//                 HPM_COUNTERS >= 2 (airi5c_arch_options.vh).
+//                 mhpmcounter3: load-use stalls, 4: interrupts taken.
+//                 Phase 2: pointer chase with counter 3 inhibited
+//                 Phase 3: pointer chase (>= 1 load-use stall per
+//                          pair of loads)
+//                 Phase 4: machine timer interrupts (counted exactly)
+//
+
+#include <stdint.h>
+#include <airisc.h>
+#include "bench.h"
+
+#define ITEMS      64               // loads / interrupts per phase
+
+static uint32_t chain[ITEMS];       // address of the next element
+static volatile uint32_t fired;
+
+
+/**********************************************************************//**
+ * Direct mode handler (overrides the weak default).
+ **************************************************************************/
+void interrupt_handler(uint32_t cause, uint32_t epc) {
+
+  (void)epc;
+
+  if (cause == MCAUSE_TIMER_INT_M) {
+    timer0->TIMECMPH = 0xFFFFFFFF;
+    fired++;
+  }
+}
+
+
+/**********************************************************************//**
+ * Follow the chain, every load address is the result of the previous load.
+ * The second load of each pair directly uses the first (load-use stall).
+ *
+ * @param[in] phase Benchmark phase (see bench.h).
+ **************************************************************************/
+static void chase(uint32_t phase) {
+
+  uint32_t p = (uint32_t)&chain[0];
+
+  bench_phase(phase);
+  for (int i = 0; i < ITEMS / 2; i++) {
+    asm volatile ("lw %0, 0(%0) \n lw %0, 0(%0)" : "+r" (p) : : "memory");
+  }
+  bench_phase(PHASE_SETUP);
+}
+
+
+int main(void) {
+
+  uint32_t start;
+
+  bench_phase(PHASE_SETUP);
+
+  for (int i = 0; i < ITEMS; i++) {
+    chain[i] = (uint32_t)&chain[(i * 17 + 5) % ITEMS];
+  }
+
+  // mhpmevent is WARL, unsupported events read back as NONE
+  cpu_csr_write(CSR_MHPMEVENT3, 0xFFFFFFFF);
+  if (cpu_csr_read(CSR_MHPMEVENT3) != HPM_EVENT_NONE) goto fail;
+
+  cpu_csr_write(CSR_MHPMEVENT3, HPM_EVENT_LOAD_USE);
+  cpu_csr_write(CSR_MHPMEVENT4, HPM_EVENT_IRQ);
+  if (cpu_csr_read(CSR_MHPMEVENT4) != HPM_EVENT_IRQ) goto fail;
+  cpu_csr_write(CSR_MHPMCOUNTER3, 0);
+  cpu_csr_write(CSR_MHPMCOUNTER3H, 0);
+  cpu_csr_write(CSR_MHPMCOUNTER4, 0);
+
+  // phase 2: counter 3 stopped
+  cpu_csr_set(CSR_MCOUNTINHIBIT, 1UL << 3);
+  chase(2);
+  if (cpu_csr_read(CSR_MHPMCOUNTER3) != 0) goto fail;
+  cpu_csr_clr(CSR_MCOUNTINHIBIT, 1UL << 3);
+
+  // phase 3: counter 3 running
+  start = cpu_csr_read(CSR_HPMCOUNTER3);
+  chase(3);
+  if ((cpu_csr_read(CSR_HPMCOUNTER3) - start) < ITEMS / 2) goto fail;
+
+  // phase 4: timer interrupts
+  timer0->TIMECMPH = 0xFFFFFFFF;
+  timer0->TIMECMPL = 0;
+  irq_enable(IRQ_MTI);
+  cpu_csr_set(CSR_MSTATUS, 1UL << MSTATUS_MIE);
+
+  for (int r = 0; r < ITEMS; r++) {
+    fired = 0;
+    bench_phase(4);
+    timer0->TIMECMPH = 0; // timecmp in the past -> MTIP
+    while (fired == 0);
+    bench_phase(PHASE_SETUP);
+  }
+
+  cpu_csr_clr(CSR_MSTATUS, 1UL << MSTATUS_MIE);
+  if (cpu_csr_read(CSR_MHPMCOUNTER4) != ITEMS) goto fail;
+
+  bench_phase(PHASE_PASS);
+  return 0;
+
+fail:
+  bench_phase(PHASE_FAIL);
+  return 1;
+}
@@ -0,0 +1,117 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : main.c
+// Abstract      : Interrupt latency benchmark. Fires the machine timer
+//                 interrupt by moving timecmp into the past and measures
+//                 the entry latency (trigger -> first handler statement)
+//                 and the exit latency (-> back in main).
+//                 Phase 2/3: direct mode, __trap_entry + interrupt_handler()
+//                 Phase 4/5: vectored mode, handler registered with
+//                            irq_set_handler()
+//
+
+#include <stdint.h>
+#include <airisc.h>
+#include "bench.h"
+
+#define ROUNDS     16               // interrupts per phase
+
+static volatile uint32_t exit_phase;
+static volatile uint32_t fired;
+static volatile uint32_t vectored;
+
+
+/**********************************************************************//**
+ * Common handler body: start the exit phase and disarm the timer.
+ **************************************************************************/
+static inline void timer_irq(void) {
+
+  bench_phase(exit_phase);
+  timer0->TIMECMPH = 0xFFFFFFFF;
+  fired++;
+}
+
+
+/**********************************************************************//**
+ * Direct mode handler (overrides the weak default).
+ **************************************************************************/
+void interrupt_handler(uint32_t cause, uint32_t epc) {
+
+  (void)epc;
+
+  if (cause == MCAUSE_TIMER_INT_M) {
+    timer_irq();
+  }
+}
+
+
+/**********************************************************************//**
+ * Vectored mode handler.
+ **************************************************************************/
+static void timer_handler(void) {
+
+  timer_irq();
+  vectored++;
+}
+
+
+/**********************************************************************//**
+ * Fire the timer interrupt ROUNDS times.
+ *
+ * @param[in] phase Entry latency phase, phase + 1 is the exit latency.
+ **************************************************************************/
+static void run(uint32_t phase) {
+
+  for (int r = 0; r < ROUNDS; r++) {
+    fired = 0;
+    exit_phase = phase + 1;
+
+    bench_phase(phase);
+    timer0->TIMECMPH = 0; // timecmp in the past -> MTIP
+    while (fired == 0);
+    bench_phase(PHASE_SETUP);
+  }
+}
+
+
+int main(void) {
+
+  bench_phase(PHASE_SETUP);
+
+  // disarm the timer, then enable the timer interrupt
+  timer0->TIMECMPH = 0xFFFFFFFF;
+  timer0->TIMECMPL = 0;
+  irq_enable(IRQ_MTI);
+  cpu_csr_set(CSR_MSTATUS, 1UL << MSTATUS_MIE);
+
+  // phase 2/3: direct mode
+  run(2);
+  if (vectored != 0) goto fail;
+
+  // phase 4/5: vectored mode
+  if (irq_set_handler(IRQ_MTI, timer_handler)) goto fail;
+  irq_vectored_enable();
+  run(4);
+  if (vectored != ROUNDS) goto fail;
+
+  irq_vectored_disable();
+  cpu_csr_clr(CSR_MSTATUS, 1UL << MSTATUS_MIE);
+
+  bench_phase(PHASE_PASS);
+  return 0;
+
+fail:
+  bench_phase(PHASE_FAIL);
+  return 1;
+}
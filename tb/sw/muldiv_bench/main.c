@@ -0,0 +1,179 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : main.c
+// Abstract      : MUL/DIV benchmark with fixed-point filter style
+//                 operations, 256 operations per phase.
+//                 Phase 2: Q31 multiply (mul + mulh)
+//                 Phase 3: division, 16-bit operands
+//                 Phase 4: remainder, 16-bit operands
+//                 Phase 5: division, Q15 scaled (full width) dividends
+//                 Phase 6: Q15 dot product, 4 independent MACs per
+//                          iteration (back-to-back MULs)
+//                 Compare with and without ARCH_M_FAST, ARCH_M_PIPELINED and
+//                 ARCH_M_SCOREBOARD (airi5c_arch_options.vh).
+//
+
+#include <stdint.h>
+#include <airisc.h>
+#include "bench.h"
+
+#define OPS        256              // operations per phase
+
+static int32_t a[OPS], b[OPS];      // Q31
+static int32_t x[OPS], y[OPS];      // Q15
+static int32_t res[OPS];
+
+// keep the compiler from vectorizing/unrolling on its own
+static volatile int ops = OPS;
+
+
+/**********************************************************************//**
+ * Run one phase: res[i] = expr for all i.
+ **************************************************************************/
+#define RUN(phase, expr)                      \
+  do {                                        \
+    bench_phase(phase);                       \
+    for (int i = 0; i < OPS; i++)             \
+      res[i] = (expr);                        \
+    bench_phase(PHASE_SETUP);                 \
+  } while (0)
+
+
+/**********************************************************************//**
+ * Check the Q31 products with a shift-and-add reference.
+ *
+ * @return 0 if all results match, -1 otherwise.
+ **************************************************************************/
+static int check_mul(void) {
+
+  for (int i = 0; i < OPS; i++) {
+    uint64_t ua = (a[i] < 0) ? -(int64_t)a[i] : a[i];
+    uint64_t ub = (b[i] < 0) ? -(int64_t)b[i] : b[i];
+    uint64_t p = 0;
+    for (int k = 0; k < 32; k++) {
+      if ((ub >> k) & 1)
+        p += ua << k;
+    }
+    if ((a[i] < 0) != (b[i] < 0))
+      p = -p;
+    if ((int32_t)((int64_t)p >> 31) != res[i])
+      return -1;
+  }
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Check the results with the shift-and-subtract reference.
+ *
+ * @return 0 if all results match, -1 otherwise.
+ **************************************************************************/
+static int check_div(int rem) {
+
+  for (int i = 0; i < OPS; i++) {
+    uint32_t a = (x[i] < 0) ? -(uint32_t)x[i] : (uint32_t)x[i];
+    uint32_t d = (y[i] < 0) ? -(uint32_t)y[i] : (uint32_t)y[i];
+    uint32_t q = 0, r = 0;
+    for (int b = 31; b >= 0; b--) {
+      r = (r << 1) | ((a >> b) & 1);
+      if (r >= d) {
+        r -= d;
+        q |= 1UL << b;
+      }
+    }
+    if (rem) {
+      if ((int32_t)((x[i] < 0) ? -r : r) != res[i])
+        return -1;
+    } else {
+      if ((int32_t)(((x[i] < 0) != (y[i] < 0)) ? -q : q) != res[i])
+        return -1;
+    }
+  }
+  return 0;
+}
+
+
+int main(void) {
+
+  uint32_t seed = 0x12345678;
+  int i;
+
+  bench_phase(PHASE_SETUP);
+
+  // Q31/Q15 samples and coefficients, never zero
+  for (i = 0; i < OPS; i++) {
+    seed = seed * 1664525 + 1013904223;
+    a[i] = (int32_t)seed;
+    seed = seed * 1664525 + 1013904223;
+    b[i] = (int32_t)seed;
+    seed = seed * 1664525 + 1013904223;
+    x[i] = (int16_t)(seed >> 16);
+    seed = seed * 1664525 + 1013904223;
+    y[i] = (int16_t)(seed >> 16) | 1;
+  }
+
+  // phase 2: Q31 multiply, 64-bit product
+  RUN(2, (int32_t)(((int64_t)a[i] * b[i]) >> 31));
+  if (check_mul()) goto fail;
+
+  // phase 3: division, 16-bit operands
+  RUN(3, x[i] / y[i]);
+  if (check_div(0)) goto fail;
+
+  // phase 4: remainder, 16-bit operands
+  RUN(4, x[i] % y[i]);
+  if (check_div(1)) goto fail;
+
+  // phase 5: Q15 division, full width dividend
+  for (i = 0; i < OPS; i++)
+    x[i] = x[i] * 32768;
+  RUN(5, x[i] / y[i]);
+  if (check_div(0)) goto fail;
+
+  // phase 6: dot product (x is Q30 now, so use the upper half)
+  for (i = 0; i < OPS; i++)
+    x[i] = x[i] >> 15;
+  {
+    uint32_t acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0, ref = 0; // wrap around, no UB
+    int n = ops;
+
+    bench_phase(6);
+    for (i = 0; i < n; i += 4) {
+      acc0 += (uint32_t)(x[i+0] * y[i+0]);
+      acc1 += (uint32_t)(x[i+1] * y[i+1]);
+      acc2 += (uint32_t)(x[i+2] * y[i+2]);
+      acc3 += (uint32_t)(x[i+3] * y[i+3]);
+    }
+    bench_phase(PHASE_SETUP);
+
+    for (i = 0; i < OPS; i++) {
+      uint32_t p = 0;
+      for (int k = 0; k < 16; k++) {
+        if (((uint32_t)y[i] >> k) & 1)
+          p += (uint32_t)x[i] << k;
+      }
+      if (y[i] < 0)
+        p -= (uint32_t)x[i] << 16;
+      ref += p;
+    }
+    if (acc0 + acc1 + acc2 + acc3 != ref) goto fail;
+  }
+
+  bench_phase(PHASE_PASS);
+  return 0;
+
+fail:
+  bench_phase(PHASE_FAIL);
+  return 1;
+}
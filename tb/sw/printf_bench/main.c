@@ -0,0 +1,87 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : main.c
+// Abstract      : Formatted printing benchmark with a telemetry-style
+//                 line (hex, unsigned and signed decimal fields).
+//                 Phase 2: newlib sprintf (reference)
+//                 Phase 3: ee_sprintf (formatting only)
+//                 Phase 4: ee_printf (formatting and bulk UART write,
+//                          the tx FIFO is cleared before each line)
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <airisc.h>
+#include <ee_printf.h>
+#include "bench.h"
+
+#define LINES      16               // formatted lines per phase
+#define UART0_CPB  16               // cycles per bit, fast loopback in simulation
+
+// at most 31 characters, so every line fits into the tx FIFO
+#define LINE_FMT   "%08x %u %d %5d\r\n"
+
+static char ref_buf[LINES][64];
+static char out_buf[64];
+
+
+/**********************************************************************//**
+ * Telemetry values of line i.
+ **************************************************************************/
+static unsigned val_hex(int i) { return 0x1234abcdU ^ ((unsigned)i << 20); }
+static unsigned val_dec(int i) { return 123456U + (unsigned)i * 7919; }
+static int      val_neg(int i) { return -4711 - i * 13; }
+static int      val_pad(int i) { return i * 97; }
+
+
+int main(void) {
+
+  int i;
+
+  bench_phase(PHASE_SETUP);
+
+  uart_init(uart0, UART_DATA_BITS_8, UART_PARITY_NONE, UART_STOP_BITS_1, UART_FLOW_CTRL_NONE, UART0_CPB);
+
+  // phase 2: newlib
+  for (i = 0; i < LINES; i++) {
+    bench_phase(2);
+    sprintf(ref_buf[i], LINE_FMT, val_hex(i), val_dec(i), val_neg(i), val_pad(i));
+    bench_phase(PHASE_SETUP);
+  }
+
+  // phase 3: ee_sprintf, compared against newlib
+  for (i = 0; i < LINES; i++) {
+    bench_phase(3);
+    ee_sprintf(out_buf, LINE_FMT, val_hex(i), val_dec(i), val_neg(i), val_pad(i));
+    bench_phase(PHASE_SETUP);
+    if (strcmp(out_buf, ref_buf[i]))
+      goto fail;
+  }
+
+  // phase 4: ee_printf
+  for (i = 0; i < LINES; i++) {
+    uart_clrTxFIFO(uart0);
+    bench_phase(4);
+    ee_printf(LINE_FMT, val_hex(i), val_dec(i), val_neg(i), val_pad(i));
+    bench_phase(PHASE_SETUP);
+  }
+
+  bench_phase(PHASE_PASS);
+  return 0;
+
+fail:
+  bench_phase(PHASE_FAIL);
+  return 1;
+}
@@ -0,0 +1,135 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : main.c
+// Abstract      : Memory routine benchmark. Compares newlib's
+//                 memcpy/memset/memmove (even phases) against the BSP
+//                 versions airisc_mem* (odd phases).
+//
+
+#include <stdint.h>
+#include <string.h>
+#include <airisc.h>
+#include "bench.h"
+
+#define SIZE       1024             // bytes per call
+#define ROUNDS     4                // 4 calls * 1024 bytes = 4096 bytes per phase
+
+typedef void* (*copy_fn_t)(void*, const void*, size_t);
+typedef void* (*set_fn_t)(void*, int, size_t);
+
+static uint8_t src_buf[SIZE + 8] __attribute__ ((aligned(4)));
+static uint8_t dst_buf[SIZE + 8] __attribute__ ((aligned(4)));
+static uint8_t ref_buf[SIZE + 8] __attribute__ ((aligned(4)));
+
+// keep the compiler from inlining or specializing the calls
+static volatile size_t size = SIZE;
+
+
+/**********************************************************************//**
+ * Reset the buffers to a known pattern.
+ **************************************************************************/
+static void init_bufs(void) {
+
+  bench_phase(PHASE_SETUP);
+
+  for (int i = 0; i < SIZE + 8; i++) {
+    src_buf[i] = (uint8_t)(i * 7 + 1);
+    dst_buf[i] = (uint8_t)(i * 3);
+  }
+}
+
+
+/**********************************************************************//**
+ * Compare dst_buf against ref_buf.
+ *
+ * @return 0 if both buffers match.
+ **************************************************************************/
+static int check_dst(void) {
+
+  bench_phase(PHASE_SETUP);
+
+  for (int i = 0; i < SIZE + 8; i++) {
+    if (dst_buf[i] != ref_buf[i])
+      return 1;
+  }
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Run one copy phase and keep the result as reference (newlib) or
+ * compare it against the reference (BSP).
+ **************************************************************************/
+static int run_copy(int phase, copy_fn_t fn, uint8_t* dst, const uint8_t* src, int keep) {
+
+  init_bufs();
+  bench_phase(phase);
+  for (int r = 0; r < ROUNDS; r++)
+    fn(dst, src, size);
+
+  if (keep) {
+    bench_phase(PHASE_SETUP);
+    for (int i = 0; i < SIZE + 8; i++)
+      ref_buf[i] = dst_buf[i];
+    return 0;
+  }
+  return check_dst();
+}
+
+
+/**********************************************************************//**
+ * Run one fill phase, see run_copy().
+ **************************************************************************/
+static int run_set(int phase, set_fn_t fn, uint8_t* dst, int keep) {
+
+  init_bufs();
+  bench_phase(phase);
+  for (int r = 0; r < ROUNDS; r++)
+    fn(dst, 0x5A + r, size);
+
+  if (keep) {
+    bench_phase(PHASE_SETUP);
+    for (int i = 0; i < SIZE + 8; i++)
+      ref_buf[i] = dst_buf[i];
+    return 0;
+  }
+  return check_dst();
+}
+
+
+int main(void) {
+
+  // phase 2/3: memcpy, aligned
+  if (run_copy(2, memcpy,        dst_buf, src_buf, 1)) goto fail;
+  if (run_copy(3, airisc_memcpy, dst_buf, src_buf, 0)) goto fail;
+
+  // phase 4/5: memcpy, source and destination differently aligned
+  if (run_copy(4, memcpy,        dst_buf + 2, src_buf + 1, 1)) goto fail;
+  if (run_copy(5, airisc_memcpy, dst_buf + 2, src_buf + 1, 0)) goto fail;
+
+  // phase 6/7: memset, unaligned destination
+  if (run_set(6, memset,        dst_buf + 1, 1)) goto fail;
+  if (run_set(7, airisc_memset, dst_buf + 1, 0)) goto fail;
+
+  // phase 8/9: memmove, overlapping with dst > src
+  if (run_copy(8, memmove,        dst_buf + 4, dst_buf, 1)) goto fail;
+  if (run_copy(9, airisc_memmove, dst_buf + 4, dst_buf, 0)) goto fail;
+
+  bench_phase(PHASE_PASS);
+  return 0;
+
+fail:
+  bench_phase(PHASE_FAIL);
+  return 1;
+}
@@ -0,0 +1,102 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+//
+// File          : main.c
+// Abstract      : TRNG read-out benchmark. Waits until the random pool
+//                 (FIFO) is full (STAT register) and measures how fast
+//                 it is drained.
+//                 Phase 2: byte mode, trng_get() per byte
+//                 Phase 3: byte mode, trng_fill()
+//                 Phase 4: word mode, trng_fill()
+//
+
+#include <stdint.h>
+#include <airisc.h>
+#include "bench.h"
+
+#define FIFO_DEPTH 8                // TRNG FIFO entries (tb/configs/airi5c_top_asic.v)
+#define BYTES      128              // random bytes per phase
+
+static uint8_t buf[FIFO_DEPTH * 4];
+
+
+/**********************************************************************//**
+ * Wait until the random pool is full.
+ **************************************************************************/
+static void wait_full(void) {
+
+  while (!trng_is_full(trng));
+}
+
+
+/**********************************************************************//**
+ * Check that the buffer is not constant (catches a disabled TRNG or
+ * masked data).
+ **************************************************************************/
+static int check(const uint8_t* b, int n) {
+
+  for (int i = 1; i < n; i++) {
+    if (b[i] != b[0])
+      return 0;
+  }
+  return -1;
+}
+
+
+int main(void) {
+
+  int r, i;
+
+  bench_phase(PHASE_SETUP);
+
+  trng_enable(trng);
+
+  // phase 2: byte mode, trng_get
+  for (r = 0; r < BYTES / FIFO_DEPTH; r++) {
+    wait_full();
+    bench_phase(2);
+    for (i = 0; i < FIFO_DEPTH; i++)
+      buf[i] = trng_get(trng);
+    bench_phase(PHASE_SETUP);
+    if (check(buf, FIFO_DEPTH)) goto fail;
+  }
+
+  // phase 3: byte mode, trng_fill
+  for (r = 0; r < BYTES / FIFO_DEPTH; r++) {
+    wait_full();
+    bench_phase(3);
+    trng_fill(trng, buf, FIFO_DEPTH);
+    bench_phase(PHASE_SETUP);
+    if (check(buf, FIFO_DEPTH)) goto fail;
+  }
+
+  // phase 4: word mode, trng_fill
+  trng_word_mode(trng, 1);
+  for (r = 0; r < BYTES / (FIFO_DEPTH * 4); r++) {
+    wait_full();
+    bench_phase(4);
+    trng_fill(trng, buf, FIFO_DEPTH * 4);
+    bench_phase(PHASE_SETUP);
+    if (check(buf, FIFO_DEPTH * 4)) goto fail;
+  }
+
+  trng_disable(trng);
+
+  bench_phase(PHASE_PASS);
+  return 0;
+
+fail:
+  bench_phase(PHASE_FAIL);
+  return 1;
+}
@@ -0,0 +1,125 @@
+//
+// Copyright 2023 FRAUNHOFER INSTITUTE OF MICROELECTRONIC CIRCUITS AND SYSTEMS (IMS), DUISBURG, GERMANY.
+// --- All rights reserved ---
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+// Licensed under the Solderpad Hardware License v 2.1 (the "License");
+// you may not use this file except in compliance with the License, or, at your option, the Apache License version 2.0.
+// You may obtain a copy of the License at
+// https://solderpad.org/licenses/SHL-2.1/
+// Unless required by applicable law or agreed to in writing, any work distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+//
+//
+// File          : main.c
+// Abstract      : UART FIFO access benchmark. Compares the per-byte
+//                 access (uart_writeByte/uart_readByte) against the
+//                 burst access (uart_writeData/uart_readData).
+//
+
+#include <stdint.h>
+#include <airisc.h>
+#include "bench.h"
+
+#define ROUNDS     16               // 16 rounds * 32 bytes = 512 bytes per phase
+#define CHUNK      UART_FIFO_DEPTH  // bytes per round, fits into the empty FIFO
+#define UART0_CPB  16               // cycles per bit, fast loopback in simulation
+
+#define PHASE_TX_BYTE  2
+#define PHASE_TX_BURST 4
+#define PHASE_RX_BYTE  6
+#define PHASE_RX_BURST 8
+
+static uint8_t tx_buf[CHUNK];
+static uint8_t rx_buf[CHUNK];
+
+
+/**********************************************************************//**
+ * Fill the rx FIFO with one chunk via the tx -> rx loopback.
+ **************************************************************************/
+static void fill_rx(void) {
+
+  bench_phase(PHASE_SETUP);
+
+  uart_clrRxFIFO(uart0);
+  uart_writeData(uart0, tx_buf, CHUNK);
+  while (uart_getRxSize(uart0) < CHUNK);
+}
+
+
+/**********************************************************************//**
+ * Check the received chunk.
+ *
+ * @return 0 if rx_buf matches tx_buf.
+ **************************************************************************/
+static int check_rx(void) {
+
+  bench_phase(PHASE_SETUP);
+
+  for (int i = 0; i < CHUNK; i++) {
+    if (rx_buf[i] != tx_buf[i])
+      return 1;
+    rx_buf[i] = 0;
+  }
+  return 0;
+}
+
+
+int main(void) {
+
+  int r, i;
+
+  bench_phase(PHASE_SETUP);
+
+  for (i = 0; i < CHUNK; i++)
+    tx_buf[i] = (uint8_t)(0x41 + i);
+
+  uart_init(uart0, UART_DATA_BITS_8, UART_PARITY_NONE, UART_STOP_BITS_1, UART_FLOW_CTRL_NONE, UART0_CPB);
+
+  // tx: start each round with an empty FIFO, so only the access cost is measured
+  for (r = 0; r < ROUNDS; r++) {
+    bench_phase(PHASE_SETUP);
+    uart_clrTxFIFO(uart0);
+    bench_phase(PHASE_TX_BYTE);
+    for (i = 0; i < CHUNK; i++)
+      uart_writeByte(uart0, tx_buf[i]);
+  }
+
+  for (r = 0; r < ROUNDS; r++) {
+    bench_phase(PHASE_SETUP);
+    uart_clrTxFIFO(uart0);
+    bench_phase(PHASE_TX_BURST);
+    uart_writeData(uart0, tx_buf, CHUNK);
+  }
+
+  // let the last frame leave the shift register
+  bench_phase(PHASE_SETUP);
+  while (!uart_isTxEmpty(uart0));
+  for (i = 0; i < 16 * UART0_CPB; i++)
+    asm volatile ("nop");
+
+  // rx: start each round with a full FIFO
+  for (r = 0; r < ROUNDS; r++) {
+    fill_rx();
+    bench_phase(PHASE_RX_BYTE);
+    for (i = 0; i < CHUNK; i++)
+      rx_buf[i] = uart_readByte(uart0);
+    if (check_rx())
+      goto fail;
+  }
+
+  for (r = 0; r < ROUNDS; r++) {
+    fill_rx();
+    bench_phase(PHASE_RX_BURST);
+    uart_readData(uart0, rx_buf, CHUNK);
+    if (check_rx())
+      goto fail;
+  }
+
+  bench_phase(PHASE_PASS);
+  return 0;
+
+fail:
+  bench_phase(PHASE_FAIL);
+  return 1;
+}
@@ -15,10 +15,174 @@
 // Author            : A. Stanitzki
 // Creation Date     : 09.10.20
 // Last Modified     : 15.02.21       
-// Abstract          : Definitions of test tasks 
+// Abstract          : Definitions of test tasks
 //
 
 
+// Program loading: configurations that define TB_MEM (the memory array
+// behind 0x80000000, see airi5c_top_tb.v) get the image in memimg copied
+// directly into the array, which takes no simulation time. Otherwise, or
+// when JTAG_LOAD is defined / the simulation runs with +jtag_load, every
+// word is written through the debug module (bulk = 1: use the
+// jtag_write_mem_bulk sequence, preceded by a 300 cycle pause).
+reg tb_jtag_load = 1'b0;
+
+initial begin
+`ifdef JTAG_LOAD
+  tb_jtag_load = 1'b1;
+`else
+  if ($test$plusargs("jtag_load"))
+    tb_jtag_load = 1'b1;
+`endif
+end
+
+task load_program;
+input reg[15:0]   length;
+input reg         bulk;
+output reg[31:0]  result;
+integer k;
+begin
+  result = 0;
+`ifdef TB_MEM
+  if (!tb_jtag_load) begin
+    for (k = 0; k < length; k = k + 1)
+      `TB_MEM[k] = memimg[k];
+  end else
+`endif
+  if (bulk) begin
+    #(300*`CORE_CLK_PERIOD);
+    jtag_write_mem(32'h80000000,memimg[0],result);
+    jtag_write_mem_bulk_init;
+    for (k = 1; k < length; k = k + 1)
+      jtag_write_mem_bulk(32'h80000000 + k*4,memimg[k],result);
+    jtag_write_mem_bulk_end;
+  end else begin
+    for (k = 0; k < length; k = k + 1)
+      jtag_write_mem(32'h80000000 + k*4,memimg[k],result);
+  end
+end
+endtask
+
+
+// Test end detection: programs end by storing their result to a
+// mailbox, either DEBUG_OUT (0x80010000, see airisc.h; 1 = pass,
+// 0 = fail, other values are benchmark phase markers) or the tohost
+// word of the riscv-tests (1 = pass, (testnum << 1) | 1 = fail).
+// The tohost address of each image is looked up in
+// memfiles/tohost.lst (generated by .ci/gen_tohost.py from the ELF
+// symbol or the image, see select_tohost). Images that are not listed
+// use tb_tohost, which test files can set (default 0x80001000, 0 =
+// DEBUG_OUT only, e.g. C programs with data at that address).
+// +tohost=<hex> overrides both, +tohost_list=<file> selects another
+// list. The stores are taken from the DMEM bus of the core (CORE_TOP,
+// in front of the data cache). Without CORE_TOP or when no result
+// arrives, the test runs until the watchdog expires and debug_out is
+// checked as before.
+// +timeout=<cycles> replaces the watchdog of every test.
+reg        tb_end = 1'b0;           // result stored to the mailbox
+reg [31:0] tb_end_value;
+reg [31:0] tb_cycles;               // cycles of the last test
+reg [31:0] tb_tohost = 32'h80001000;
+reg [31:0] tb_tohost_cur = 32'h80001000; // tohost of the running test
+reg [31:0] tb_tohost_arg;
+reg        tb_tohost_fixed = 1'b0;  // +tohost given
+reg [255*8:1] tb_tohost_list;
+reg [31:0] tb_timeout = 0;
+reg        tb_mbox_wr = 1'b0;       // data phase of a mailbox store
+reg        tb_mbox_dbg;             // .. to DEBUG_OUT
+
+initial begin
+  if (!$value$plusargs("timeout=%d", tb_timeout))
+    tb_timeout = 0;
+  if ($value$plusargs("tohost=%h", tb_tohost_arg))
+    tb_tohost_fixed = 1'b1;
+  if (!$value$plusargs("tohost_list=%s", tb_tohost_list))
+    tb_tohost_list = "./memfiles/tohost.lst";
+end
+
+// Sets tb_tohost_cur for the image filename (see above).
+task select_tohost;
+input reg[255*8:1] filename;
+integer           fd;
+integer           n;
+reg [255*8:1]     line;
+reg [255*8:1]     name;
+reg [31:0]        addr;
+reg               found;
+begin
+  found = 1'b0;
+  if (tb_tohost_fixed) begin
+    tb_tohost_cur = tb_tohost_arg;
+    found = 1'b1;
+  end else begin
+    fd = $fopen(tb_tohost_list, "r");
+    if (fd != 0) begin
+      while (!found && ($fgets(line, fd) != 0)) begin
+        n = $sscanf(line, "%s %h", name, addr);
+        if ((n == 2) && (name == filename)) begin
+          tb_tohost_cur = addr;
+          found = 1'b1;
+        end
+      end
+      $fclose(fd);
+    end
+  end
+  if (!found)
+    tb_tohost_cur = tb_tohost;
+end
+endtask
+
+`ifdef CORE_TOP
+always @(posedge CLK) begin
+  if (`CORE_TOP.dmem_hready_core) begin
+    if (tb_mbox_wr) begin
+      if (tb_mbox_dbg ? (`CORE_TOP.dmem_hwdata_core <= 1) : (`CORE_TOP.dmem_hwdata_core != 0)) begin
+        tb_end       <= 1'b1;
+        tb_end_value <= `CORE_TOP.dmem_hwdata_core;
+      end
+    end
+    tb_mbox_wr  <= `CORE_TOP.dmem_htrans_ext[1] && `CORE_TOP.dmem_hwrite_core &&
+                   ((`CORE_TOP.dmem_haddr_core == 32'h80010000) ||
+                    ((tb_tohost_cur != 0) && (`CORE_TOP.dmem_haddr_core == tb_tohost_cur)));
+    tb_mbox_dbg <= (`CORE_TOP.dmem_haddr_core == 32'h80010000);
+  end
+end
+`endif
+
+// Runs the program (reset just released) until it stores its result
+// or max_cycles have passed, result = 0 on pass.
+task wait_test_end;
+input reg[31:0]   max_cycles;
+output reg[31:0]  result;
+begin
+  if (tb_timeout != 0)
+    max_cycles = tb_timeout;
+  tb_end    = 1'b0;
+  tb_cycles = 0;
+`ifdef CORE_TOP
+  while (!tb_end && (tb_cycles < max_cycles)) begin
+    @(negedge CLK);
+    tb_cycles = tb_cycles + 1;
+  end
+`else
+  #(max_cycles*`CORE_CLK_PERIOD);
+  tb_cycles = max_cycles;
+`endif
+  if (tb_end ? (tb_end_value == 1) : (debug_out == 1)) begin
+    result = 0;
+    $write("success, %0d cycles.\n", tb_cycles);
+  end
+  else begin
+    if (tb_end)
+      $write("error (%0d), %0d cycles.\n", tb_end_value, tb_cycles);
+    else
+      $write("error (no result after %0d cycles).\n", tb_cycles);
+    result = 1;
+  end
+end
+endtask
+
+
 task run_test_program;
 input reg[7:0]    testnum;
 input reg[255*8:1]    filename;
@@ -31,24 +195,15 @@ begin
   $write("read mem file for testcase ", testnum);$fflush();
   // read program into buffer
   $readmemh(filename,memimg);
+  select_tohost(filename);
 
-  // write to QSPI-Flash via JTAG
-  for (i = 0; i < length; i = i + 1) begin        
-    jtag_write_mem(32'h80000000 + i*4,memimg[i],result);
-  end
+  // write to memory (backdoor or JTAG, see load_program)
+  load_program(length, 1'b0, result);
 
   $write(" o.k., running..");$fflush();
   #(10*`CORE_CLK_PERIOD) RESET <= 1'b1;
   #(3*`CORE_CLK_PERIOD) RESET <= 1'b0;
-  #(50000*`CORE_CLK_PERIOD);
-  if(debug_out == 1)begin    
-     result = 0;
-     $write("success.\n");
-  end
-  else begin
-    $write("error.\n");
-    result = 1;
-  end
+  wait_test_end(50000, result);
 end
 endtask
 
@@ -66,23 +221,12 @@ begin
   $write("read mem file for testcase ", testnum);$fflush();
   // read program into buffer
   $readmemh(filename,memimg);
+  select_tohost(filename);
 
 
 
- // write to QSPI-Flash via JTAG
-  #(300*`CORE_CLK_PERIOD);
-
-
-
- jtag_write_mem(32'h80000000,memimg[0],result);
-  jtag_write_mem_bulk_init;    
-
-
-
- for (i = 1; i < length; i = i + 1) begin        
-    jtag_write_mem_bulk(32'h80000000 + i*4,memimg[i],result);
-  end
-  jtag_write_mem_bulk_end;
+ // write to memory (backdoor or JTAG, see load_program)
+  load_program(length, 1'b1, result);
 
 
 
@@ -90,15 +234,7 @@ begin
   #(10*`CORE_CLK_PERIOD) RESET <= 1'b1;
   #(3*`CORE_CLK_PERIOD) RESET <= #2 1'b0;
 //  #(50000*`CORE_CLK_PERIOD);
-  #(40000000*`CORE_CLK_PERIOD);
-  if(debug_out == 1)begin    
-     result = 0;
-     $write("success.\n");
-  end
-  else begin
-    $write("error.\n");
-    result = 1;
-  end
+  wait_test_end(40000000, result);
 end
 endtask
 task run_test_program_bulk;
@@ -115,31 +251,16 @@ begin
   $write("read mem file for testcase ", testnum);$fflush();
   // read program into buffer
   $readmemh(filename,memimg);
+  select_tohost(filename);
 
-  // write to QSPI-Flash via JTAG
-  #(300*`CORE_CLK_PERIOD);
-
-  jtag_write_mem(32'h80000000,memimg[0],result);
-  jtag_write_mem_bulk_init;    
-
-  for (i = 1; i < length; i = i + 1) begin        
-    jtag_write_mem_bulk(32'h80000000 + i*4,memimg[i],result);
-  end
-  jtag_write_mem_bulk_end;
+  // write to memory (backdoor or JTAG, see load_program)
+  load_program(length, 1'b1, result);
 
   $write(" o.k., running..");$fflush();
   #(10*`CORE_CLK_PERIOD) RESET <= 1'b1;// MEM_RESET <= 1'b1; No MEM_RESET here to avoid imem loss 
   #(3*`CORE_CLK_PERIOD) RESET <= #2 1'b0;// MEM_RESET <= #2 1'b0;
 //  #(70000*`CORE_CLK_PERIOD);
-  #(40000*`CORE_CLK_PERIOD);
-  if(debug_out == 1)begin    
-     result = 0;
-     $write("success.\n");
-  end
-  else begin
-    $write("error.\n");
-    result = 1;
-  end
+  wait_test_end(40000, result);
 end
 endtask
 
@@ -158,31 +279,16 @@ begin
   $write("read mem file for testcase ", testnum);$fflush();
   // read program into buffer
   $readmemh(filename,memimg);
+  select_tohost(filename);
 
-  // write to QSPI-Flash via JTAG
-  #(300*`CORE_CLK_PERIOD);
-
-  jtag_write_mem(32'h80000000,memimg[0],result);
-  jtag_write_mem_bulk_init;    
-
-  for (i = 1; i < length; i = i + 1) begin        
-    jtag_write_mem_bulk(32'h80000000 + i*4,memimg[i],result);
-  end
-  jtag_write_mem_bulk_end;
+  // write to memory (backdoor or JTAG, see load_program)
+  load_program(length, 1'b1, result);
 
   $write(" o.k., running..");$fflush();
   #(10*`CORE_CLK_PERIOD) RESET <= 1'b1;// MEM_RESET <= 1'b1; No MEM_RESET here to avoid imem loss 
   #(3*`CORE_CLK_PERIOD) RESET <= #2 1'b0;// MEM_RESET <= #2 1'b0;
 //  #(70000*`CORE_CLK_PERIOD);
-  #(2000000*`CORE_CLK_PERIOD);
-  if(debug_out == 1)begin    
-     result = 0;
-     $write("success.\n");
-  end
-  else begin
-    $write("error.\n");
-    result = 1;
-  end
+  wait_test_end(2000000, result);
 end
 endtask
 
@@ -202,14 +308,8 @@ begin
   // read program into buffer
   $readmemh(filename,memimg);
 
-  // write to QSPI-Flash via JTAG
-  jtag_write_mem(32'h80000000,memimg[0],result);
-  jtag_write_mem_bulk_init;    
-
-  for (i = 1; i < length; i = i + 1) begin        
-    jtag_write_mem_bulk(32'h80000000 + i*4,memimg[i],result);
-  end
-  jtag_write_mem_bulk_end;
+  // write to memory (backdoor or JTAG, see load_program)
+  load_program(length, 1'b1, result);
   #(10*`CORE_CLK_PERIOD) RESET <= 1'b1;
   #(3*`CORE_CLK_PERIOD) RESET <= #2 1'b0;
 
@@ -252,10 +352,8 @@ begin
   // read program into buffer
   $readmemh(filename,memimg);
 
-  // write to QSPI-Flash via JTAG
-  for (i = 0; i < length; i = i + 1) begin
-    jtag_write_mem(32'h80000000 + i*4,memimg[i],result);
-  end
+  // write to memory (backdoor or JTAG, see load_program)
+  load_program(length, 1'b0, result);
 
   $write(" o.k., running..");
 
@@ -294,10 +392,8 @@ begin
   // read program into buffer
   $readmemh(filename,memimg);
 
-  // write to QSPI-Flash via JTAG
-  for (i = 0; i < length; i = i + 1) begin
-    jtag_write_mem(32'h80000000 + i*4,memimg[i],result);
-  end
+  // write to memory (backdoor or JTAG, see load_program)
+  load_program(length, 1'b0, result);
 
   $write(" o.k., running..");$fflush();
   $monitor("tohost: %h",DUT.debug_out);
@@ -358,14 +454,8 @@ begin
   // read program into buffer
   $readmemh(filename,memimg);
 
-  // write to QSPI-Flash via JTAG
-  jtag_write_mem(32'h80000000,memimg[0],result);
-  jtag_write_mem_bulk_init;    
-
-  for (i = 1; i < length; i = i + 1) begin        
-    jtag_write_mem_bulk(32'h80000000 + i*4,memimg[i],result);
-  end
-  jtag_write_mem_bulk_end;
+  // write to memory (backdoor or JTAG, see load_program)
+  load_program(length, 1'b1, result);
   #(10*`CORE_CLK_PERIOD) RESET <= 1'b1;
   #(3*`CORE_CLK_PERIOD) RESET <= #2 1'b0;
 
@@ -400,3 +490,166 @@ end
 endtask
 
 
+
+
+// Benchmark programs mark their measurement phases by writing
+// a phase number (2..253) to DEBUG_OUT; 254 marks code that is
+// not measured (setup). The program ends by writing 1 (pass)
+// or 0 (fail). Cycles spent in each phase are accumulated and
+// reported as total and per work unit (e.g. per byte).
+reg [31:0] bench_cycles [0:255];
+
+// Core statistics of the whole run, only available in configurations
+// that define CORE_PIPELINE (see airi5c_top_tb.v): retired instructions,
+// fetch stalls (DE ready but no instruction from IF, not counted
+// while the pipeline is flushed), resolved branches/jumps and
+// mispredictions, instruction cache
+// hits/misses (CORE_TOP, only counted with ICACHE_WAYS != 0), data
+// cache hits/misses/write-backs (only counted with DCACHE_WAYS != 0).
+reg        bench_stat_en = 1'b0;
+reg [31:0] bench_instret;
+reg [31:0] bench_if_stalls;
+reg [31:0] bench_branches;
+reg [31:0] bench_mispredicts;
+reg [31:0] bench_ic_hits;
+reg [31:0] bench_ic_misses;
+reg [31:0] bench_dc_hits;
+reg [31:0] bench_dc_misses;
+reg [31:0] bench_dc_wbs;
+reg [63:0] bench_tmp;
+
+`ifdef CORE_PIPELINE
+always @(negedge CLK) begin
+  if (bench_stat_en) begin
+    if (`CORE_PIPELINE.retire_WB)     bench_instret     = bench_instret + 1;
+    if (`CORE_PIPELINE.retire2_WB)    bench_instret     = bench_instret + 1; // DUAL_ISSUE
+    if (`CORE_PIPELINE.de_ready && !`CORE_PIPELINE.if_valid && !`CORE_PIPELINE.flush_pipeline)
+                                      bench_if_stalls   = bench_if_stalls + 1;
+    if (`CORE_PIPELINE.bp_update)     bench_branches    = bench_branches + 1;
+    if (`CORE_PIPELINE.bp_mispredict) bench_mispredicts = bench_mispredicts + 1;
+    if (`CORE_TOP.icache_hit)         bench_ic_hits     = bench_ic_hits + 1;
+    if (`CORE_TOP.icache_miss)        bench_ic_misses   = bench_ic_misses + 1;
+    if (`CORE_TOP.dcache_hit)         bench_dc_hits     = bench_dc_hits + 1;
+    if (`CORE_TOP.dcache_miss)        bench_dc_misses   = bench_dc_misses + 1;
+    if (`CORE_TOP.dcache_wb)          bench_dc_wbs      = bench_dc_wbs + 1;
+  end
+end
+`endif
+
+task run_bench_program;
+input reg[7:0]    testnum;
+input reg[255*8:1]    filename;
+input reg[15:0]    length;
+input reg[31:0]   units;        // work units per phase
+output reg[31:0] result;
+integer j;
+integer timeout;
+reg [7:0] phase;
+begin
+  #(10*`CORE_CLK_PERIOD) RESET <= 1'b1;
+  #(3*`CORE_CLK_PERIOD) RESET <= 1'b0;
+  testcase = testnum;    // marker variable so we can trace the results in simvision more easily.
+  $write("read mem file for testcase ", testnum);$fflush();
+  // read program into buffer
+  $readmemh(filename,memimg);
+  select_tohost(filename);
+
+  // write to memory (backdoor or JTAG, see load_program)
+  load_program(length, 1'b1, result);
+
+  for (j = 0; j < 256; j = j + 1)
+    bench_cycles[j] = 0;
+  bench_instret     = 0;
+  bench_if_stalls   = 0;
+  bench_branches    = 0;
+  bench_mispredicts = 0;
+  bench_ic_hits     = 0;
+  bench_ic_misses   = 0;
+  bench_dc_hits     = 0;
+  bench_dc_misses   = 0;
+  bench_dc_wbs      = 0;
+
+  $write(" o.k., running..");$fflush();
+  #(10*`CORE_CLK_PERIOD) RESET <= 1'b1;
+  #(3*`CORE_CLK_PERIOD) RESET <= #2 1'b0;
+
+  // ends with the mailbox store (see wait_test_end), or with
+  // debug_out = 1/0 in configurations without CORE_TOP
+  tb_end  = 1'b0;
+  timeout = 0;
+  phase   = debug_out;
+  bench_stat_en = 1'b1;
+`ifdef CORE_TOP
+  while (!tb_end && (timeout < ((tb_timeout != 0) ? tb_timeout : 40000000))) begin
+`else
+  while ((phase != 1) && (phase != 0) && (timeout < ((tb_timeout != 0) ? tb_timeout : 40000000))) begin
+`endif
+    @(posedge CLK);
+    bench_cycles[phase] = bench_cycles[phase] + 1;
+    timeout = timeout + 1;
+    phase   = debug_out;
+  end
+  bench_stat_en = 1'b0;
+  tb_cycles     = timeout;
+
+  if(tb_end ? (tb_end_value == 1) : (debug_out == 1))begin
+     result = 0;
+     $write("success.\n");
+  end
+  else begin
+    $write("error.\n");
+    result = 1;
+  end
+
+  for (j = 2; j < 254; j = j + 1) begin
+    if (bench_cycles[j] != 0)
+      $write("  phase %0d: %0d cycles, %0d.%02d cycles/unit\n", j, bench_cycles[j],
+        bench_cycles[j] / units, ((bench_cycles[j] * 100) / units) % 100);
+  end
+
+`ifdef CORE_PIPELINE
+  if (bench_instret != 0) begin
+    bench_tmp = timeout;
+    bench_tmp = (bench_tmp * 100) / bench_instret;
+    $write("  total: %0d cycles, %0d instructions, CPI %0d.%02d", timeout, bench_instret,
+      bench_tmp / 100, bench_tmp % 100);
+    bench_tmp = bench_instret;
+    bench_tmp = (bench_tmp * 100) / timeout;
+    $write(", IPC %0d.%02d\n", bench_tmp / 100, bench_tmp % 100);
+    $write("  fetch stalls: %0d cycles\n", bench_if_stalls);
+    bench_tmp = bench_mispredicts;
+    bench_tmp = (bench_branches != 0) ? (bench_tmp * 10000) / bench_branches : 0;
+    $write("  branches/jumps: %0d, mispredicted: %0d (%0d.%02d%%)\n", bench_branches, bench_mispredicts,
+      bench_tmp / 100, bench_tmp % 100);
+  end
+  if ((bench_ic_hits + bench_ic_misses) != 0) begin
+    bench_tmp = bench_ic_misses;
+    bench_tmp = (bench_tmp * 10000) / (bench_ic_hits + bench_ic_misses);
+    $write("  icache: %0d hits, %0d misses (%0d.%02d%% miss rate)\n", bench_ic_hits, bench_ic_misses,
+      bench_tmp / 100, bench_tmp % 100);
+  end
+  if ((bench_dc_hits + bench_dc_misses) != 0) begin
+    bench_tmp = bench_dc_misses;
+    bench_tmp = (bench_tmp * 10000) / (bench_dc_hits + bench_dc_misses);
+    $write("  dcache: %0d hits, %0d misses (%0d.%02d%% miss rate), %0d write-backs\n", bench_dc_hits,
+      bench_dc_misses, bench_tmp / 100, bench_tmp % 100, bench_dc_wbs);
+  end
+`endif
+end
+endtask
+
+// Floating-point operations per cycle of each phase of the last
+// run_bench_program, flops = FLOPs per phase.
+task print_bench_flops;
+input reg[31:0]   flops;
+integer j;
+begin
+  for (j = 2; j < 254; j = j + 1) begin
+    if (bench_cycles[j] != 0) begin
+      bench_tmp = flops;
+      bench_tmp = (bench_tmp * 100) / bench_cycles[j];
+      $write("  phase %0d: %0d.%02d FLOPs/cycle\n", j, bench_tmp / 100, bench_tmp % 100);
+    end
+  end
+end
+endtask
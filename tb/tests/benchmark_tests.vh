@@ -14,7 +14,7 @@
 // File              : benchmark_tests.vh
 // Author            : A. Stanitzki
 // Creation Date     : 09.10.20
-// Last Modified     : 08.12.22
+// Last Modified     : 17.10.26
 // Version           : 1.0         
 //
 
@@ -26,9 +26,192 @@ errorcount <= 0;
 $write("Coremark:\n");
 
 $write("Coremark takes ~30min. real time to finish\n");
-$write("Beware to disable all probes during simulation!\n\n");
+$write("Beware to disable all probes during simulation!\n");
+$write("CPI and branch mispredictions depend on BRANCH_PREDICTION (airi5c_arch_options.vh)\n");
+$write("Instruction cache: ICACHE_WAYS, with CONFIG_IDEAL_SRAM_CCRAM all fetches see 2 wait states\n");
+$write("Data cache: DCACHE_WAYS, with CONFIG_IDEAL_SRAM_CCRAM all non-CCRAM data accesses see 2 wait states\n");
+$write("IPC: DUAL_ISSUE (requires IFETCH_WIDTH = 64)\n\n");
 
 testtotal = testtotal + 1;
-run_test_program(1,"./memfiles/torture/coremark.mem",7000,result);
+run_bench_program(1,"./memfiles/torture/coremark.mem",7000,1,result);
+if(result != 0) errorcount = errorcount + 1;
 
 $write("\n\n");
+
+// The tb/sw benchmark images are not part of the repository and no
+// reference results have been recorded yet. Build them first
+// ("make tb_mem" in tb/sw, see tb/sw/bench.mk) and run the simulation
+// with +bench_sw, or run .ci/regression.py --suites benchmark.
+if ($test$plusargs("bench_sw")) begin
+  // the tb/sw programs report through DEBUG_OUT only, their data
+  // may be placed at the tohost address (see wait_test_end)
+  tb_tohost = 32'h00000000;
+
+  // ========================
+  // == UART FIFO access    =
+  // ========================
+  // phase 2/4: tx per-byte/burst, phase 6/8: rx per-byte/burst
+  // (tb/sw/uart_bench, 512 bytes per phase, uart0 looped back)
+  $write("UART cycles per byte:\n");
+
+  testtotal = testtotal + 1;
+  run_bench_program(2,"./memfiles/bench/uart_bench.mem",4096,512,result);
+  if(result != 0) errorcount = errorcount + 1;
+
+  $write("\n\n");
+
+  // ========================
+  // == DMA                 =
+  // ========================
+  // phase 2: core copy loop, phase 4: DMA mem->mem copy,
+  // phase 6: mem->uart0->mem via two handshaked DMA channels
+  // (tb/sw/dma_bench, 1024 bytes per phase, uart0 looped back)
+  $write("DMA cycles per byte:\n");
+
+  testtotal = testtotal + 1;
+  run_bench_program(3,"./memfiles/bench/dma_bench.mem",4096,1024,result);
+  if(result != 0) errorcount = errorcount + 1;
+
+  $write("\n\n");
+
+  // ========================
+  // == Memory routines     =
+  // ========================
+  // even phases: newlib, odd phases: BSP airisc_mem*
+  // 2/3 memcpy aligned, 4/5 memcpy misaligned, 6/7 memset, 8/9 memmove
+  // (tb/sw/string_bench, 4096 bytes per phase)
+  $write("memcpy/memset/memmove cycles per byte:\n");
+
+  testtotal = testtotal + 1;
+  run_bench_program(4,"./memfiles/bench/string_bench.mem",4096,4096,result);
+  if(result != 0) errorcount = errorcount + 1;
+
+  $write("\n\n");
+
+  // ========================
+  // == CCRAM placement     =
+  // ========================
+  // phase 2: kernel code and data in RAM, phase 3: code in CCRAM,
+  // phase 4: code and data in CCRAM (tb/sw/ccram_bench, 1024 elements
+  // per phase). Phases only differ with CONFIG_IDEAL_SRAM_CCRAM.
+  $write("CCRAM kernel cycles per element:\n");
+
+  testtotal = testtotal + 1;
+  run_bench_program(5,"./memfiles/bench/ccram_bench.mem",4096,1024,result);
+  if(result != 0) errorcount = errorcount + 1;
+
+  $write("\n\n");
+
+  // ========================
+  // == Interrupt latency   =
+  // ========================
+  // machine timer interrupt, phase 2/3: direct mode entry/exit,
+  // phase 4/5: vectored mode entry/exit (tb/sw/irq_bench, 16 interrupts
+  // per phase)
+  $write("Interrupt latency cycles per interrupt:\n");
+
+  testtotal = testtotal + 1;
+  run_bench_program(6,"./memfiles/bench/irq_bench.mem",4096,16,result);
+  if(result != 0) errorcount = errorcount + 1;
+
+  $write("\n\n");
+
+  // ========================
+  // == Formatted printing  =
+  // ========================
+  // phase 2: newlib sprintf, phase 3: ee_sprintf, phase 4: ee_printf
+  // incl. bulk uart0 write (tb/sw/printf_bench, 16 lines per phase;
+  // newlib's sprintf needs the full 64kB RAM image)
+  $write("Formatted printing cycles per line:\n");
+
+  testtotal = testtotal + 1;
+  run_bench_program(7,"./memfiles/bench/printf_bench.mem",16384,16,result);
+  if(result != 0) errorcount = errorcount + 1;
+
+  $write("\n\n");
+
+  // ========================
+  // == TRNG read-out       =
+  // ========================
+  // full random pool drained with phase 2: trng_get, phase 3: trng_fill
+  // (byte mode), phase 4: trng_fill (word mode) (tb/sw/trng_bench,
+  // 128 bytes per phase)
+  $write("TRNG read-out cycles per byte:\n");
+
+  testtotal = testtotal + 1;
+  run_bench_program(8,"./memfiles/bench/trng_bench.mem",4096,128,result);
+  if(result != 0) errorcount = errorcount + 1;
+
+  $write("\n\n");
+
+  // ========================
+  // == Function calls      =
+  // ========================
+  // call/return pairs, phase 2: leaf calls, phase 3: call chain of
+  // depth 4, phase 4: recursion of depth 16 (tb/sw/call_bench, 256
+  // pairs per phase). Compare BRANCH_PREDICTION and BP_RAS_DEPTH.
+  $write("Function call cycles per call/return pair:\n");
+
+  testtotal = testtotal + 1;
+  run_bench_program(9,"./memfiles/bench/call_bench.mem",4096,256,result);
+  if(result != 0) errorcount = errorcount + 1;
+
+  $write("\n\n");
+
+  // ========================
+  // == MUL/DIV             =
+  // ========================
+  // phase 2: Q31 multiply (mul + mulh), phase 3/4: div/rem with 16-bit
+  // operands, phase 5: div with Q15 scaled dividends, phase 6: Q15 dot
+  // product with independent MACs (tb/sw/muldiv_bench, 256 operations per
+  // phase). Compare with and without ARCH_M_FAST, ARCH_M_PIPELINED and
+  // ARCH_M_SCOREBOARD.
+  $write("MUL/DIV cycles per operation:\n");
+
+  testtotal = testtotal + 1;
+  run_bench_program(10,"./memfiles/bench/muldiv_bench.mem",4096,256,result);
+  if(result != 0) errorcount = errorcount + 1;
+
+  $write("\n\n");
+
+  // ========================
+  // == HPM counters        =
+  // ========================
+  // mhpmcounter3 (load-use stalls) stopped/running over a pointer chase,
+  // phase 2: inhibited, phase 3: counting, phase 4: mhpmcounter4 counts
+  // timer interrupts (tb/sw/hpm_bench, 64 loads/interrupts per phase).
+  // Needs HPM_COUNTERS >= 2.
+  $write("HPM counter check cycles per load/interrupt:\n");
+
+  if (`HPM_COUNTERS >= 2) begin
+    testtotal = testtotal + 1;
+    run_bench_program(11,"./memfiles/bench/hpm_bench.mem",4096,64,result);
+    if(result != 0) errorcount = errorcount + 1;
+  end else
+    $write("skipped, HPM_COUNTERS < 2\n");
+
+  $write("\n\n");
+
+  // ========================
+  // == Float dot product   =
+  // ========================
+  // phase 2: fmadd chain (one accumulator), phase 3: four accumulators
+  // (fmadd), phase 4: four accumulators (fmul + fadd), phase 5: axpy
+  // (tb/sw/fdot_bench, 512 FLOPs per phase). Needs ISA_EXT_F, compare
+  // with and without FPU_PIPELINED.
+  $write("Float dot product cycles per FLOP:\n");
+
+`ifdef ISA_EXT_F
+  testtotal = testtotal + 1;
+  run_bench_program(12,"./memfiles/bench/fdot_bench.mem",4096,512,result);
+  if(result != 0) errorcount = errorcount + 1;
+  print_bench_flops(512);
+`else
+  $write("skipped, ISA_EXT_F not defined\n");
+`endif
+
+  $write("\n\n");
+
+  tb_tohost = 32'h80001000;
+end else
+  $write("tb/sw benchmarks skipped, build the images and run with +bench_sw (see tb/sw/bench.mk)\n\n");
@@ -32,6 +32,16 @@ testtotal = testtotal + 1;
 run_test_program_bulk(0,"./memfiles/rv32uc/rv32uc-p-rvc.mem",3030,result);
 if(result != 0) errorcount = errorcount + 1;
 
+// =========================
+// == 1 - C-ISA fetch stats =
+// =========================
+// same program, runs until it reports the result and prints the fetch
+// statistics (compare IFETCH_WIDTH = 32/64 and IPB_DEPTH, airi5c_arch_options.vh)
+$write("RVC  : ");
+testtotal = testtotal + 1;
+run_bench_program(1,"./memfiles/rv32uc/rv32uc-p-rvc.mem",3030,1,result);
+if(result != 0) errorcount = errorcount + 1;
+
 
 $write("\n\n RV32C Instruction Tests completed with errorcount = ",errorcount);
 $write("\n\n");